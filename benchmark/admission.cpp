@@ -0,0 +1,116 @@
+// Overload behaviour with and without a bounded run queue.
+//
+// A producer coroutine on its own LooperExecutor spawns tasks onto a
+// ThreadPoolExecutor faster than the pool can run them (each task spins
+// for a few microseconds). Without a limit the queue, and with it the
+// schedule-to-start latency, grows for as long as the overload lasts. With
+// Reject the surplus is refused up front through Runtime::try_spawn; with
+// Block the producer waits in co_await admit() and the queue stays at
+// capacity.
+//
+// Usage: admission [tasks] [threads] [capacity] [work_us]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "koroutine/debug.h"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Counters {
+  std::atomic<long> submitted{0};
+  std::atomic<long> refused{0};
+  std::atomic<long> finished{0};
+};
+
+Task<void> work(std::chrono::microseconds cost, Counters& counters) {
+  auto until = Clock::now() + cost;
+  while (Clock::now() < until) {
+  }
+  counters.finished.fetch_add(1, std::memory_order_relaxed);
+  co_return;
+}
+
+Task<void> producer(AbstractScheduler* target, int tasks, bool block,
+                    std::chrono::microseconds cost, Counters& counters) {
+  for (int i = 0; i < tasks; ++i) {
+    if (block) co_await target->admit();
+    auto task = work(cost, counters);
+    task.handle_.promise().set_scheduler(target);
+    if (Runtime::try_spawn(std::move(task))) {
+      counters.submitted.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      counters.refused.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void run(const char* name, QueueLimit limit, int tasks, size_t threads,
+         std::chrono::microseconds cost) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(threads);
+  pool->set_queue_limit(limit);
+  auto target = std::make_shared<SimpleScheduler>(pool);
+  auto source =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+
+  Counters counters;
+  auto start = Clock::now();
+  auto driver = producer(target.get(), tasks,
+                         limit.policy == OverflowPolicy::Block, cost, counters);
+  driver.handle_.promise().set_scheduler(source.get());
+  driver.start();
+
+  size_t peak = 0;
+  while (!driver.is_done() ||
+         counters.finished.load() < counters.submitted.load()) {
+    peak = std::max(peak, pool->metrics().queued);
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  auto metrics = pool->metrics();
+  std::cout << std::left << std::setw(10) << name << std::right
+            << std::setw(10) << counters.submitted.load() << std::setw(10)
+            << counters.refused.load() << std::setw(12) << peak
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << metrics.schedule_latency.percentile(0.99).count() / 1000.0
+            << std::setw(10) << std::setprecision(3) << seconds << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int tasks = 200'000;
+  size_t threads = 4;
+  size_t capacity = 1024;
+  int work_us = 5;
+  if (argc > 1) tasks = std::atoi(argv[1]);
+  if (argc > 2) threads = static_cast<size_t>(std::atoi(argv[2]));
+  if (argc > 3) capacity = static_cast<size_t>(std::atoi(argv[3]));
+  if (argc > 4) work_us = std::atoi(argv[4]);
+  std::chrono::microseconds cost(work_us);
+
+  std::cout << std::left << std::setw(10) << "limit" << std::right
+            << std::setw(10) << "run" << std::setw(10) << "refused"
+            << std::setw(12) << "peak queue" << std::setw(12) << "p99 us"
+            << std::setw(10) << "seconds" << "\n";
+  run("none", {}, tasks, threads, cost);
+  run("reject", {capacity, OverflowPolicy::Reject}, tasks, threads, cost);
+  run("block", {capacity, OverflowPolicy::Block}, tasks, threads, cost);
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Spawn/join cost of AsyncScope against a TaskManager group.
+//
+// A driver coroutine on the default scheduler spawns a batch of trivial
+// children into the container and then awaits the batch draining, which is
+// the pattern of a server accepting connections into one group. Reports the
+// cost per child and the number of global operator new calls per child.
+// Coroutine frames come from the worker's frame pool, so with AsyncScope the
+// steady-state count should be zero.
+//
+// Usage: async_scope [rounds] [children_per_round]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+
+#include "koroutine/async_scope.hpp"
+#include "koroutine/koroutine.h"
+#include "koroutine/task_manager.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<long> allocations{0};
+
+Task<void> child(std::atomic<long>& sum) {
+  sum.fetch_add(1, std::memory_order_relaxed);
+  co_return;
+}
+
+struct Sample {
+  double ns_per_child;
+  double allocs_per_child;
+};
+
+// ~TaskManager blocks in sync_shutdown(), so the manager lives in main()
+Task<Sample> group_rounds(TaskManager& manager, int rounds, int children,
+                          std::atomic<long>& sum) {
+  long before = 0;
+  auto start = Clock::now();
+  // Round 0 warms up the frame pool and the group map
+  for (int r = 0; r <= rounds; ++r) {
+    if (r == 1) {
+      before = allocations.load();
+      start = Clock::now();
+    }
+    for (int i = 0; i < children; ++i) {
+      manager.submit_to_group("batch",
+                              std::make_shared<Task<void>>(child(sum)));
+    }
+    co_await manager.join_group("batch");
+  }
+  double ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                  .count();
+  double total = static_cast<double>(rounds) * children;
+  co_return Sample{ns / total, (allocations.load() - before) / total};
+}
+
+Task<Sample> scope_rounds(AsyncScope& scope, int rounds, int children,
+                          std::atomic<long>& sum) {
+  long before = 0;
+  auto start = Clock::now();
+  for (int r = 0; r <= rounds; ++r) {
+    if (r == 1) {
+      before = allocations.load();
+      start = Clock::now();
+    }
+    for (int i = 0; i < children; ++i) scope.spawn(child(sum));
+    co_await scope.join();
+  }
+  double ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                  .count();
+  double total = static_cast<double>(rounds) * children;
+  co_return Sample{ns / total, (allocations.load() - before) / total};
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int rounds = 2000;
+  int children = 256;
+  if (argc > 1) rounds = std::atoi(argv[1]);
+  if (argc > 2) children = std::atoi(argv[2]);
+
+  std::atomic<long> sum{0};
+
+  TaskManager manager;
+  AsyncScope scope;
+  auto group =
+      Runtime::block_on(group_rounds(manager, rounds, children, sum));
+  auto nursery = Runtime::block_on(scope_rounds(scope, rounds, children, sum));
+
+  std::cout << std::fixed << std::setprecision(1) << "children per round = "
+            << children << "\n"
+            << std::setw(14) << "container" << std::setw(14) << "ns/child"
+            << std::setw(16) << "allocs/child\n"
+            << std::setw(14) << "TaskManager" << std::setw(14)
+            << group.ns_per_child << std::setw(15) << std::setprecision(2)
+            << group.allocs_per_child << "\n"
+            << std::setprecision(1) << std::setw(14) << "AsyncScope"
+            << std::setw(14) << nursery.ns_per_child << std::setw(15)
+            << std::setprecision(2) << nursery.allocs_per_child << "\n";
+  return sum.load() > 0 ? 0 : 1;
+}
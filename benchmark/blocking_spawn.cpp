@@ -0,0 +1,77 @@
+// Cost of handing a blocking call off the worker threads.
+//
+// Compares one thread per call (NewThreadExecutor, what the resolver used)
+// with the elastic BlockingPool, both as a raw execute() round trip and as
+// `co_await spawn_blocking(fn)` from a coroutine. The blocking function is
+// empty, so the numbers are pure hand-off overhead.
+//
+// Usage: blocking_spawn [calls]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+
+#include "koroutine/executors/blocking_pool.h"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/new_thread_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double round_trip_us(AbstractExecutor& executor, int calls) {
+  auto start = Clock::now();
+  for (int i = 0; i < calls; ++i) {
+    std::latch done(1);
+    executor.execute([&done] { done.count_down(); });
+    done.wait();
+  }
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+             .count() /
+         calls;
+}
+
+Task<double> spawn_blocking_us(int calls) {
+  auto start = Clock::now();
+  for (int i = 0; i < calls; ++i) {
+    co_await spawn_blocking([i] { return i; });
+  }
+  co_return std::chrono::duration<double, std::micro>(Clock::now() - start)
+          .count() /
+      calls;
+}
+
+void report(const std::string& name, double us) {
+  std::cout << std::setw(34) << std::left << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2) << us
+            << " us/call\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int calls = 20'000;
+  if (argc > 1) calls = std::atoi(argv[1]);
+
+  SchedulerManager::set_default_scheduler(
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>()));
+
+  NewThreadExecutor new_thread;
+  report("NewThreadExecutor round trip", round_trip_us(new_thread, calls));
+  report("BlockingPool round trip",
+         round_trip_us(BlockingPool::instance(), calls));
+  report("co_await spawn_blocking", Runtime::block_on(spawn_blocking_us(calls)));
+
+  auto stats = BlockingPool::instance().stats();
+  std::cout << "BlockingPool threads spawned: " << stats.spawned << "\n";
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Cost of cancellation tokens that are never cancelled.
+//
+// "token" runs P driver coroutines on a ThreadPoolExecutor with P workers;
+// each one awaits N trivial children, all bound to one shared token, so
+// every child registers and deregisters itself on the same token from P
+// threads at once. "plain" is the same loop without a token. "group"
+// submits N tasks to one TaskManager group (which binds each of them to
+// the group's token) and joins it.
+//
+// Usage: cancellation [drivers] [tasks_per_driver]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+
+#include "koroutine/cancellation.hpp"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/task_manager.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+Task<int> leaf(int v) { co_return v; }
+
+Task<void> noop() { co_return; }
+
+Task<void> driver(int tasks, const CancellationToken* token,
+                  std::latch& done) {
+  long long sum = 0;
+  for (int i = 0; i < tasks; ++i) {
+    auto child = leaf(i);
+    if (token) child.with_cancellation(*token);
+    sum += co_await std::move(child);
+  }
+  if (sum < 0) std::abort();
+  done.count_down();
+}
+
+double run_drivers(int drivers, int tasks, const CancellationToken* token) {
+  std::latch done(drivers);
+  auto start = Clock::now();
+  for (int d = 0; d < drivers; ++d) Runtime::spawn(driver(tasks, token, done));
+  done.wait();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return seconds * 1e9 / (static_cast<double>(drivers) * tasks);
+}
+
+double run_group(int tasks) {
+  TaskManager manager;
+  auto start = Clock::now();
+  for (int i = 0; i < tasks; ++i) {
+    manager.submit_to_group("bench", std::make_shared<Task<void>>(noop()));
+  }
+  manager.sync_wait_group("bench");
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return seconds * 1e9 / tasks;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int drivers = 4;
+  int tasks = 200'000;
+  if (argc > 1) drivers = std::atoi(argv[1]);
+  if (argc > 2) tasks = std::atoi(argv[2]);
+
+  SchedulerManager::set_default_scheduler(std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(drivers)));
+
+  CancellationToken token;
+  std::cout << std::fixed << std::setprecision(1)
+            << "plain  ns/task: " << run_drivers(drivers, tasks, nullptr)
+            << "\n"
+            << "token  ns/task: " << run_drivers(drivers, tasks, &token)
+            << "\n"
+            << "group  ns/task: " << run_group(tasks) << "\n";
+  return 0;
+}
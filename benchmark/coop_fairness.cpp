@@ -0,0 +1,97 @@
+// Fairness under a coroutine that never suspends on its own.
+//
+// One LooperExecutor runs two coroutines: a "hog" that spins on a buffered
+// Channel (every write and read completes inline, so without a budget it
+// never gives the loop back) and a "probe" that sleeps 1ms at a time and
+// records how late it runs after its timer fired. Reports the probe's
+// lateness and the hog's throughput for several cooperative budgets.
+//
+// Usage: coop_fairness [run_ms]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "koroutine/channel.hpp"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+Task<long long> hog(Clock::time_point until) {
+  Channel<int> channel(64);
+  long long ops = 0;
+  while (Clock::now() < until) {
+    for (int i = 0; i < 32; ++i) {
+      co_await channel.write(i);
+      co_await channel.read();
+    }
+    ops += 64;
+  }
+  co_return ops;
+}
+
+Task<void> probe(Clock::time_point until, std::vector<double>& lateness) {
+  while (Clock::now() < until) {
+    auto deadline = Clock::now() + 1ms;
+    co_await sleep_until(deadline);
+    lateness.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - deadline)
+            .count());
+  }
+}
+
+void run(uint32_t budget, int run_ms) {
+  set_coop_budget(budget);
+  auto scheduler =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  SchedulerManager::set_default_scheduler(scheduler);
+
+  auto until = Clock::now() + std::chrono::milliseconds(run_ms);
+  std::vector<double> lateness;
+  auto p = probe(until, lateness);
+  p.start();
+  long long ops = Runtime::block_on(hog(until));
+  while (!p.is_done()) std::this_thread::sleep_for(1ms);
+
+  std::sort(lateness.begin(), lateness.end());
+  auto at = [&](double q) {
+    return lateness.empty()
+               ? 0.0
+               : lateness[static_cast<size_t>(q * (lateness.size() - 1))];
+  };
+  std::cout << std::setw(8) << budget << std::setw(10) << lateness.size()
+            << std::fixed << std::setprecision(1) << std::setw(12) << at(0.5)
+            << std::setw(12) << at(0.99) << std::setw(12) << at(1.0)
+            << std::setw(14) << std::setprecision(0)
+            << ops / (run_ms / 1000.0) << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int run_ms = 1000;
+  if (argc > 1) run_ms = std::atoi(argv[1]);
+
+  std::cout << "budget 0 = disabled; lateness in us\n";
+  std::cout << std::setw(8) << "budget" << std::setw(10) << "wakeups"
+            << std::setw(12) << "p50" << std::setw(12) << "p99"
+            << std::setw(12) << "max" << std::setw(14) << "hog ops/s"
+            << "\n";
+  for (uint32_t budget : {0u, 1024u, 128u, 32u}) run(budget, run_ms);
+  set_coop_budget(details::CoopBudget::kDefaultBudget);
+  return 0;
+}
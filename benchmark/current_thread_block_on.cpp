@@ -0,0 +1,80 @@
+// Runtime::block_on (pool threads, caller parked on a condition variable)
+// versus CurrentThreadRuntime::block_on (the caller runs the loop itself).
+//
+// Measures the round trip of blocking on a trivial task, which is what a CLI
+// tool or a test pays per call, and the cost of a coroutine that suspends
+// many times inside one block_on.
+//
+// Usage: current_thread_block_on [calls] [yields]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+Task<int> trivial() { co_return 1; }
+
+Task<int> yielder(int yields) {
+  for (int i = 0; i < yields; ++i) co_await yield();
+  co_return yields;
+}
+
+template <typename BlockOn>
+double per_call_us(int calls, BlockOn&& block_on) {
+  auto start = Clock::now();
+  for (int i = 0; i < calls; ++i) block_on(trivial());
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+             .count() /
+         calls;
+}
+
+template <typename BlockOn>
+double per_yield_ns(int yields, BlockOn&& block_on) {
+  auto start = Clock::now();
+  block_on(yielder(yields));
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         yields;
+}
+
+void report(const std::string& name, double value, const char* unit) {
+  std::cout << std::setw(40) << std::left << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2) << value
+            << " " << unit << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int calls = 50'000;
+  int yields = 1'000'000;
+  if (argc > 1) calls = std::atoi(argv[1]);
+  if (argc > 2) yields = std::atoi(argv[2]);
+
+  auto pooled = [](auto&& task) {
+    return Runtime::block_on(std::move(task));
+  };
+  report("Runtime::block_on round trip", per_call_us(calls, pooled),
+         "us/call");
+  report("Runtime::block_on yield", per_yield_ns(yields, pooled), "ns/yield");
+
+  CurrentThreadRuntime runtime;
+  auto local = [&runtime](auto&& task) {
+    return runtime.block_on(std::move(task));
+  };
+  report("CurrentThreadRuntime::block_on round trip",
+         per_call_us(calls, local), "us/call");
+  report("CurrentThreadRuntime::block_on yield", per_yield_ns(yields, local),
+         "ns/yield");
+  return 0;
+}
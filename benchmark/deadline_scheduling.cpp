@@ -0,0 +1,122 @@
+// Deadline miss rate under a burst: SimpleScheduler (FIFO) vs
+// DeadlineScheduler (earliest deadline first).
+//
+// A single-thread executor is held while a burst of tasks is started, each
+// needing ~work_us of CPU and carrying a deadline drawn uniformly from
+// [0, 2 * total work] after the burst is released, so the burst is feasible
+// only when run in deadline order. A task that starts after its deadline
+// does not run its body under either scheduler. Reports the share of tasks
+// that finished by their deadline and the share dropped as expired.
+//
+// Usage: deadline_scheduling [tasks] [work_us] [rounds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/DeadlineScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void spin_for(std::chrono::microseconds duration) {
+  auto until = Clock::now() + duration;
+  while (Clock::now() < until) {
+  }
+}
+
+struct Counts {
+  long met = 0;
+  long late = 0;
+};
+
+Task<void> job(std::chrono::microseconds work, Clock::time_point deadline,
+               Counts& counts) {
+  spin_for(work);
+  if (Clock::now() <= deadline) {
+    ++counts.met;
+  } else {
+    ++counts.late;
+  }
+  co_return;
+}
+
+struct Sample {
+  double met_pct;
+  double dropped_pct;
+};
+
+template <typename Scheduler>
+Sample run(int tasks, std::chrono::microseconds work, int rounds,
+           unsigned seed) {
+  auto executor = std::make_shared<LooperExecutor>();
+  auto scheduler = std::make_shared<Scheduler>(executor);
+  std::mt19937 rng(seed);
+  Counts counts;
+  long total = 0;
+  // Deadlines are relative to the moment the burst is released
+  auto span = work * tasks * 2;
+  std::uniform_int_distribution<long> slack(0, span.count());
+
+  for (int r = 0; r < rounds; ++r) {
+    std::latch gate(1);
+    executor->execute([&] { gate.wait(); });
+    auto release = Clock::now() + std::chrono::milliseconds(5);
+    std::vector<Task<void>> burst;
+    burst.reserve(tasks);
+    for (int i = 0; i < tasks; ++i) {
+      auto deadline = release + std::chrono::microseconds(slack(rng));
+      burst.push_back(job(work, deadline, counts));
+      burst.back().with_deadline(deadline);
+      burst.back().handle_.promise().set_scheduler(scheduler.get());
+      burst.back().start();
+    }
+    std::this_thread::sleep_until(release);
+    std::latch done(1);
+    executor->execute([&] { done.count_down(); });
+    gate.count_down();
+    done.wait();
+    total += tasks;
+  }
+  double dropped = static_cast<double>(total - counts.met - counts.late);
+  return Sample{100.0 * counts.met / total, 100.0 * dropped / total};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int tasks = 1000;
+  int work_us = 5;
+  int rounds = 20;
+  if (argc > 1) tasks = std::atoi(argv[1]);
+  if (argc > 2) work_us = std::atoi(argv[2]);
+  if (argc > 3) rounds = std::atoi(argv[3]);
+  auto work = std::chrono::microseconds(work_us);
+
+  auto fifo = run<SimpleScheduler>(tasks, work, rounds, 42);
+  auto edf = run<DeadlineScheduler>(tasks, work, rounds, 42);
+
+  std::cout << std::fixed << std::setprecision(1) << "tasks per burst = "
+            << tasks << ", work = " << work_us << " us\n"
+            << std::setw(18) << "scheduler" << std::setw(12) << "met %"
+            << std::setw(14) << "dropped %\n"
+            << std::setw(18) << "SimpleScheduler" << std::setw(12)
+            << fifo.met_pct << std::setw(13) << fifo.dropped_pct << "\n"
+            << std::setw(18) << "DeadlineScheduler" << std::setw(12)
+            << edf.met_pct << std::setw(13) << edf.dropped_pct << "\n";
+  return 0;
+}
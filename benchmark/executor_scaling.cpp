@@ -0,0 +1,89 @@
+// Executor scaling benchmark: ThreadPoolExecutor vs WorkStealingExecutor.
+//
+// Spawns many coroutines that bounce through the scheduler queue with
+// `co_await scheduler->dispatch_to()` and reports resumes per second for
+// 1..N worker threads.
+//
+// Usage: executor_scaling [max_threads] [coroutines] [hops]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+
+namespace {
+
+Task<void> hopper(std::shared_ptr<AbstractScheduler> scheduler, int hops,
+                  std::latch& done) {
+  for (int i = 0; i < hops; ++i) {
+    co_await scheduler->dispatch_to();
+  }
+  done.count_down();
+}
+
+double run_once(std::shared_ptr<AbstractExecutor> executor, int coroutines,
+                int hops) {
+  auto scheduler = std::make_shared<SimpleScheduler>(std::move(executor));
+  std::latch done(coroutines);
+  std::vector<Task<void>> tasks;
+  tasks.reserve(coroutines);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < coroutines; ++i) {
+    tasks.push_back(hopper(scheduler, hops, done));
+    tasks.back().handle_.promise().set_scheduler(scheduler.get());
+    tasks.back().start();
+  }
+  done.wait();
+  auto elapsed = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  return static_cast<double>(coroutines) * hops / elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  size_t max_threads = std::thread::hardware_concurrency();
+  int coroutines = 1000;
+  int hops = 1000;
+  if (argc > 1) max_threads = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) coroutines = std::atoi(argv[2]);
+  if (argc > 3) hops = std::atoi(argv[3]);
+  if (max_threads == 0) max_threads = 1;
+
+  std::cout << "coroutines=" << coroutines << " hops=" << hops << "\n";
+  std::cout << std::setw(8) << "threads" << std::setw(22) << "thread_pool (M/s)"
+            << std::setw(24) << "work_stealing (M/s)" << "\n";
+
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  for (size_t threads : thread_counts) {
+    double pool = run_once(std::make_shared<ThreadPoolExecutor>(threads),
+                           coroutines, hops);
+    double stealing = run_once(std::make_shared<WorkStealingExecutor>(threads),
+                               coroutines, hops);
+    std::cout << std::setw(8) << threads << std::setw(22) << std::fixed
+              << std::setprecision(2) << pool / 1e6 << std::setw(24)
+              << stealing / 1e6 << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Fan-out cost of when_all over a vector of tasks.
+//
+// A coroutine builds N trivial child tasks and awaits when_all on them;
+// the children are started as one batch through schedule_bulk. Reports
+// the wall time per fan-out and per child for several fan-out widths.
+//
+// Usage: fan_out [max_width] [threads]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+Task<int> child(int i) { co_return i; }
+
+Task<double> fan_out_us(int width, int rounds) {
+  auto start = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    std::vector<Task<int>> tasks;
+    tasks.reserve(width);
+    for (int i = 0; i < width; ++i) tasks.push_back(child(i));
+    auto results = co_await when_all(std::move(tasks));
+    if (results.size() != static_cast<size_t>(width)) std::abort();
+  }
+  co_return std::chrono::duration<double, std::micro>(Clock::now() - start)
+          .count() /
+      rounds;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int max_width = 10'000;
+  size_t threads = 4;
+  if (argc > 1) max_width = std::atoi(argv[1]);
+  if (argc > 2) threads = static_cast<size_t>(std::atoi(argv[2]));
+
+  SchedulerManager::set_default_scheduler(std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(threads)));
+
+  std::cout << std::setw(8) << "width" << std::setw(16) << "us/fan-out"
+            << std::setw(14) << "ns/child" << "\n";
+  for (int width = 10; width <= max_width; width *= 10) {
+    int rounds = std::max(1, 100'000 / width);
+    double us = Runtime::block_on(fan_out_us(width, rounds));
+    std::cout << std::setw(8) << width << std::setw(16) << std::fixed
+              << std::setprecision(1) << us << std::setw(14)
+              << us * 1000.0 / width << "\n";
+  }
+  return 0;
+}
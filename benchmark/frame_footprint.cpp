@@ -0,0 +1,84 @@
+// Memory footprint of suspended coroutines.
+//
+// Models N idle connections: each one is a handler task awaiting a child
+// "read" task that is parked on an AsyncMutex held by main, i.e. two live
+// Task frames per connection. Reports the promise sizes, the resident set
+// growth per connection and how many such connections fit in 1 GiB.
+//
+// Usage: frame_footprint [connections]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/sync/async_mutex.h"
+
+using namespace koroutine;
+
+namespace {
+
+long resident_bytes() {
+  long pages = 0, resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> pages >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+Task<int> read_request(AsyncMutex& gate) {
+  co_await gate.lock();
+  gate.unlock();
+  co_return 0;
+}
+
+Task<void> handle_connection(AsyncMutex& gate) {
+  int n = co_await read_request(gate);
+  if (n < 0) std::abort();
+}
+
+Task<void> barrier() { co_return; }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int connections = 200'000;
+  if (argc > 1) connections = std::atoi(argv[1]);
+
+  SchedulerManager::set_default_scheduler(
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>()));
+
+  AsyncMutex gate;
+  gate.try_lock();
+
+  std::vector<Task<void>> tasks;
+  tasks.reserve(connections);
+  long before = resident_bytes();
+  for (int i = 0; i < connections; ++i) {
+    tasks.push_back(handle_connection(gate));
+    tasks.back().start();
+  }
+  // 事件循环按 FIFO 执行：barrier 完成时所有连接都已停在 gate 上
+  Runtime::block_on(barrier());
+  long after = resident_bytes();
+
+  double per_connection = static_cast<double>(after - before) / connections;
+  std::cout << "sizeof(TaskPromise<void>) = " << sizeof(TaskPromise<void>)
+            << "\nsizeof(TaskPromise<int>)  = " << sizeof(TaskPromise<int>)
+            << "\nconnections               = " << connections
+            << "\nRSS per connection        = " << std::fixed
+            << std::setprecision(0) << per_connection << " bytes"
+            << "\nconnections per GiB       = "
+            << static_cast<long>((1L << 30) / per_connection) << "\n";
+  std::fflush(stdout);
+  // 连接挂起在 gate 上，直接退出而不逐个唤醒
+  std::_Exit(0);
+}
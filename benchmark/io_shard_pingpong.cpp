@@ -0,0 +1,107 @@
+// Loopback ping-pong latency: shared IO thread vs. thread-per-core shard.
+//
+// A client and an echo server exchange a small message over 127.0.0.1.
+// In the "default" mode the sockets use the global io_uring engine, which
+// runs on its own thread and hands every completion to the thread pool. In
+// the "shard" mode everything runs on one ShardedRuntime shard: the shard
+// thread submits the SQEs, reaps the CQEs and resumes the coroutines
+// itself, so a round trip never crosses a thread.
+//
+// Usage: io_shard_pingpong [round_trips]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "koroutine/async_io/async_io.hpp"
+#include "koroutine/async_io/sharded_runtime.h"
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using namespace koroutine::async_io;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Stats {
+  double p50_us = 0;
+  double p99_us = 0;
+  double per_sec = 0;
+};
+
+Task<Stats> ping_pong(int round_trips) {
+  auto server = co_await AsyncServerSocket::bind(0);
+  uint16_t port = server->local_endpoint().port();
+
+  auto serve = [](std::shared_ptr<AsyncServerSocket> server,
+                  int round_trips) -> Task<int> {
+    auto conn = co_await server->accept();
+    char buf[64];
+    for (int i = 0; i < round_trips; ++i) {
+      size_t n = co_await conn->read(buf, sizeof(buf));
+      co_await conn->write(buf, n);
+    }
+    co_return 0;
+  };
+
+  auto client = [](uint16_t port, int round_trips) -> Task<Stats> {
+    auto socket = co_await AsyncSocket::connect("127.0.0.1", port);
+    std::vector<double> samples;
+    samples.reserve(round_trips);
+    char buf[64];
+    auto start = Clock::now();
+    for (int i = 0; i < round_trips; ++i) {
+      auto sent = Clock::now();
+      co_await socket->write("ping", 4);
+      co_await socket->read(buf, sizeof(buf));
+      samples.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - sent)
+              .count());
+    }
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    std::sort(samples.begin(), samples.end());
+    Stats stats;
+    stats.p50_us = samples[samples.size() / 2];
+    stats.p99_us = samples[samples.size() * 99 / 100];
+    stats.per_sec = round_trips / seconds;
+    co_return stats;
+  };
+
+  auto [served, stats] =
+      co_await when_all(serve(server, round_trips), client(port, round_trips));
+  (void)served;
+  co_return stats;
+}
+
+void report(const std::string& name, const Stats& stats) {
+  std::cout << std::setw(10) << name << std::fixed << std::setprecision(1)
+            << std::setw(12) << stats.p50_us << std::setw(12) << stats.p99_us
+            << std::setw(14) << std::setprecision(0) << stats.per_sec << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int round_trips = 100'000;
+  if (argc > 1) round_trips = std::atoi(argv[1]);
+
+  std::cout << "round_trips=" << round_trips << "\n";
+  std::cout << std::setw(10) << "mode" << std::setw(12) << "p50 (us)"
+            << std::setw(12) << "p99 (us)" << std::setw(14) << "rtt/s"
+            << "\n";
+
+  report("default", Runtime::block_on(ping_pong(round_trips)));
+
+  ShardedRuntime runtime(1);
+  runtime.pin_shards();
+  report("shard", runtime.block_on(0, ping_pong(round_trips)));
+  return 0;
+}
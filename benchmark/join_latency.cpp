@@ -0,0 +1,75 @@
+// Latency from the last task of a TaskManager group finishing to
+// join_group() returning.
+//
+// Each round submits a batch of tasks that sleep for a moment; the last one
+// to finish records a timestamp and the joiner measures how long it took to
+// be woken. Also reports how many rounds per second a submit/join loop
+// sustains, which is what a server draining its connection group sees.
+//
+// Usage: join_latency [rounds] [tasks_per_round]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "koroutine/koroutine.h"
+#include "koroutine/task_manager.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<Clock::rep> last_finish{0};
+
+Task<void> worker() {
+  co_await sleep_for(std::chrono::microseconds(200));
+  last_finish.store(Clock::now().time_since_epoch().count());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int rounds = 200;
+  int tasks = 16;
+  if (argc > 1) rounds = std::atoi(argv[1]);
+  if (argc > 2) tasks = std::atoi(argv[2]);
+
+  TaskManager manager;
+  std::vector<double> latency;
+  latency.reserve(rounds);
+  auto start = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (int i = 0; i < tasks; ++i) {
+      manager.submit_to_group("batch", std::make_shared<Task<void>>(worker()));
+    }
+    manager.sync_wait_group("batch");
+    auto woke = Clock::now().time_since_epoch().count();
+    latency.push_back(
+        std::chrono::duration<double, std::micro>(
+            Clock::duration(woke - last_finish.load()))
+            .count());
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::sort(latency.begin(), latency.end());
+  auto at = [&](double q) {
+    return latency[static_cast<size_t>(q * (latency.size() - 1))];
+  };
+  std::cout << std::fixed << std::setprecision(1)
+            << "rounds            = " << rounds
+            << "\ntasks per round   = " << tasks
+            << "\njoin wake p50     = " << at(0.5) << " us"
+            << "\njoin wake p99     = " << at(0.99) << " us"
+            << "\njoin wake max     = " << at(1.0) << " us"
+            << "\nrounds per second = " << rounds / seconds << "\n";
+  return 0;
+}
@@ -0,0 +1,70 @@
+// LooperExecutor submission throughput.
+//
+// P producer threads each submit N small tasks to one LooperExecutor and
+// the loop thread runs them. Reports tasks per second for 1..max producers;
+// the loop drains in batches and producers only signal it when it parked.
+//
+// Usage: looper_submit [max_producers] [tasks_per_producer]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include "koroutine/debug.h"
+#include "koroutine/executors/looper_executor.h"
+
+using namespace koroutine;
+
+namespace {
+
+double run_once(int producers, int tasks) {
+  LooperExecutor executor;
+  std::latch done(1);
+  std::atomic<long long> remaining{static_cast<long long>(producers) * tasks};
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < tasks; ++i) {
+        executor.execute([&] {
+          if (remaining.fetch_sub(1, std::memory_order_relaxed) == 1) {
+            done.count_down();
+          }
+        });
+      }
+    });
+  }
+  done.wait();
+  auto elapsed = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  for (auto& t : threads) t.join();
+  return static_cast<double>(producers) * tasks / elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int max_producers =
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  int tasks = 1'000'000;
+  if (argc > 1) max_producers = std::atoi(argv[1]);
+  if (argc > 2) tasks = std::atoi(argv[2]);
+
+  std::cout << "tasks_per_producer=" << tasks << "\n";
+  std::cout << std::setw(10) << "producers" << std::setw(16) << "tasks/s"
+            << "\n";
+  for (int p = 1; p <= max_producers; p *= 2) {
+    std::cout << std::setw(10) << p << std::setw(16) << std::fixed
+              << std::setprecision(0) << run_once(p, tasks) << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+// ThreadPoolExecutor hand-off latency with and without idle spinning.
+//
+// The main thread submits one task at a time and busy-waits until a worker
+// has run it, with a short pause between submissions so the pool goes idle
+// in between, as it does under request/response traffic. With a spin budget
+// the idle worker is still spinning when the next task arrives; with budget
+// 0 it is parked and every hand-off pays a futex wake.
+//
+// Usage: pool_wakeup_latency [iterations] [gap_us] [threads]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "koroutine/debug.h"
+#include "koroutine/details/cpu_relax.hpp"
+#include "koroutine/executors/thread_pool_executor.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void busy_wait(std::chrono::microseconds duration) {
+  auto until = Clock::now() + duration;
+  while (Clock::now() < until) details::cpu_relax();
+}
+
+void run(uint32_t budget, int iterations, int gap_us, size_t threads) {
+  ThreadPoolExecutor pool(threads, budget);
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  std::atomic<bool> done{false};
+
+  for (int i = 0; i < iterations; ++i) {
+    done.store(false, std::memory_order_relaxed);
+    auto start = Clock::now();
+    pool.execute([&done] { done.store(true, std::memory_order_release); });
+    while (!done.load(std::memory_order_acquire)) details::cpu_relax();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - start)
+            .count());
+    busy_wait(std::chrono::microseconds(gap_us));
+  }
+
+  std::sort(samples.begin(), samples.end());
+  auto stats = pool.stats();
+  std::cout << std::setw(8) << budget << std::fixed << std::setprecision(2)
+            << std::setw(12) << samples[samples.size() / 2] << std::setw(12)
+            << samples[samples.size() * 99 / 100] << std::setw(12)
+            << stats.spin_hits << std::setw(10) << stats.parks << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int iterations = 20'000;
+  int gap_us = 20;
+  size_t threads = 2;
+  if (argc > 1) iterations = std::atoi(argv[1]);
+  if (argc > 2) gap_us = std::atoi(argv[2]);
+  if (argc > 3) threads = static_cast<size_t>(std::atoi(argv[3]));
+
+  std::cout << "iterations=" << iterations << " gap_us=" << gap_us
+            << " threads=" << threads << "\n";
+  std::cout << std::setw(8) << "budget" << std::setw(12) << "p50 (us)"
+            << std::setw(12) << "p99 (us)" << std::setw(12) << "spin_hits"
+            << std::setw(10) << "parks" << "\n";
+  run(0, iterations, gap_us, threads);
+  run(ThreadPoolExecutor::kDefaultSpinBudget, iterations, gap_us, threads);
+  run(ThreadPoolExecutor::kDefaultSpinBudget * 4, iterations, gap_us, threads);
+  return 0;
+}
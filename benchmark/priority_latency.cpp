@@ -0,0 +1,126 @@
+// Mixed-load latency benchmark: SimpleScheduler vs PriorityScheduler.
+//
+// A set of CPU-heavy batch coroutines keeps the executor saturated, each
+// burning ~work_us per step and re-queueing itself at Low priority. Probe
+// coroutines meanwhile model I/O completions: they re-queue at High priority
+// and record how long they waited to be resumed. Reports p50/p99/max of the
+// probe wait times.
+//
+// Usage: priority_latency [threads] [batch_coroutines] [work_us] [samples]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+using Priority = ScheduleMetadata::Priority;
+
+namespace {
+
+void spin_for(std::chrono::microseconds duration) {
+  auto until = Clock::now() + duration;
+  while (Clock::now() < until) {
+  }
+}
+
+Task<void> batch(std::shared_ptr<AbstractScheduler> scheduler,
+                 std::chrono::microseconds work, std::atomic<bool>& stop,
+                 std::latch& done) {
+  while (!stop.load(std::memory_order_relaxed)) {
+    spin_for(work);
+    co_await scheduler->dispatch_to(Priority::Low);
+  }
+  done.count_down();
+}
+
+Task<void> probe(std::shared_ptr<AbstractScheduler> scheduler, int samples,
+                 std::vector<double>& waits_us, std::latch& done) {
+  for (int i = 0; i < samples; ++i) {
+    co_await scheduler->schedule(1);  // idle between "I/O completions"
+    auto queued = Clock::now();
+    co_await scheduler->dispatch_to(Priority::High);
+    waits_us.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - queued)
+            .count());
+  }
+  done.count_down();
+}
+
+void run(const std::string& name, std::shared_ptr<AbstractScheduler> scheduler,
+         int batch_count, std::chrono::microseconds work, int samples) {
+  constexpr int kProbes = 4;
+  std::atomic<bool> stop{false};
+  std::latch batch_done(batch_count);
+  std::latch probes_done(kProbes);
+  std::vector<std::vector<double>> waits(kProbes);
+  std::vector<Task<void>> tasks;
+
+  for (int i = 0; i < batch_count; ++i) {
+    tasks.push_back(batch(scheduler, work, stop, batch_done));
+  }
+  for (int i = 0; i < kProbes; ++i) {
+    tasks.push_back(probe(scheduler, samples / kProbes, waits[i], probes_done));
+  }
+  for (auto& task : tasks) {
+    task.handle_.promise().set_scheduler(scheduler.get());
+    task.start();
+  }
+
+  probes_done.wait();
+  stop = true;
+  batch_done.wait();
+
+  std::vector<double> all;
+  for (auto& w : waits) all.insert(all.end(), w.begin(), w.end());
+  std::sort(all.begin(), all.end());
+  auto pct = [&](double p) {
+    return all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))];
+  };
+  std::cout << std::setw(20) << name << std::fixed << std::setprecision(1)
+            << std::setw(12) << pct(0.50) << std::setw(12) << pct(0.99)
+            << std::setw(12) << all.back() << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  size_t threads = 2;
+  int batch_count = 64;
+  int work_us = 50;
+  int samples = 2000;
+  if (argc > 1) threads = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) batch_count = std::atoi(argv[2]);
+  if (argc > 3) work_us = std::atoi(argv[3]);
+  if (argc > 4) samples = std::atoi(argv[4]);
+
+  std::cout << "threads=" << threads << " batch=" << batch_count
+            << " work_us=" << work_us << " samples=" << samples << "\n";
+  std::cout << std::setw(20) << "scheduler" << std::setw(12) << "p50 (us)"
+            << std::setw(12) << "p99 (us)" << std::setw(12) << "max (us)"
+            << "\n";
+
+  run("SimpleScheduler",
+      std::make_shared<SimpleScheduler>(
+          std::make_shared<ThreadPoolExecutor>(threads)),
+      batch_count, std::chrono::microseconds(work_us), samples);
+  run("PriorityScheduler",
+      std::make_shared<PriorityScheduler>(
+          std::make_shared<ThreadPoolExecutor>(threads)),
+      batch_count, std::chrono::microseconds(work_us), samples);
+  return 0;
+}
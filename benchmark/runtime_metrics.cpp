@@ -0,0 +1,91 @@
+// Cost of the executor metrics.
+//
+// Pushes a burst of small tasks through a ThreadPoolExecutor while another
+// thread scrapes metrics() in a loop, then reports the task throughput, the
+// cost of one metrics() call and the snapshot itself. Run with a scrape
+// interval of 0 to disable the scraper and compare the throughput.
+//
+// Usage: runtime_metrics [tasks] [threads] [scrape_interval_us]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <thread>
+
+#include "koroutine/debug.h"
+#include "koroutine/executors/thread_pool_executor.h"
+
+using namespace koroutine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double us(std::chrono::nanoseconds ns) { return ns.count() / 1000.0; }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  debug::set_level(debug::Level::None);
+
+  int tasks = 2'000'000;
+  size_t threads = 4;
+  int scrape_interval_us = 100;
+  if (argc > 1) tasks = std::atoi(argv[1]);
+  if (argc > 2) threads = static_cast<size_t>(std::atoi(argv[2]));
+  if (argc > 3) scrape_interval_us = std::atoi(argv[3]);
+
+  ThreadPoolExecutor pool(threads);
+  std::latch done(1);
+  std::atomic<int> remaining{tasks};
+
+  std::atomic<bool> scraping{scrape_interval_us > 0};
+  long long scrapes = 0;
+  std::chrono::nanoseconds scrape_time{0};
+  std::thread scraper([&] {
+    while (scraping.load(std::memory_order_relaxed)) {
+      auto start = Clock::now();
+      auto snapshot = pool.metrics();
+      scrape_time += Clock::now() - start;
+      ++scrapes;
+      (void)snapshot;
+      std::this_thread::sleep_for(std::chrono::microseconds(scrape_interval_us));
+    }
+  });
+
+  auto start = Clock::now();
+  for (int i = 0; i < tasks; ++i) {
+    pool.execute([&] {
+      if (remaining.fetch_sub(1, std::memory_order_relaxed) == 1) {
+        done.count_down();
+      }
+    });
+  }
+  done.wait();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  scraping = false;
+  scraper.join();
+
+  auto m = pool.metrics();
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "throughput:        " << std::setprecision(0)
+            << tasks / seconds << " tasks/s\n"
+            << std::setprecision(2);
+  if (scrapes > 0) {
+    std::cout << "metrics() cost:    " << us(scrape_time) * 1000.0 / scrapes
+              << " ns/call (" << scrapes << " calls)\n";
+  }
+  std::cout << "workers:           " << m.workers << "\n"
+            << "executed:          " << m.executed << "\n"
+            << "utilization:       " << m.utilization() * 100.0 << " %\n"
+            << "latency samples:   " << m.schedule_latency.count << "\n"
+            << "latency mean:      " << us(m.schedule_latency.mean())
+            << " us\n"
+            << "latency p50 <=     " << us(m.schedule_latency.percentile(0.5))
+            << " us\n"
+            << "latency p99 <=     "
+            << us(m.schedule_latency.percentile(0.99)) << " us\n";
+  return 0;
+}
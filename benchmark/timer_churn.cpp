@@ -0,0 +1,111 @@
+// Timer churn benchmark: hierarchical timer wheel vs std::priority_queue.
+//
+// Models connection idle timeouts: N timers are armed with random deadlines,
+// then every timer is re-armed (cancel + add) R times, and finally the whole
+// set is drained. The priority queue cannot cancel, so it is measured with
+// lazy deletion (stale entries are skipped when popped), which is what the
+// old executor timer threads effectively paid for.
+//
+// Usage: timer_churn [timers] [rounds]
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "koroutine/details/timer_wheel.hpp"
+
+using namespace koroutine;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double run_wheel(int timers, int rounds, const std::vector<uint64_t>& delays) {
+  details::TimerWheel wheel;
+  std::vector<details::TimerWheel::TimerId> ids(timers);
+  size_t fired = 0;
+  size_t next = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < timers; ++i) {
+    ids[i] = wheel.add(delays[next++ % delays.size()], [&fired] { ++fired; });
+  }
+  for (int r = 0; r < rounds; ++r) {
+    for (int i = 0; i < timers; ++i) {
+      wheel.cancel(ids[i]);
+      ids[i] = wheel.add(delays[next++ % delays.size()], [&fired] { ++fired; });
+    }
+  }
+  std::vector<Runnable> expired;
+  wheel.advance(UINT32_MAX, expired);
+  for (auto& callback : expired) callback();
+  double elapsed = seconds_since(start);
+
+  if (fired != static_cast<size_t>(timers)) std::abort();
+  return elapsed;
+}
+
+double run_heap(int timers, int rounds, const std::vector<uint64_t>& delays) {
+  using Entry = std::pair<uint64_t, std::pair<int, uint32_t>>;  // when, id, gen
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+  std::vector<uint32_t> generation(timers, 0);
+  std::vector<std::function<void()>> callbacks(timers);
+  size_t fired = 0;
+  size_t next = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < timers; ++i) {
+    callbacks[i] = [&fired] { ++fired; };
+    heap.push({delays[next++ % delays.size()], {i, generation[i]}});
+  }
+  for (int r = 0; r < rounds; ++r) {
+    for (int i = 0; i < timers; ++i) {
+      ++generation[i];
+      callbacks[i] = [&fired] { ++fired; };
+      heap.push({delays[next++ % delays.size()], {i, generation[i]}});
+    }
+  }
+  while (!heap.empty()) {
+    auto [id, gen] = heap.top().second;
+    heap.pop();
+    if (gen == generation[id]) callbacks[id]();
+  }
+  double elapsed = seconds_since(start);
+
+  if (fired != static_cast<size_t>(timers)) std::abort();
+  return elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int timers = 200000;
+  int rounds = 5;
+  if (argc > 1) timers = std::atoi(argv[1]);
+  if (argc > 2) rounds = std::atoi(argv[2]);
+
+  std::mt19937_64 rng(1);
+  std::vector<uint64_t> delays(1 << 16);
+  for (auto& delay : delays) delay = 1000 + rng() % 120000;  // 1s..2min
+
+  double wheel = run_wheel(timers, rounds, delays);
+  double heap = run_heap(timers, rounds, delays);
+  double ops = static_cast<double>(timers) * (rounds + 1);
+
+  std::cout << "timers=" << timers << " rounds=" << rounds << "\n";
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(16) << "timer_wheel" << std::setw(12)
+            << ops / wheel / 1e6 << " M arms/s\n";
+  std::cout << std::setw(16) << "priority_queue" << std::setw(12)
+            << ops / heap / 1e6 << " M arms/s\n";
+  return 0;
+}
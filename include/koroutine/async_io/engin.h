@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <stdexcept>
 #include <thread>
 
 #include "koroutine/async_io/op.h"
@@ -17,14 +18,47 @@ class IOEngine {
   virtual void stop() = 0;        // 停止IO引擎的事件循环
   virtual bool is_running() = 0;  // 检查IO引擎是否在运行
 
+  /**
+   * @brief 处理一轮待提交的操作和已完成的事件
+   * @param timeout_ms 小于 0 时阻塞直到至少有一个事件，0 表示不阻塞
+   * @return 本轮完成的 IO 操作数量
+   *
+   * 供 thread-per-core 模式下由分片线程自己驱动引擎，代替 run()。
+   * 只有 supports_poll() 为 true 的引擎实现了它。
+   */
+  virtual size_t poll(int timeout_ms) {
+    (void)timeout_ms;
+    throw std::runtime_error("IOEngine::poll is not supported by this engine");
+  }
+
+  // 是否实现了 poll()，目前只有 io_uring 引擎支持
+  virtual bool supports_poll() const { return false; }
+
+  // 唤醒阻塞在 poll() 中的线程
+  virtual void wakeup() {}
+
   static std::shared_ptr<IOEngine> create();  // 工厂方法：创建平台相关引擎
  protected:
   // 完成IO操作后唤醒协程
   void complete(std::shared_ptr<AsyncIOOp> op) { op->complete(); }
 };
 
-// 获取默认的 IO 引擎 (单例)
+namespace details {
+inline std::shared_ptr<IOEngine>& thread_io_engine() {
+  thread_local std::shared_ptr<IOEngine> engine;
+  return engine;
+}
+}  // namespace details
+
+// 为当前线程指定默认 IO 引擎，thread-per-core 模式下每个分片线程使用自己的引擎；
+// 传入 nullptr 恢复使用全局引擎
+inline void set_thread_io_engine(std::shared_ptr<IOEngine> engine) {
+  details::thread_io_engine() = std::move(engine);
+}
+
+// 获取默认的 IO 引擎：当前线程指定的引擎，否则为全局单例
 inline std::shared_ptr<IOEngine> get_default_io_engine() {
+  if (auto& local = details::thread_io_engine()) return local;
   static auto engine = [] {
     auto eng = IOEngine::create();
     // 在后台线程运行默认引擎
@@ -311,11 +311,11 @@ using socket_t = int;
 #include "koroutine/async_io/op.h"
 #include "koroutine/async_io/resolver.h"
 #include "koroutine/async_io/socket.h"
+#include "koroutine/async_scope.hpp"
 #include "koroutine/awaiters/io_awaiter.hpp"
 #include "koroutine/debug.h"
 #include "koroutine/runtime.hpp"
 #include "koroutine/task.hpp"
-#include "koroutine/task_manager.h"
 
 #if defined(CPPHTTPLIB_USE_NON_BLOCKING_GETADDRINFO) || \
     defined(CPPHTTPLIB_USE_CERTS_FROM_MACOSX_KEYCHAIN)
@@ -1322,7 +1322,8 @@ class Server {
                                   const Response& res) const;
   void output_error_log(const Error& err, const Request* req) const;
 
-  koroutine::TaskManager task_manager_;
+  // 每个连接一个子任务，不为连接额外分配内存
+  koroutine::AsyncScope connections_;
   std::atomic<bool> is_running_{false};
   std::atomic<bool> is_decommissioned{false};
   int port_ = -1;
@@ -8518,8 +8519,8 @@ inline void Server::stop() {
   LOG_INFO("Server::stop called");
   if (is_running_.exchange(false)) {
     assert(svr_sock_ != INVALID_SOCKET);
-    LOG_INFO("Server::stop - cancelling group");
-    task_manager_.cancel_group("http_connections");
+    LOG_INFO("Server::stop - cancelling connections");
+    connections_.cancel();
 
     if (server_socket_) {
       LOG_INFO("Server::stop - closing server socket via engine");
@@ -9140,6 +9141,10 @@ inline koroutine::Task<bool> Server::listen_async(const std::string& host,
 
   try {
     while (is_running_) {
+      auto* scheduler = koroutine::SchedulerManager::current_scheduler();
+      // 运行时饱和时：OverflowPolicy::Block 下暂停 accept，新连接留在内核
+      // 的 backlog 里；队列无界时这里不挂起
+      if (scheduler) co_await scheduler->admit();
       auto client_socket = co_await server_socket_->accept();
       if (!client_socket) {
         LOG_WARN("Server accept failed or stopped");
@@ -9147,6 +9152,14 @@ inline koroutine::Task<bool> Server::listen_async(const std::string& host,
       }
       LOG_ERROR("Accepted new connection");
 
+      // 其他策略下饱和时立即关闭新连接，而不是让它排在过长的队列后面
+      if (scheduler && !scheduler->has_capacity(
+                           koroutine::ScheduleMetadata::Priority::Normal)) {
+        LOG_WARN("Server saturated, closing new connection");
+        co_await client_socket->close();
+        continue;
+      }
+
       {
         std::lock_guard lock(clients_mtx_);
         clients_.push_back(client_socket);
@@ -9177,9 +9190,7 @@ inline koroutine::Task<bool> Server::listen_async(const std::string& host,
         co_await client->close();
       }(this, std::move(client_socket));
 
-      task_manager_.submit_to_group(
-          "http_connections",
-          std::make_shared<koroutine::Task<void>>(std::move(task)));
+      connections_.spawn(std::move(task));
     }
   } catch (const std::exception& e) {
     LOG_WARN("Server listen loop interrupted by exception: ", e.what());
@@ -9187,9 +9198,10 @@ inline koroutine::Task<bool> Server::listen_async(const std::string& host,
     LOG_WARN("Server listen loop interrupted by unknown exception");
   }
   LOG_INFO("Server stopping...");
-  LOG_INFO("Server calling task_manager_.shutdown()");
-  co_await task_manager_.shutdown();
-  LOG_INFO("Server task_manager_.shutdown() returned");
+  LOG_INFO("Server cancelling ", connections_.active(), " connections");
+  connections_.cancel();
+  co_await connections_.join();
+  LOG_INFO("Server connections joined");
   LOG_INFO("Server stopped");
   is_running_ = false;
   co_return true;
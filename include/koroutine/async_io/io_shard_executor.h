@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "koroutine/async_io/engin.h"
+#include "koroutine/details/mpsc_queue.hpp"
+#include "koroutine/details/ring_queue.hpp"
+#include "koroutine/details/thread_affinity.hpp"
+#include "koroutine/executors/executor.h"
+#include "koroutine/executors/runnable.h"
+
+namespace koroutine::async_io {
+
+/**
+ * @brief Single-threaded executor that drives its own IO engine.
+ *
+ * The shard thread alternates between running queued coroutines and polling
+ * the engine, so IO is submitted, completed and resumed on the same core
+ * without any cross-thread hand-off. Work queued from the shard thread goes
+ * to an unsynchronised local queue; other threads go through a lock-free
+ * inbox and wake the shard out of a blocking poll through the engine's
+ * wakeup().
+ *
+ * While the shard thread runs, get_default_io_engine() returns this shard's
+ * engine, so sockets and files created there register with it.
+ *
+ * The engine must support poll() (currently io_uring only); the constructor
+ * throws std::invalid_argument otherwise.
+ */
+class IoShardExecutor : public AbstractExecutor {
+ public:
+  explicit IoShardExecutor(
+      std::shared_ptr<IOEngine> engine = IOEngine::create())
+      : engine_(std::move(engine)) {
+    if (!engine_->supports_poll()) {
+      throw std::invalid_argument(
+          "IoShardExecutor requires an IO engine that supports poll()");
+    }
+    thread_ = std::thread(&IoShardExecutor::run_loop, this);
+    thread_id_ = thread_.get_id();
+  }
+
+  ~IoShardExecutor() override { shutdown(); }
+
+  using AbstractExecutor::execute;
+
+  void execute(std::function<void()>&& func) override {
+    enqueue(Runnable(std::move(func)));
+  }
+
+  void execute(std::coroutine_handle<> handle) override {
+    enqueue(Runnable(handle));
+  }
+
+  // The shard thread is the only thread this executor can route to.
+  bool execute_on(std::thread::id thread,
+                  std::coroutine_handle<> handle) override {
+    if (thread != thread_id_) return false;
+    enqueue(Runnable(handle));
+    return true;
+  }
+
+  /**
+   * @brief Stop the loop once the queued work has run, then join the shard
+   * thread. Safe to call more than once; work submitted afterwards is dropped.
+   */
+  void shutdown() override {
+    if (stopping_.exchange(true)) return;
+    cancel_delayed();
+    engine_->wakeup();
+    if (!thread_.joinable()) return;
+    if (std::this_thread::get_id() == thread_id_) {
+      thread_.detach();
+    } else {
+      thread_.join();
+    }
+  }
+
+  /**
+   * @brief Restrict the shard thread to the given CPUs (Linux only).
+   */
+  bool pin(const std::vector<int>& cpus) {
+    if (!thread_.joinable()) return false;
+    return koroutine::details::set_thread_affinity(thread_.native_handle(),
+                                                   cpus);
+  }
+
+  std::thread::id thread_id() const { return thread_id_; }
+
+  std::shared_ptr<IOEngine> engine() const { return engine_; }
+
+ private:
+  void enqueue(Runnable&& task) {
+    if (stopping_.load(std::memory_order_relaxed)) {
+      LOG_WARN("IoShardExecutor::execute - executor stopped, dropping task");
+      return;
+    }
+    if (owns_current_thread()) {
+      local_.push(std::move(task));
+      return;
+    }
+    inbox_.push(std::move(task));
+    // Pairs with the parked_ store / inbox_ recheck in run_loop().
+    if (parked_.load(std::memory_order_seq_cst)) engine_->wakeup();
+  }
+
+  void drain_inbox() {
+    Runnable task;
+    while (inbox_.try_pop(task)) local_.push(std::move(task));
+  }
+
+  void run_loop() {
+    bind_current_thread(this);
+    set_thread_io_engine(engine_);
+
+    while (true) {
+      drain_inbox();
+
+      // Only run what was queued when the round started so that a coroutine
+      // that keeps rescheduling itself cannot starve IO polling.
+      for (size_t n = local_.size(); n > 0; --n) {
+        auto task = local_.pop();
+        try {
+          task();
+        } catch (const std::exception& e) {
+          LOG_ERROR("IoShardExecutor::run_loop - task threw: ", e.what());
+        } catch (...) {
+          LOG_ERROR(
+              "IoShardExecutor::run_loop - task threw unknown exception");
+        }
+      }
+
+      if (!local_.empty()) {
+        engine_->poll(0);
+        continue;
+      }
+
+      parked_.store(true, std::memory_order_seq_cst);
+      if (!inbox_.empty()) {
+        parked_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+      if (stopping_.load()) break;
+      engine_->poll(-1);
+      parked_.store(false, std::memory_order_relaxed);
+    }
+
+    set_thread_io_engine(nullptr);
+    bind_current_thread(nullptr);
+  }
+
+  std::shared_ptr<IOEngine> engine_;
+  std::thread thread_;
+  std::thread::id thread_id_;
+
+  // Owned by the shard thread.
+  koroutine::details::RingQueue<Runnable> local_;
+
+  koroutine::details::MpscQueue<Runnable> inbox_;
+
+  std::atomic<bool> parked_{false};
+  std::atomic<bool> stopping_{false};
+};
+
+}  // namespace koroutine::async_io
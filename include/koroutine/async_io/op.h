@@ -1,6 +1,8 @@
 #pragma once
 #include <coroutine>
 #include <cstring>
+#include <optional>
+#include <thread>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -25,7 +27,8 @@ class AsyncIOOp {
   size_t actual_size;                            // 实际处理的大小
   std::error_code error;                         // 操作结果（错误码）
   std::coroutine_handle<> coro_handle;           // 协程句柄
-  std::shared_ptr<AbstractScheduler> scheduler;  // 调度器指针
+  AbstractScheduler* scheduler;                  // 调度器指针（不持有）
+  std::optional<std::thread::id> affinity;       // 完成后回到发起线程恢复
 
   // For UDP
   struct sockaddr_storage addr;
@@ -53,7 +56,7 @@ class AsyncIOOp {
         actual_size(0),
         error(),
         addr_len(sizeof(addr)) {
-    scheduler = SchedulerManager::get_default_scheduler();
+    scheduler = SchedulerManager::current_scheduler();
     std::memset(&addr, 0, sizeof(addr));
 #ifdef _WIN32
     std::memset(&overlapped, 0, sizeof(overlapped));
@@ -76,6 +79,7 @@ class AsyncIOOp {
     // 使用新的 ScheduleRequest 接口
     // IO 完成优先级设为 High，确保及时响应
     ScheduleMetadata meta(ScheduleMetadata::Priority::High, "io_completion");
+    meta.affinity = affinity;
     scheduler->schedule(ScheduleRequest(coro_handle, std::move(meta)), 0);
   }
 };
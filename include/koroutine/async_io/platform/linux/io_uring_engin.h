@@ -4,13 +4,13 @@
 #include <liburing.h>
 
 #include <atomic>
-#include <mutex>
-#include <queue>
+#include <thread>
 #include <unordered_map>
 
 #include "koroutine/async_io/engin.h"
 #include "koroutine/async_io/io_object.h"
 #include "koroutine/awaiters/io_awaiter.hpp"
+#include "koroutine/details/mpsc_queue.hpp"
 
 namespace koroutine::async_io {
 class IoUringIOEngine : public IOEngine {
@@ -21,16 +21,26 @@ class IoUringIOEngine : public IOEngine {
   void run() override;
   void stop() override;
   bool is_running() override;
+  size_t poll(int timeout_ms) override;
+  bool supports_poll() const override { return true; }
+  void wakeup() override;
 
  private:
+  // 返回本轮完成的操作数量，出错时返回负的 errno
+  int poll_once(int timeout_ms);
+  void arm_wakeup();
   void process_op(std::shared_ptr<AsyncIOOp> op);
   void submit_sqe();
 
   struct io_uring ring_;
   int event_fd_;
+  uint64_t wakeup_buf_ = 0;
+  bool wakeup_armed_ = false;
+  // 正在驱动 ring 的线程；在该线程上提交的操作直接写入 SQ
+  std::atomic<std::thread::id> poll_thread_{};
   std::atomic<bool> running_;
-  std::mutex ops_mutex_;
-  std::queue<std::shared_ptr<AsyncIOOp>> pending_ops_;
+  // 其他线程提交、等待 ring 线程处理的操作
+  koroutine::details::MpscQueue<std::shared_ptr<AsyncIOOp>> pending_ops_;
   std::unordered_map<AsyncIOOp*, std::shared_ptr<AsyncIOOp>> in_flight_ops_;
 };
 }  // namespace koroutine::async_io
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "koroutine/async_io/io_shard_executor.h"
+#include "koroutine/runtime.hpp"
+#include "koroutine/scheduler_manager.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/task.hpp"
+
+namespace koroutine::async_io {
+
+/**
+ * @brief thread-per-core 运行时：每个分片一个线程、一个运行队列和一个 IO 引擎
+ *
+ * 每个分片由 IoShardExecutor 驱动，分片线程上创建的协程、子任务和 IO 对象
+ * 默认都使用该分片的调度器与引擎，整个请求的生命周期不离开这个线程。
+ * 分片之间不共享队列，需要跨分片时显式 switch_to(runtime.scheduler(j))。
+ *
+ * 使用示例：
+ * @code
+ * async_io::ShardedRuntime runtime;  // 每个硬件线程一个分片
+ * runtime.pin_shards();
+ * // 每个分片一个 SO_REUSEPORT 监听器，由内核在分片间分配连接
+ * runtime.spawn_each([](size_t shard) { return serve(port); });
+ * @endcode
+ */
+class ShardedRuntime {
+ public:
+  explicit ShardedRuntime(
+      size_t shards = std::max(1u, std::thread::hardware_concurrency())) {
+    if (shards == 0) {
+      throw std::invalid_argument("ShardedRuntime requires at least one shard");
+    }
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+      Shard shard;
+      shard.executor = std::make_shared<IoShardExecutor>();
+      shard.scheduler = std::make_shared<SimpleScheduler>(shard.executor);
+      // 分片线程上新建的协程默认属于本分片
+      shard.executor->execute([scheduler = shard.scheduler]() {
+        SchedulerManager::set_thread_default_scheduler(scheduler);
+      });
+      shards_.push_back(std::move(shard));
+    }
+  }
+
+  ~ShardedRuntime() { shutdown(); }
+
+  ShardedRuntime(const ShardedRuntime&) = delete;
+  ShardedRuntime& operator=(const ShardedRuntime&) = delete;
+
+  size_t size() const { return shards_.size(); }
+
+  std::shared_ptr<AbstractScheduler> scheduler(size_t shard) const {
+    return shards_.at(shard).scheduler;
+  }
+
+  std::shared_ptr<IoShardExecutor> executor(size_t shard) const {
+    return shards_.at(shard).executor;
+  }
+
+  std::shared_ptr<IOEngine> engine(size_t shard) const {
+    return shards_.at(shard).executor->engine();
+  }
+
+  /**
+   * @brief 在指定分片上启动任务并分离
+   */
+  template <typename T>
+  void spawn(size_t shard, Task<T>&& task) {
+    task.handle_.promise().set_scheduler(scheduler(shard).get());
+    task.start_detached();
+  }
+
+  /**
+   * @brief 在每个分片上各启动一个任务
+   * @param factory 以分片序号为参数、返回 Task 的可调用对象
+   */
+  template <typename Factory>
+  void spawn_each(Factory&& factory) {
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      spawn(i, factory(i));
+    }
+  }
+
+  /**
+   * @brief 在指定分片上运行任务，阻塞当前线程直到完成并返回结果
+   */
+  template <typename T>
+  T block_on(size_t shard, Task<T>&& task) {
+    task.handle_.promise().set_scheduler(scheduler(shard).get());
+    return Runtime::block_on(std::move(task));
+  }
+
+  /**
+   * @brief 将分片 i 绑定到 cpus[i % cpus.size()]，默认按核心顺序一片一核
+   */
+  bool pin_shards(std::vector<int> cpus = {}) {
+    if (cpus.empty()) {
+      unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned cpu = 0; cpu < cores; ++cpu) {
+        cpus.push_back(static_cast<int>(cpu));
+      }
+    }
+    bool pinned = true;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      pinned &= shards_[i].executor->pin({cpus[i % cpus.size()]});
+    }
+    return pinned;
+  }
+
+  /**
+   * @brief 执行完各分片已排队的工作后停止所有分片线程，可重复调用
+   */
+  void shutdown() {
+    if (stopped_) return;
+    stopped_ = true;
+    for (auto& shard : shards_) {
+      shard.executor->execute(
+          [] { SchedulerManager::set_thread_default_scheduler(nullptr); });
+    }
+    for (auto& shard : shards_) {
+      shard.executor->shutdown();
+    }
+  }
+
+ private:
+  struct Shard {
+    std::shared_ptr<IoShardExecutor> executor;
+    std::shared_ptr<SimpleScheduler> scheduler;
+  };
+
+  std::vector<Shard> shards_;
+  bool stopped_ = false;
+};
+
+}  // namespace koroutine::async_io
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "awaiters/awaiter.hpp"
+#include "cancellation.hpp"
+#include "runtime.hpp"
+#include "task.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief 结构化并发作用域（nursery）
+ *
+ * spawn() 启动的子任务都归属于作用域：co_await join() 在最后一个子任务
+ * 结束后恰好恢复一次，cancel() 把取消传播给所有子任务。
+ *
+ * 作用域不为子任务分配任何东西：子任务的 promise 作为侵入式节点挂在
+ * 作用域的取消令牌上，结束时 O(1) 摘除；所有子任务共用作用域里的同一个
+ * 结束钩子，作用域本身只维护一个原子计数。
+ *
+ * 子任务是分离的，结束时自行销毁协程帧，异常被丢弃（与 Runtime::spawn
+ * 相同）。取消是不可撤销的：取消之后再 spawn 的子任务一开始就处于
+ * 取消状态。同一时刻只能有一个 join()。
+ *
+ * 使用示例：
+ * @code
+ * AsyncScope scope;
+ * for (auto& conn : connections) scope.spawn(handle(conn));
+ * co_await scope.join();
+ * @endcode
+ */
+class AsyncScope : private FinishHook {
+ public:
+  class JoinAwaiter;
+
+  AsyncScope() { on_finished = &AsyncScope::on_child_finished; }
+  AsyncScope(const AsyncScope&) = delete;
+  AsyncScope& operator=(const AsyncScope&) = delete;
+
+  // 还有子任务时取消并等待它们结束，否则它们的结束钩子会访问已销毁的作用域
+  ~AsyncScope() {
+    if (active() == 0) return;
+    LOG_WARN("AsyncScope::~AsyncScope - ", active(),
+             " children still running, cancelling and joining");
+    cancel();
+    sync_join();
+  }
+
+  /**
+   * @brief 在作用域内启动并分离一个任务
+   * @param task 尚未启动的任务
+   */
+  template <typename T>
+  void spawn(Task<T>&& task) {
+    // 先计数再启动：子任务可能在 start 返回之前就已经结束
+    state_.fetch_add(kChild, std::memory_order_relaxed);
+    task.with_cancellation(source_.token()).on_finished(this);
+    task.start_detached();
+  }
+
+  /**
+   * @brief 等待所有子任务结束
+   *
+   * 没有子任务时不挂起。等待期间 spawn 的子任务同样会被等待。
+   */
+  JoinAwaiter join();
+
+  // 同步等待所有子任务结束
+  void sync_join();
+
+  /**
+   * @brief 取消所有子任务
+   *
+   * 子任务在下一个 co_await 点抛出 OperationCancelledException 并结束，
+   * 之后照常计入 join()。
+   */
+  void cancel() { source_.cancel(); }
+
+  bool is_cancelled() const { return source_.is_cancelled(); }
+
+  // 尚未结束的子任务数
+  size_t active() const {
+    return static_cast<size_t>(state_.load(std::memory_order_acquire) /
+                               kChild);
+  }
+
+ private:
+  // state_ 的最低位：有 join() 在等待；其余位：未结束的子任务数
+  static constexpr uint64_t kWaiting = 1;
+  static constexpr uint64_t kChild = 2;
+
+  static void on_child_finished(FinishHook* hook);
+
+  CancellationTokenSource source_;
+  std::atomic<uint64_t> state_{0};
+  JoinAwaiter* waiter_ = nullptr;
+};
+
+/**
+ * @brief 挂起到作用域的子任务全部结束
+ *
+ * 只在还有子任务时登记等待位；最后一个子任务结束时看到计数从 1 变为 0
+ * 且等待位已置，由它恢复等待者。这个转变只会被一个线程观察到，
+ * 因此等待者恰好被恢复一次。
+ */
+class AsyncScope::JoinAwaiter : public AwaiterBase<void> {
+ public:
+  explicit JoinAwaiter(AsyncScope* scope) : scope_(scope) {}
+
+ protected:
+  bool try_complete_inline() override {
+    if (scope_->state_.load(std::memory_order_acquire) >= kChild) return false;
+    _result = Result<void>();
+    return true;
+  }
+
+  void after_suspend() override {
+    scope_->waiter_ = this;
+    uint64_t state = scope_->state_.load(std::memory_order_relaxed);
+    do {
+      // 最后一个子任务在 try_complete_inline 之后已经结束
+      if (state < kChild) {
+        scope_->waiter_ = nullptr;
+        resume();
+        return;
+      }
+    } while (!scope_->state_.compare_exchange_weak(state, state | kWaiting,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+  }
+
+ private:
+  friend class AsyncScope;
+  AsyncScope* scope_;
+};
+
+inline AsyncScope::JoinAwaiter AsyncScope::join() { return JoinAwaiter(this); }
+
+inline void AsyncScope::sync_join() {
+  Runtime::block_on([](AsyncScope* self) -> Task<void> {
+    co_await self->join();
+  }(this));
+}
+
+inline void AsyncScope::on_child_finished(FinishHook* hook) {
+  auto* self = static_cast<AsyncScope*>(hook);
+  uint64_t state = self->state_.load(std::memory_order_acquire);
+  while (true) {
+    if (state != (kChild | kWaiting)) {
+      if (self->state_.compare_exchange_weak(state, state - kChild,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+        return;
+      }
+      continue;
+    }
+    // 最后一个子任务且有 join 在等待：等待位置位之前 waiter_ 已经写好，
+    // 等待者被恢复之前不会再变。先读到局部变量，再用同一次 CAS 清掉
+    // 计数和等待位——这是对作用域的最后一次访问，之后作用域随时可能
+    // 被销毁（另一个线程看到 active() 为 0 即可析构它）
+    auto* waiter = self->waiter_;
+    if (self->state_.compare_exchange_weak(state, 0,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+      LOG_TRACE("AsyncScope - last child finished, resuming join");
+      waiter->resume();
+      return;
+    }
+  }
+}
+
+}  // namespace koroutine
@@ -1,5 +1,6 @@
 #pragma once
 #include "../coroutine_common.h"
+#include "../details/coop_budget.hpp"
 #include "../result.hpp"
 #include "../schedulers/scheduler.h"
 
@@ -16,7 +17,8 @@ class AwaiterBaseCRTP {
 
   // move constructor
   AwaiterBaseCRTP(AwaiterBaseCRTP&& awaiter) noexcept
-      : _scheduler(std::move(awaiter._scheduler)),
+      : _scheduler(awaiter._scheduler),
+        _resume_deadline(awaiter._resume_deadline),
         _caller_handle(std::move(awaiter._caller_handle)),
         _result(std::move(awaiter._result)) {
     LOG_INFO("AwaiterBaseCRTP::move constructor - moved awaiter");
@@ -33,11 +35,21 @@ class AwaiterBaseCRTP {
         "the caller handle  ",
         caller_handle.address());
     this->_caller_handle = caller_handle;
+    // 结果已经可以立即得到时不挂起，也不经过调度器队列，直接继续执行调用者
+    if (static_cast<Derived*>(this)->try_complete_inline()) {
+      // 连续就绪的 await 用完预算后仍让出一次：结果已写入，
+      // 只是把调用者重新排到调度队列末尾，避免独占工作线程
+      if (details::CoopBudget::consume() || !_scheduler) return false;
+      resume_unsafe();
+      return true;
+    }
     static_cast<Derived*>(this)->after_suspend();
     return true;  // 确实要挂起，保持awaiter存活
   }
 
-  void install_scheduler(std::shared_ptr<AbstractScheduler> scheduler) {
+  // 只记录裸指针：awaiter 活不过等待它的协程，而协程所在的调度器
+  // 由运行时保证存活，恢复路径上因此不做引用计数
+  void install_scheduler(AbstractScheduler* scheduler) {
     if (!scheduler) {
       LOG_ERROR("AwaiterBase::install_scheduler - null scheduler provided");
     }
@@ -45,12 +57,25 @@ class AwaiterBaseCRTP {
     _scheduler = scheduler;
   }
 
+  // 记录所在任务的截止时间，恢复请求带上它，供 DeadlineScheduler 排序
+  void install_deadline(
+      std::optional<AbstractScheduler::Clock::time_point> deadline) {
+    _resume_deadline = deadline;
+  }
+
  protected:
+  ScheduleMetadata resume_metadata(ScheduleMetadata::Priority priority,
+                                   DebugName debug_name) const {
+    ScheduleMetadata meta(priority, debug_name);
+    meta.deadline = _resume_deadline;
+    return meta;
+  }
+
   void resume_unsafe() {
     if (_scheduler) {
       // 直接使用 ScheduleRequest 调度协程恢复
-      ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
-                            "awaiter_resume");
+      ScheduleMetadata meta = resume_metadata(
+          ScheduleMetadata::Priority::Normal, "awaiter_resume");
       _scheduler->schedule(ScheduleRequest(_caller_handle, std::move(meta)), 0);
     } else {
       LOG_ERROR("AwaiterBase::resume_unsafe - no scheduler, resuming directly");
@@ -60,7 +85,8 @@ class AwaiterBaseCRTP {
 
  protected:
   std::optional<Result<R>> _result{};
-  std::shared_ptr<AbstractScheduler> _scheduler = nullptr;
+  AbstractScheduler* _scheduler = nullptr;
+  std::optional<AbstractScheduler::Clock::time_point> _resume_deadline;
   //   存储调用者的协程句柄，用于awaiter执行结束后恢复调用者协程
   std::coroutine_handle<> _caller_handle = nullptr;
 };
@@ -103,6 +129,13 @@ class AwaiterBase : public AwaiterBaseCRTP<R, AwaiterBase<R>> {
     _result = Result<R>(static_cast<std::exception_ptr>(e));
     resume_unsafe();
   }
+  /**
+   * @brief 同步快速路径：能立即完成时写入 _result 并返回 true
+   *
+   * 返回 true 时协程不会挂起，after_suspend 也不会被调用。
+   * 默认返回 false，总是走挂起路径。
+   */
+  virtual bool try_complete_inline() { return false; }
   virtual void after_suspend() {
     LOG_INFO(
         "AwaiterBase::after_suspend - default implementation does nothing.");
@@ -149,6 +182,13 @@ class AwaiterBase<void> : public AwaiterBaseCRTP<void, AwaiterBase<void>> {
     _result = Result<void>(static_cast<std::exception_ptr>(e));
     resume_unsafe();
   }
+  /**
+   * @brief 同步快速路径：能立即完成时写入 _result 并返回 true
+   *
+   * 返回 true 时协程不会挂起，after_suspend 也不会被调用。
+   * 默认返回 false，总是走挂起路径。
+   */
+  virtual bool try_complete_inline() { return false; }
   virtual void after_suspend() {
     LOG_INFO(
         "AwaiterBase::after_suspend - default implementation does nothing.");
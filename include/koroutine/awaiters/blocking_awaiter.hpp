@@ -0,0 +1,67 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "../coroutine_common.h"
+#include "../executors/blocking_pool.h"
+#include "awaiter.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief 在 BlockingPool 上运行阻塞函数，完成后在原调度器上恢复协程
+ *
+ * 函数的返回值（或抛出的异常）作为 co_await 的结果。
+ */
+template <typename F>
+struct BlockingAwaiter : public AwaiterBase<std::invoke_result_t<F&>> {
+  using R = std::invoke_result_t<F&>;
+
+  BlockingAwaiter(F fn, BlockingPool& pool)
+      : _fn(std::move(fn)), _pool(&pool) {}
+
+  BlockingAwaiter(BlockingAwaiter&& awaiter) noexcept
+      : AwaiterBase<R>(std::move(awaiter)),
+        _fn(std::move(awaiter._fn)),
+        _pool(awaiter._pool) {}
+
+  BlockingAwaiter(BlockingAwaiter&) = delete;
+  BlockingAwaiter& operator=(BlockingAwaiter&) = delete;
+
+ protected:
+  void after_suspend() override {
+    _pool->execute([this]() {
+      try {
+        if constexpr (std::is_void_v<R>) {
+          _fn();
+          this->resume();
+        } else {
+          this->resume(_fn());
+        }
+      } catch (...) {
+        this->resume_exception(std::current_exception());
+      }
+    });
+  }
+
+ private:
+  F _fn;
+  BlockingPool* _pool;
+};
+
+/**
+ * @brief 把阻塞调用移出工作线程：co_await spawn_blocking([] { ... })
+ *
+ * 默认使用进程级的 BlockingPool::instance()，空闲线程会被复用，
+ * 请求路径上不再为每次调用创建线程。
+ */
+template <typename F>
+BlockingAwaiter<std::decay_t<F>> spawn_blocking(
+    F&& fn, BlockingPool& pool = BlockingPool::instance()) {
+  return BlockingAwaiter<std::decay_t<F>>(std::forward<F>(fn), pool);
+}
+
+}  // namespace koroutine
@@ -26,6 +26,10 @@ struct WriterAwaiter : public AwaiterBase<void> {
   }
 
  protected:
+  bool try_complete_inline() override {
+    return channel->try_write_inline(this);
+  }
+
   void after_suspend() override { channel->try_push_writer(this); }
 
   void before_resume() override {
@@ -52,10 +56,15 @@ struct ReaderAwaiter : public AwaiterBase<ValueType> {
   }
 
  protected:
+  bool try_complete_inline() override {
+    return channel->try_read_inline(this);
+  }
+
   void after_suspend() override { channel->try_push_reader(this); }
 
   void before_resume() override {
-    channel->check_closed();
+    // 已经拿到值的读者不受之后的 close 影响
+    if (!this->_result) channel->check_closed();
     if (p_value) {
       *p_value = this->_result->get_or_throw();
     }
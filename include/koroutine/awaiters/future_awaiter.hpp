@@ -1,8 +1,10 @@
 #pragma once
+#include <exception>
 #include <future>
-#include <thread>
+#include <type_traits>
 
 #include "../coroutine_common.h"
+#include "../executors/blocking_pool.h"
 #include "awaiter.hpp"
 
 namespace koroutine {
@@ -21,8 +23,20 @@ struct FutureAwaiter : public AwaiterBase<R> {
   FutureAwaiter& operator=(FutureAwaiter&) = delete;
 
  protected:
+  // future::get() 会阻塞，放到 BlockingPool 上等待，不再为每个 future 新建线程
   void after_suspend() override {
-    std::thread([this]() { this->resume(this->_future.get()); }).detach();
+    BlockingPool::instance().execute([this]() {
+      try {
+        if constexpr (std::is_void_v<R>) {
+          this->_future.get();
+          this->resume();
+        } else {
+          this->resume(this->_future.get());
+        }
+      } catch (...) {
+        this->resume_exception(std::current_exception());
+      }
+    });
   }
 
  private:
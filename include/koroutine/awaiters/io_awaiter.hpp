@@ -21,6 +21,7 @@ struct IOAwaiter : public AwaiterBase<T> {
   void after_suspend() override {
     LOG_INFO("IOAwaiter::after_suspend - IO operation submitted");
     io_op->coro_handle = this->_caller_handle;
+    io_op->affinity = std::this_thread::get_id();
     io_op->io_object->engine_->submit(io_op);
   }
 
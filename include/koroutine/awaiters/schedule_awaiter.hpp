@@ -15,7 +15,7 @@ class AbstractScheduler;
 /**
  * @brief 调度延迟 awaiter
  *
- * 用于实现 co_await scheduler->schedule(delay_ms) 语法。
+ * 用于实现 co_await scheduler->schedule(delay) 语法。
  * 允许协程在指定的调度器上延迟恢复。
  */
 class ScheduleAwaiter {
@@ -23,12 +23,11 @@ class ScheduleAwaiter {
   /**
    * @brief 构造调度awaiter
    * @param scheduler 目标调度器
-   * @param delay_ms 延迟时间（毫秒）
+   * @param delay 延迟时间
    */
-  ScheduleAwaiter(std::shared_ptr<AbstractScheduler> scheduler,
-                  long long delay_ms)
-      : scheduler_(std::move(scheduler)), delay_ms_(delay_ms) {
-    LOG_TRACE("ScheduleAwaiter::constructor - delay_ms: ", delay_ms_);
+  ScheduleAwaiter(AbstractScheduler* scheduler, std::chrono::nanoseconds delay)
+      : scheduler_(scheduler), delay_(delay) {
+    LOG_TRACE("ScheduleAwaiter::constructor - delay_ns: ", delay_.count());
   }
 
   /**
@@ -36,7 +35,7 @@ class ScheduleAwaiter {
    * @return 如果延迟为0则返回true
    */
   bool await_ready() const noexcept {
-    bool ready = (delay_ms_ == 0);
+    bool ready = (delay_ <= std::chrono::nanoseconds::zero());
     LOG_TRACE("ScheduleAwaiter::await_ready - ready: ", ready);
     return ready;
   }
@@ -46,12 +45,12 @@ class ScheduleAwaiter {
    * @param handle 当前协程句柄
    */
   void await_suspend(std::coroutine_handle<> handle) {
-    LOG_TRACE("ScheduleAwaiter::await_suspend - scheduling with delay: ",
-              delay_ms_);
+    LOG_TRACE("ScheduleAwaiter::await_suspend - scheduling with delay_ns: ",
+              delay_.count());
     if (scheduler_) {
       ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
                             "schedule_awaiter");
-      scheduler_->schedule(ScheduleRequest(handle, std::move(meta)), delay_ms_);
+      scheduler_->schedule(ScheduleRequest(handle, std::move(meta)), delay_);
     } else {
       LOG_ERROR("ScheduleAwaiter::await_suspend - null scheduler!");
       // Fallback: 立即恢复
@@ -67,8 +66,8 @@ class ScheduleAwaiter {
   }
 
  private:
-  std::shared_ptr<AbstractScheduler> scheduler_;
-  long long delay_ms_;
+  AbstractScheduler* scheduler_;
+  std::chrono::nanoseconds delay_;
 };
 
 /**
@@ -82,9 +81,12 @@ class DispatchAwaiter {
   /**
    * @brief 构造调度器切换awaiter
    * @param scheduler 目标调度器
+   * @param priority 恢复请求的优先级
    */
-  explicit DispatchAwaiter(std::shared_ptr<AbstractScheduler> scheduler)
-      : scheduler_(std::move(scheduler)) {
+  explicit DispatchAwaiter(
+      AbstractScheduler* scheduler,
+      ScheduleMetadata::Priority priority = ScheduleMetadata::Priority::Normal)
+      : scheduler_(scheduler), priority_(priority) {
     LOG_TRACE("DispatchAwaiter::constructor");
   }
 
@@ -103,8 +105,7 @@ class DispatchAwaiter {
   void await_suspend(std::coroutine_handle<> handle) {
     LOG_TRACE("DispatchAwaiter::await_suspend - switching scheduler");
     if (scheduler_) {
-      ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
-                            "dispatch_awaiter");
+      ScheduleMetadata meta(priority_, "dispatch_awaiter");
       scheduler_->schedule(ScheduleRequest(handle, std::move(meta)), 0);
     } else {
       LOG_ERROR(
@@ -121,7 +122,58 @@ class DispatchAwaiter {
   }
 
  private:
-  std::shared_ptr<AbstractScheduler> scheduler_;
+  AbstractScheduler* scheduler_;
+  ScheduleMetadata::Priority priority_;
+};
+
+/**
+ * @brief 准入 awaiter
+ *
+ * 用于实现 co_await scheduler->admit() 语法。调度器有空位时不挂起；
+ * OverflowPolicy::Block 下队列已满时挂起，由调度器在腾出空位后恢复。
+ * co_await 的结果表示是否可以提交新工作。
+ */
+class AdmitAwaiter {
+ public:
+  /**
+   * @brief 构造准入awaiter
+   * @param scheduler 要提交新工作的调度器
+   * @param priority 新工作的优先级
+   */
+  AdmitAwaiter(AbstractScheduler* scheduler,
+               ScheduleMetadata::Priority priority)
+      : scheduler_(scheduler), priority_(priority) {}
+
+  /**
+   * @brief 有空位时不挂起
+   */
+  bool await_ready() {
+    admitted_ = !scheduler_ || scheduler_->has_capacity(priority_);
+    return admitted_;
+  }
+
+  /**
+   * @brief 队列已满：按策略挂起等待，或者不挂起并返回拒绝
+   * @param handle 当前协程句柄
+   */
+  bool await_suspend(std::coroutine_handle<> handle) {
+    // 挂起后由调度器恢复时即视为准入；登记之后不能再访问 this
+    admitted_ = true;
+    if (scheduler_->wait_for_capacity(handle)) return true;
+    // 没有挂起：登记前可能刚好腾出了空位，再看一次
+    admitted_ = scheduler_->has_capacity(priority_);
+    return false;
+  }
+
+  /**
+   * @brief 是否可以提交新工作
+   */
+  bool await_resume() const noexcept { return admitted_; }
+
+ private:
+  AbstractScheduler* scheduler_;
+  ScheduleMetadata::Priority priority_;
+  bool admitted_ = false;
 };
 
 }  // namespace koroutine
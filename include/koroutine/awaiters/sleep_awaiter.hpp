@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 #include "../coroutine_common.h"
 #include "../schedulers/scheduler.h"
 #include "../schedulers/timer_scheduler.hpp"
@@ -7,25 +10,35 @@
 
 namespace koroutine {
 struct SleepAwaiter : public AwaiterBase<void> {
-  explicit SleepAwaiter(long long duration) noexcept : _duration(duration) {}
+  using Clock = AbstractScheduler::Clock;
+
+  // 毫秒
+  explicit SleepAwaiter(long long duration) noexcept
+      : _duration(details::delay_from_ms(duration)) {}
 
+  // 任意精度的时长，不足 1 毫秒的部分不再被截断
   template <typename _Rep, typename _Period>
-  explicit SleepAwaiter(
-      std::chrono::duration<_Rep, _Period>&& duration) noexcept
-      : _duration(
-            std::chrono::duration_cast<std::chrono::milliseconds>(duration)
-                .count()) {}
+  explicit SleepAwaiter(std::chrono::duration<_Rep, _Period> duration) noexcept
+      : _duration(std::chrono::ceil<std::chrono::nanoseconds>(duration)) {}
+
+  // 睡眠到指定的截止时间
+  explicit SleepAwaiter(Clock::time_point deadline) noexcept
+      : _deadline(deadline) {}
 
  protected:
   void after_suspend() override {
     if (_scheduler) {
       LOG_TRACE("SleepAwaiter::after_suspend - scheduling resume after ",
-                _duration, " ms");
+                _duration.count(), " ns");
       // 使用 ScheduleRequest 调度恢复
-      ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
-                            "sleep_awaiter");
-      _scheduler->schedule(ScheduleRequest(_caller_handle, std::move(meta)),
-                           _duration);
+      ScheduleMetadata meta = resume_metadata(
+          ScheduleMetadata::Priority::Normal, "sleep_awaiter");
+      ScheduleRequest request(_caller_handle, std::move(meta));
+      if (_deadline) {
+        _scheduler->schedule_at(std::move(request), *_deadline);
+      } else {
+        _scheduler->schedule(std::move(request), _duration);
+      }
     } else {
       LOG_ERROR(
           "SleepAwaiter::after_suspend - no scheduler bound, cannot sleep!");
@@ -38,7 +51,8 @@ struct SleepAwaiter : public AwaiterBase<void> {
   void before_resume() override { this->_result = Result<void>(); }
 
  private:
-  long long _duration;
+  std::chrono::nanoseconds _duration{0};
+  std::optional<Clock::time_point> _deadline;
 };
 
 }  // namespace koroutine
\ No newline at end of file
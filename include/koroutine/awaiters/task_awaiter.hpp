@@ -37,16 +37,31 @@ struct TaskAwaiter : public AwaiterBase<ResultType> {
     return task_.handle_.done();
   }
 
- protected:
-  void after_suspend() override {
-    LOG_TRACE(
-        "TaskAwaiter::after_suspend - setting continuation and starting task");
-    // 使用新的 continuation 机制
-    // 当 task 完成时，会通过调度器自动恢复我们的协程
-    task_.handle_.promise().set_continuation(this->_caller_handle);
+  /**
+   * @brief 挂起调用者并启动子任务
+   *
+   * 子任务的调度器就运行在当前线程上时，直接对称转移进子任务，
+   * 省去一次入队和跨线程唤醒；否则照常通过调度器启动。
+   * 对称转移不经过调度队列，因此会消耗协作预算，预算用完时改为入队启动。
+   */
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller_handle) {
+    this->_caller_handle = caller_handle;
+    auto& promise = task_.handle_.promise();
+    // 当 task 完成时，会恢复我们的协程（见 FinalAwaiter）
+    promise.set_continuation(caller_handle);
+    auto* scheduler = promise.get_scheduler();
+    if (scheduler && scheduler->owns_current_thread() &&
+        !promise.is_started() && details::CoopBudget::consume()) {
+      LOG_TRACE("TaskAwaiter::await_suspend - transferring to child task");
+      promise.set_started();
+      return task_.handle_;
+    }
+    LOG_TRACE("TaskAwaiter::await_suspend - scheduling child task");
     task_.start();
+    return std::noop_coroutine();
   }
 
+ protected:
   void before_resume() override {
     LOG_TRACE("TaskAwaiter::before_resume - retrieving result from task");
     // 直接调用 task_.get_result()，它会从 Promise 获取并移动 Result
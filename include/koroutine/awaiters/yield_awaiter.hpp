@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../coroutine_common.h"
+#include "awaiter.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief 主动让出当前工作线程
+ *
+ * 总是挂起，并把当前协程重新排到所属调度器队列的末尾，
+ * 让同一工作线程上排队的其他协程先运行。
+ */
+struct YieldAwaiter : public AwaiterBase<void> {
+ protected:
+  void after_suspend() override { resume(); }
+};
+
+}  // namespace koroutine
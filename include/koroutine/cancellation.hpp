@@ -1,11 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
-#include <mutex>
-#include <vector>
+#include <thread>
+#include <utility>
 
 #include "debug.h"
 
@@ -23,6 +24,207 @@ class OperationCancelledException : public std::exception {
   }
 };
 
+class CancellationToken;
+
+namespace details {
+
+struct CancellationAccess;
+
+/**
+ * @brief 侵入式取消回调节点
+ *
+ * 由注册方分配（栈上，或作为基类嵌入到关心取消的对象中），
+ * 注册与注销只改几个指针，不分配内存。
+ * invoke 的第二个参数为 false 表示节点被 reset() 丢弃，而不是令牌被取消。
+ */
+struct CancellationNode {
+  void (*invoke)(CancellationNode*, bool cancelled) = nullptr;
+  CancellationNode* prev = nullptr;
+  CancellationNode* next = nullptr;
+};
+
+/**
+ * @brief 令牌共享的取消状态
+ *
+ * 这是自旋锁设计，不是无锁链表：取消标志和一个锁位放在同一个原子字里，
+ * is_cancelled() 只读这一个字；回调链表的 O(1) 插入/摘除由锁位保护，
+ * 临界区只有几次指针赋值，争用时先自旋，超过 64 次后让出 CPU，不使用
+ * mutex。注销一个正在别的线程上执行的回调时，在 executing_ 上用
+ * atomic::wait 阻塞，而不是持续自旋。引用计数是侵入式的，令牌只占一个指针。
+ */
+class CancellationState {
+ public:
+  void add_ref() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  bool is_cancelled() const noexcept {
+    return flags_.load(std::memory_order_acquire) & kCancelled;
+  }
+
+  /**
+   * @brief 注册回调节点
+   * @return false 表示已经取消，节点没有注册，由调用者自己执行回调
+   */
+  bool add(CancellationNode* node) noexcept {
+    if (!lock(true)) return false;
+    node->prev = tail_;
+    node->next = nullptr;
+    if (tail_) {
+      tail_->next = node;
+    } else {
+      head_ = node;
+    }
+    tail_ = node;
+    unlock();
+    return true;
+  }
+
+  /**
+   * @brief 注销回调节点，O(1)
+   *
+   * 返回后回调不会再被调用，节点可以销毁：回调正在另一个线程上执行时
+   * 等它返回；在回调内部注销自己时直接返回。
+   */
+  void remove(CancellationNode* node) noexcept {
+    lock(false);
+    if (node->prev || head_ == node) {
+      unlink(node);
+      unlock();
+      return;
+    }
+    bool running_elsewhere =
+        executing_.load(std::memory_order_relaxed) == node &&
+        signaller_ != std::this_thread::get_id();
+    unlock();
+    // 阻塞到 cancel() 执行完这个回调、把 executing_ 换掉为止
+    if (running_elsewhere) executing_.wait(node, std::memory_order_acquire);
+  }
+
+  /**
+   * @brief 标记为已取消并按注册顺序执行回调
+   * @return false 表示之前已经取消过
+   *
+   * 执行回调时不持有锁位，回调里可以注册或注销其他节点。
+   */
+  bool cancel() {
+    if (!lock_and_cancel()) return false;
+    signaller_ = std::this_thread::get_id();
+    while (CancellationNode* node = head_) {
+      unlink(node);
+      executing_.store(node, std::memory_order_relaxed);
+      unlock();
+      try {
+        node->invoke(node, true);
+      } catch (const std::exception& e) {
+        LOG_ERROR("CancellationToken::cancel - exception in callback: ",
+                  e.what());
+      } catch (...) {
+        LOG_ERROR("CancellationToken::cancel - unknown exception in callback");
+      }
+      lock(false);
+      executing_.store(nullptr, std::memory_order_release);
+      executing_.notify_all();
+    }
+    unlock();
+    return true;
+  }
+
+  /**
+   * @brief 清除取消标志并丢弃所有已注册的回调
+   */
+  void reset() {
+    lock(false);
+    drop_all_locked();
+    flags_.store(0, std::memory_order_release);
+  }
+
+  ~CancellationState() { drop_all_locked(); }
+
+ private:
+  static constexpr uint32_t kCancelled = 1;
+  static constexpr uint32_t kLocked = 2;
+
+  // 获取锁位；stop_if_cancelled 为 true 时发现已取消就放弃并返回 false
+  bool lock(bool stop_if_cancelled) noexcept {
+    uint32_t flags = flags_.load(std::memory_order_relaxed);
+    for (int spins = 0;; ++spins) {
+      if (stop_if_cancelled && (flags & kCancelled)) {
+        // 与 cancel() 中写入回调前的状态同步
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+      }
+      if (!(flags & kLocked) &&
+          flags_.compare_exchange_weak(flags, flags | kLocked,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+      if (flags & kLocked) {
+        if (spins > 64) std::this_thread::yield();
+        flags = flags_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // 同时设置取消标志并获取锁位；已取消时返回 false
+  bool lock_and_cancel() noexcept {
+    uint32_t flags = flags_.load(std::memory_order_relaxed);
+    for (int spins = 0;; ++spins) {
+      if (flags & kCancelled) return false;
+      if (!(flags & kLocked) &&
+          flags_.compare_exchange_weak(flags, kCancelled | kLocked,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+      if (flags & kLocked) {
+        if (spins > 64) std::this_thread::yield();
+        flags = flags_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void unlock() noexcept {
+    flags_.fetch_and(~kLocked, std::memory_order_release);
+  }
+
+  void unlink(CancellationNode* node) noexcept {
+    if (node->prev) {
+      node->prev->next = node->next;
+    } else {
+      head_ = node->next;
+    }
+    if (node->next) {
+      node->next->prev = node->prev;
+    } else {
+      tail_ = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+  }
+
+  // 持有锁位（或独占）时调用；节点被摘下后不再访问
+  void drop_all_locked() noexcept {
+    while (CancellationNode* node = head_) {
+      unlink(node);
+      node->invoke(node, false);
+    }
+  }
+
+  std::atomic<uint32_t> flags_{0};
+  std::atomic<uint32_t> refs_{1};
+  CancellationNode* head_ = nullptr;
+  CancellationNode* tail_ = nullptr;
+  // 正在执行的回调及执行它的线程，remove() 据此决定是否等待
+  std::atomic<CancellationNode*> executing_{nullptr};
+  std::thread::id signaller_;
+};
+
+}  // namespace details
+
 /**
  * @brief 取消令牌
  *
@@ -55,17 +257,34 @@ class CancellationToken {
   /**
    * @brief 构造一个新的取消令牌
    */
-  CancellationToken() : state_(std::make_shared<State>()) {
+  CancellationToken() : state_(new details::CancellationState()) {
     LOG_TRACE("CancellationToken::constructor - created new token");
   }
 
+  CancellationToken(const CancellationToken& other) noexcept
+      : state_(other.state_) {
+    if (state_) state_->add_ref();
+  }
+
+  CancellationToken(CancellationToken&& other) noexcept
+      : state_(std::exchange(other.state_, nullptr)) {}
+
+  CancellationToken& operator=(CancellationToken other) noexcept {
+    std::swap(state_, other.state_);
+    return *this;
+  }
+
+  ~CancellationToken() {
+    if (state_) state_->release();
+  }
+
   /**
    * @brief 检查是否已被取消
    * @return true 如果已取消，false 否则
+   *
+   * 只读取一个原子字，没有请求取消时不会碰到其他共享状态。
    */
-  bool is_cancelled() const {
-    return state_->cancelled.load(std::memory_order_acquire);
-  }
+  bool is_cancelled() const { return state_ && state_->is_cancelled(); }
 
   /**
    * @brief 注册取消回调
@@ -75,57 +294,37 @@ class CancellationToken {
    *
    * @param callback 取消时要调用的函数
    *
-   * 注意：回调可能在任意线程上执行
+   * 注意：回调可能在任意线程上执行。这样注册的回调无法注销，
+   * 会一直保留到令牌被取消或销毁；需要随作用域注销的场景使用
+   * CancellationCallback。
    */
   void on_cancel(std::function<void()> callback) {
-    std::lock_guard lock(state_->mtx);
-
-    if (state_->cancelled.load(std::memory_order_acquire)) {
+    auto* node = new FunctionNode(std::move(callback));
+    if (state_ && state_->add(node)) {
+      LOG_TRACE("CancellationToken::on_cancel - registering callback");
+      return;
+    }
+    if (state_) {
       // 已经取消，立即调用回调
       LOG_TRACE(
           "CancellationToken::on_cancel - already cancelled, invoking callback "
           "immediately");
-      callback();
+      FunctionNode::invoke_node(node, true);
     } else {
-      // 还未取消，注册回调
-      LOG_TRACE("CancellationToken::on_cancel - registering callback");
-      state_->callbacks.push_back(std::move(callback));
+      FunctionNode::invoke_node(node, false);
     }
   }
 
   /**
    * @brief 请求取消
    *
-   * 将令牌标记为已取消，并调用所有注册的回调。
+   * 将令牌标记为已取消，并按注册顺序调用所有回调。
    * 此方法是线程安全的，可以从任意线程调用。
    * 多次调用是安全的（后续调用无效果）。
    */
   void cancel() {
-    std::lock_guard lock(state_->mtx);
-
-    // 使用 exchange 确保只执行一次
-    bool was_cancelled =
-        state_->cancelled.exchange(true, std::memory_order_acq_rel);
-
-    if (!was_cancelled) {
-      LOG_INFO("CancellationToken::cancel - cancelling, invoking ",
-               state_->callbacks.size(), " callbacks");
-
-      // 调用所有回调
-      for (auto& cb : state_->callbacks) {
-        try {
-          cb();
-        } catch (const std::exception& e) {
-          LOG_ERROR("CancellationToken::cancel - exception in callback: ",
-                    e.what());
-        } catch (...) {
-          LOG_ERROR(
-              "CancellationToken::cancel - unknown exception in callback");
-        }
-      }
-
-      // 清空回调列表
-      state_->callbacks.clear();
+    if (state_ && state_->cancel()) {
+      LOG_INFO("CancellationToken::cancel - cancelled");
     } else {
       LOG_TRACE("CancellationToken::cancel - already cancelled, ignoring");
     }
@@ -162,22 +361,86 @@ class CancellationToken {
    *
    * 注意：此方法主要用于测试。在生产代码中重用取消令牌可能导致
    * 难以调试的问题。建议每次操作使用新的令牌。
+   * 已注册的回调全部被丢弃，不会再被调用。
    */
   void reset() {
-    std::lock_guard lock(state_->mtx);
-    state_->cancelled.store(false, std::memory_order_release);
-    state_->callbacks.clear();
+    if (state_) state_->reset();
     LOG_TRACE("CancellationToken::reset - token reset");
   }
 
  private:
-  struct State {
-    std::atomic<bool> cancelled{false};
-    std::mutex mtx;
-    std::vector<std::function<void()>> callbacks;
+  friend struct details::CancellationAccess;
+
+  // on_cancel 注册的回调：堆上分配，执行或被丢弃后删除自己
+  struct FunctionNode : details::CancellationNode {
+    explicit FunctionNode(std::function<void()> fn) : callback(std::move(fn)) {
+      invoke = &FunctionNode::invoke_node;
+    }
+
+    static void invoke_node(details::CancellationNode* node, bool cancelled) {
+      std::unique_ptr<FunctionNode> self(static_cast<FunctionNode*>(node));
+      if (cancelled) self->callback();
+    }
+
+    std::function<void()> callback;
   };
 
-  std::shared_ptr<State> state_;
+  details::CancellationState* state_;
+};
+
+namespace details {
+
+// 供 CancellationCallback 与 TaskPromise 取得令牌的共享状态
+struct CancellationAccess {
+  static CancellationState* state(const CancellationToken& token) noexcept {
+    return token.state_;
+  }
+};
+
+}  // namespace details
+
+/**
+ * @brief 作用域内的取消回调注册
+ *
+ * 节点就是对象本身，可以放在栈上或作为成员：构造时注册，
+ * 析构时以 O(1) 注销，不分配内存。析构返回后回调保证不再运行
+ * （回调正在另一个线程上执行时析构会等它结束）。
+ * 令牌已经取消时，回调在构造函数中立即执行。
+ *
+ * 使用示例:
+ * @code
+ * CancellationCallback on_cancel(token, [&] { socket.close(); });
+ * co_await socket.read(buffer);
+ * @endcode
+ */
+template <typename F>
+class CancellationCallback : private details::CancellationNode {
+ public:
+  CancellationCallback(const CancellationToken& token, F callback)
+      : state_(details::CancellationAccess::state(token)),
+        callback_(std::move(callback)) {
+    invoke = &CancellationCallback::invoke_node;
+    if (!state_) return;
+    state_->add_ref();
+    if (!state_->add(this)) callback_();
+  }
+
+  CancellationCallback(const CancellationCallback&) = delete;
+  CancellationCallback& operator=(const CancellationCallback&) = delete;
+
+  ~CancellationCallback() {
+    if (!state_) return;
+    state_->remove(this);
+    state_->release();
+  }
+
+ private:
+  static void invoke_node(details::CancellationNode* node, bool cancelled) {
+    if (cancelled) static_cast<CancellationCallback*>(node)->callback_();
+  }
+
+  details::CancellationState* state_;
+  F callback_;
 };
 
 /**
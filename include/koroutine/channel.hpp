@@ -20,6 +20,53 @@ struct Channel {
     }
   }
 
+  // 缓冲区有数据或有等待中的写者时，读者直接拿到值而不挂起
+  bool try_read_inline(ReaderAwaiter<ValueType>* reader_awaiter) {
+    std::unique_lock lock(channel_lock);
+    if (!is_active()) return false;  // 交给挂起路径抛出关闭异常
+
+    WriterAwaiter<ValueType>* writer = nullptr;
+    if (!buffer.empty()) {
+      reader_awaiter->_result = Result<ValueType>(std::move(buffer.front()));
+      buffer.pop();
+      if (!writer_list.empty()) {
+        writer = writer_list.front();
+        writer_list.pop_front();
+        buffer.push(writer->_value);
+      }
+    } else if (!writer_list.empty()) {
+      writer = writer_list.front();
+      writer_list.pop_front();
+      reader_awaiter->_result = Result<ValueType>(ValueType(writer->_value));
+    } else {
+      return false;
+    }
+    lock.unlock();
+
+    if (writer) writer->resume();
+    return true;
+  }
+
+  // 有等待中的读者或缓冲区未满时，写者直接完成而不挂起
+  bool try_write_inline(WriterAwaiter<ValueType>* writer_awaiter) {
+    std::unique_lock lock(channel_lock);
+    if (!is_active()) return false;
+
+    if (!reader_list.empty()) {
+      auto reader = reader_list.front();
+      reader_list.pop_front();
+      lock.unlock();
+
+      reader->resume(writer_awaiter->_value);
+    } else if (buffer.size() < static_cast<size_t>(buffer_capacity)) {
+      buffer.push(writer_awaiter->_value);
+    } else {
+      return false;
+    }
+    writer_awaiter->_result = Result<void>();
+    return true;
+  }
+
   void try_push_reader(ReaderAwaiter<ValueType>* reader_awaiter) {
     std::unique_lock lock(channel_lock);
     check_closed();
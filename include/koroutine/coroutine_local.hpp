@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "debug.h"
+
+namespace koroutine {
+
+template <typename T>
+class CoroutineLocal;
+
+namespace details {
+
+/**
+ * @brief 协程本地存储的共享上下文
+ *
+ * 固定大小的槽位数组，每个 CoroutineLocal 键在构造时分到一个全局唯一的
+ * 槽位下标，读写都是下标访问，不做哈希查找。promise 只保存一个指针。
+ *
+ * 父任务 co_await 子任务时，子任务共享父任务的上下文（只加一次引用计数）。
+ * 上下文被共享时不会被修改：写入方先复制一份再写（写时复制），
+ * 因此子任务写入的值不会影响父任务，反之亦然。
+ *
+ * 任务的截止时间（Task::with_deadline）也放在这里，和其他值一起被子任务继承。
+ */
+class LocalContext {
+ public:
+  using Clock = std::chrono::steady_clock;
+  static constexpr std::size_t kMaxSlots = 16;
+
+  struct Slot {
+    void* value = nullptr;
+    void (*destroy)(void*) = nullptr;
+    void* (*clone)(const void*) = nullptr;
+  };
+
+  LocalContext() = default;
+  LocalContext(const LocalContext&) = delete;
+  LocalContext& operator=(const LocalContext&) = delete;
+
+  ~LocalContext() {
+    for (auto& slot : slots_) {
+      if (slot.value) slot.destroy(slot.value);
+    }
+  }
+
+  void add_ref() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  const void* get(std::size_t index) const noexcept {
+    return slots_[index].value;
+  }
+
+  // 截止时间，Clock::time_point::max() 表示没有
+  Clock::time_point deadline() const noexcept { return deadline_; }
+  void set_deadline(Clock::time_point deadline) noexcept {
+    deadline_ = deadline;
+  }
+
+  /**
+   * @brief 返回可以写入的上下文
+   * @param context 当前上下文，可以为空；返回后由返回值取代它
+   *
+   * 没有上下文时新建一个；上下文被其他任务共享时复制一份并释放原来的引用。
+   */
+  static LocalContext* writable(LocalContext* context) {
+    if (!context) return new LocalContext();
+    if (context->refs_.load(std::memory_order_acquire) == 1) return context;
+    auto* copy = new LocalContext();
+    copy->deadline_ = context->deadline_;
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+      const Slot& slot = context->slots_[i];
+      if (slot.value) copy->slots_[i] = {slot.clone(slot.value), slot.destroy,
+                                         slot.clone};
+    }
+    context->release();
+    return copy;
+  }
+
+  /**
+   * @brief 以父任务的上下文为底，合并子任务启动前已有的上下文
+   * @param own 子任务自己的上下文；返回后由返回值取代它
+   *
+   * 子任务自己设置过的值优先，截止时间取两者中较早的一个。
+   */
+  static LocalContext* merge(const LocalContext& parent, LocalContext* own) {
+    own = writable(own);
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+      const Slot& slot = parent.slots_[i];
+      if (slot.value && !own->slots_[i].value) {
+        own->slots_[i] = {slot.clone(slot.value), slot.destroy, slot.clone};
+      }
+    }
+    if (parent.deadline_ < own->deadline_) own->deadline_ = parent.deadline_;
+    return own;
+  }
+
+  template <typename T>
+  void set(std::size_t index, T&& value) {
+    using V = std::decay_t<T>;
+    Slot& slot = slots_[index];
+    if (slot.value) {
+      *static_cast<V*>(slot.value) = std::forward<T>(value);
+      return;
+    }
+    slot.value = new V(std::forward<T>(value));
+    slot.destroy = [](void* p) { delete static_cast<V*>(p); };
+    slot.clone = [](const void* p) -> void* {
+      return new V(*static_cast<const V*>(p));
+    };
+  }
+
+  void reset(std::size_t index) noexcept {
+    Slot& slot = slots_[index];
+    if (slot.value) slot.destroy(std::exchange(slot.value, nullptr));
+  }
+
+  // 为新的 CoroutineLocal 键分配槽位
+  static std::size_t allocate_slot() {
+    std::size_t index = next_slot_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kMaxSlots) {
+      LOG_ERROR("CoroutineLocal - out of slots, at most ", kMaxSlots,
+                " keys are supported");
+      throw std::length_error("too many CoroutineLocal keys");
+    }
+    return index;
+  }
+
+ private:
+  std::atomic<std::size_t> refs_{1};
+  std::array<Slot, kMaxSlots> slots_{};
+  Clock::time_point deadline_ = Clock::time_point::max();
+
+  inline static std::atomic<std::size_t> next_slot_{0};
+};
+
+// 已就绪的 awaiter：co_await 不挂起，直接得到结果
+template <typename R>
+struct ReadyValue {
+  R value;
+  bool await_ready() const noexcept { return true; }
+  void await_suspend(std::coroutine_handle<>) const noexcept {}
+  R await_resume() noexcept { return std::move(value); }
+};
+
+// co_await 得到当前协程的上下文（可能为空），用于让不经过 co_await
+// 启动的子任务（如 when_all 的包装任务）继承协程本地变量
+struct CurrentLocals {};
+
+}  // namespace details
+
+/**
+ * @brief 读取协程本地变量的操作，由 TaskPromise::await_transform 处理
+ */
+template <typename T>
+struct LocalGet {
+  const CoroutineLocal<T>& key;
+};
+
+/**
+ * @brief 写入（value 为空时清除）协程本地变量的操作
+ */
+template <typename T>
+struct LocalSet {
+  const CoroutineLocal<T>& key;
+  std::optional<T> value;
+};
+
+/**
+ * @brief 协程本地变量的键
+ *
+ * 键在构造时分到一个固定槽位，通常定义为全局或静态对象，最多
+ * LocalContext::kMaxSlots 个。值跟随逻辑任务：跨越 co_await 和线程切换
+ * 都不会丢失，被 co_await 的子任务自动继承父任务的值。
+ *
+ * 使用示例：
+ * @code
+ * inline const CoroutineLocal<std::string> trace_id;
+ *
+ * Task<void> handle(Request req) {
+ *   co_await trace_id.set(req.header("X-Trace-Id"));
+ *   co_await query_db();  // query_db 里 co_await trace_id.get() 能读到它
+ * }
+ * @endcode
+ */
+template <typename T>
+class CoroutineLocal {
+ public:
+  CoroutineLocal() : index_(details::LocalContext::allocate_slot()) {}
+  CoroutineLocal(const CoroutineLocal&) = delete;
+  CoroutineLocal& operator=(const CoroutineLocal&) = delete;
+
+  /**
+   * @brief co_await 得到指向当前值的指针，未设置时为 nullptr
+   *
+   * 指针在本协程下一次写入该变量之前有效。
+   */
+  LocalGet<T> get() const { return {*this}; }
+
+  // co_await 后当前协程（及其之后 co_await 的子任务）看到新值
+  LocalSet<T> set(T value) const { return {*this, std::move(value)}; }
+
+  // co_await 后当前协程中该变量变为未设置
+  LocalSet<T> reset() const { return {*this, std::nullopt}; }
+
+  std::size_t index() const { return index_; }
+
+ private:
+  std::size_t index_;
+};
+
+}  // namespace koroutine
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <variant>
+
+#include "executors/current_thread_executor.h"
+#include "runtime.hpp"
+#include "scheduler_manager.h"
+#include "schedulers/SimpleScheduler.h"
+#include "task.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief current_thread 运行时：把调用线程变成事件循环，不使用任何线程池线程
+ *
+ * 存活期间，本线程新建的协程默认属于这个循环；block_on 在调用线程上执行
+ * 根任务、它 co_await 的子任务、spawn 出的任务，以及定时器到期和 IO 完成后
+ * 的恢复，直到根任务结束，全程没有跨线程交接。其它线程（定时器、IO 引擎、
+ * spawn_blocking 的线程池）只负责把要恢复的协程投递回这个循环。
+ *
+ * 适合命令行工具和测试。block_on 不能在本运行时的协程内部调用；
+ * 根任务结束时仍在排队的任务留到下一次 block_on，随运行时析构丢弃。
+ * 协程在创建时确定默认调度器，在运行时之前创建的任务会初始化全局默认
+ * 调度器（及其线程池）；要完全不启动线程池，先构造运行时再创建任务，
+ * 或直接使用 ASYNC_MAIN_CURRENT_THREAD()。
+ *
+ * 使用示例：
+ * @code
+ * CurrentThreadRuntime runtime;
+ * int answer = runtime.block_on(compute());
+ * @endcode
+ */
+class CurrentThreadRuntime {
+ public:
+  CurrentThreadRuntime()
+      : executor_(std::make_shared<CurrentThreadExecutor>()),
+        scheduler_(std::make_shared<SimpleScheduler>(executor_)),
+        previous_(SchedulerManager::get_thread_default_scheduler()) {
+    SchedulerManager::set_thread_default_scheduler(scheduler_);
+  }
+
+  ~CurrentThreadRuntime() {
+    SchedulerManager::set_thread_default_scheduler(std::move(previous_));
+  }
+
+  CurrentThreadRuntime(const CurrentThreadRuntime&) = delete;
+  CurrentThreadRuntime& operator=(const CurrentThreadRuntime&) = delete;
+
+  std::shared_ptr<AbstractScheduler> scheduler() const { return scheduler_; }
+
+  /**
+   * @brief 在调用线程上运行任务，直到它完成并返回结果或重新抛出异常
+   */
+  template <typename ResultType>
+  ResultType block_on(Task<ResultType>&& task) {
+    // 任务可能在运行时创建之前就已构造，统一改到本循环上
+    task.handle_.promise().set_scheduler(scheduler_.get());
+    std::optional<Slot<ResultType>> result;
+    std::exception_ptr exception_ptr;
+
+    auto wrapper_task = capture(std::move(task), result, exception_ptr);
+    wrapper_task.handle.promise().loop = executor_.get();
+    ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
+                          "current_thread_block_on");
+    scheduler_->schedule(ScheduleRequest(wrapper_task.handle, std::move(meta)),
+                         0);
+
+    LOG_TRACE("CurrentThreadRuntime::block_on - driving loop on caller");
+    executor_->run();
+    wrapper_task.handle.destroy();
+
+    if (exception_ptr) std::rethrow_exception(exception_ptr);
+    if constexpr (!std::is_void_v<ResultType>) {
+      return std::move(*result);
+    }
+  }
+
+  /**
+   * @brief 把任务放到本循环上并分离，在 block_on 期间运行
+   */
+  template <typename T>
+  void spawn(Task<T>&& task) {
+    task.handle_.promise().set_scheduler(scheduler_.get());
+    task.start_detached();
+  }
+
+ private:
+  template <typename ResultType>
+  using Slot = std::conditional_t<std::is_void_v<ResultType>, std::monostate,
+                                  ResultType>;
+
+  template <typename ResultType>
+  static Runtime::BlockOnTask capture(
+      Task<ResultType> task, std::optional<Slot<ResultType>>& result,
+      std::exception_ptr& exception_ptr) {
+    try {
+      if constexpr (std::is_void_v<ResultType>) {
+        co_await std::move(task);
+        result.emplace();
+      } else {
+        result.emplace(co_await std::move(task));
+      }
+    } catch (...) {
+      exception_ptr = std::current_exception();
+    }
+  }
+
+  std::shared_ptr<CurrentThreadExecutor> executor_;
+  std::shared_ptr<SimpleScheduler> scheduler_;
+  std::shared_ptr<AbstractScheduler> previous_;
+};
+
+namespace Runtime {
+
+/**
+ * @brief 在调用线程上运行任务直到完成，不经过线程池
+ * @see CurrentThreadRuntime
+ */
+template <typename ResultType>
+ResultType block_on_current_thread(Task<ResultType>&& task) {
+  CurrentThreadRuntime runtime;
+  return runtime.block_on(std::move(task));
+}
+
+}  // namespace Runtime
+
+/**
+ * @brief 在 main 线程上运行的 async_main：先构造 CurrentThreadRuntime
+ * 再创建主协程，整个程序不启动线程池线程
+ * 用法: ASYNC_MAIN_CURRENT_THREAD() { co_return 0; }
+ */
+#define ASYNC_MAIN_CURRENT_THREAD()                                  \
+  Task<int> async_main_impl();                                       \
+  int main() {                                                       \
+    try {                                                            \
+      koroutine::CurrentThreadRuntime runtime;                       \
+      return runtime.block_on(async_main_impl());                    \
+    } catch (const std::exception& e) {                              \
+      std::cerr << "Unhandled exception: " << e.what() << std::endl; \
+      return 1;                                                      \
+    }                                                                \
+  }                                                                  \
+  Task<int> async_main_impl()
+
+}  // namespace koroutine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace koroutine::details {
+
+/**
+ * @brief Cooperative scheduling budget of the running coroutine.
+ *
+ * Awaits that complete without suspending (buffered channel reads,
+ * uncontended locks, child tasks entered by symmetric transfer) never give
+ * the worker back to its executor, so a coroutine looping over them can
+ * starve everything queued behind it. Each such await spends one unit of
+ * the budget; once it is exhausted the await suspends anyway and the
+ * coroutine is rescheduled at the back of the queue.
+ *
+ * The counter is thread_local, but it is refilled every time an executor
+ * starts a work item (Runnable::operator(), WorkStealingExecutor's worker
+ * loop). It therefore belongs to the coroutine the worker just took from its
+ * queue, together with whatever it runs inline, and is never charged to the
+ * coroutine that runs after it.
+ */
+class CoopBudget {
+ public:
+  static constexpr uint32_t kDefaultBudget = 128;
+
+  /**
+   * @brief Set the number of consecutive ready awaits allowed before a
+   * forced yield, for all threads. 0 disables forced yields.
+   */
+  static void set_budget(uint32_t budget) noexcept {
+    configured_.store(budget, std::memory_order_relaxed);
+  }
+
+  static uint32_t budget() noexcept {
+    return configured_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Spend one unit for a ready await.
+   * @return false when the caller should yield instead of continuing.
+   */
+  static bool consume() noexcept {
+    uint32_t limit = budget();
+    if (limit == 0) return true;
+    if (++spent_ < limit) return true;
+    spent_ = 0;
+    return false;
+  }
+
+  /**
+   * @brief Refill the budget; called by executors before each work item.
+   */
+  static void reset() noexcept { spent_ = 0; }
+
+ private:
+  static inline std::atomic<uint32_t> configured_{kDefaultBudget};
+  static inline thread_local uint32_t spent_ = 0;
+};
+
+}  // namespace koroutine::details
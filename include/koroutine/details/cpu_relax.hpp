@@ -0,0 +1,25 @@
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace koroutine::details {
+
+/**
+ * @brief Spin-wait hint for the CPU (x86 `pause`, ARM `yield`).
+ *
+ * Lets the sibling hyper-thread run and avoids the memory-order
+ * mis-speculation penalty when a spinning loop finally sees its flag flip.
+ */
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+}  // namespace koroutine::details
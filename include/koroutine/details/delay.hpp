@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include "timer_wheel.hpp"
+
+namespace koroutine::details {
+
+// Longest delay the timer wheel can represent at one tick per microsecond
+// (about nine years). Longer delays are clamped to it.
+inline constexpr std::chrono::nanoseconds kMaxDelay =
+    std::chrono::microseconds(TimerWheel::kMaxSpan - 1);
+
+/**
+ * @brief Clamp a delay to [0, kMaxDelay] so adding it to a time point
+ * cannot overflow.
+ */
+inline std::chrono::nanoseconds clamp_delay(std::chrono::nanoseconds delay) {
+  return std::clamp(delay, std::chrono::nanoseconds::zero(), kMaxDelay);
+}
+
+/**
+ * @brief Convert a legacy millisecond delay, clamping before the
+ * conversion so huge values cannot overflow nanoseconds.
+ */
+inline std::chrono::nanoseconds delay_from_ms(long long ms) {
+  constexpr long long kMaxMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(kMaxDelay).count();
+  return std::chrono::milliseconds(std::clamp(ms, 0LL, kMaxMs));
+}
+
+}  // namespace koroutine::details
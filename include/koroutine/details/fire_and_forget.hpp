@@ -28,7 +28,7 @@ struct FireAndForget {
     auto await_transform(Task<T>&& task) {
       auto awaiter = TaskAwaiter<T>(std::move(task));
       // FireAndForget 协程通常没有绑定的调度器，使用默认调度器
-      awaiter.install_scheduler(SchedulerManager::get_default_scheduler());
+      awaiter.install_scheduler(SchedulerManager::current_scheduler());
       return awaiter;
     }
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace koroutine::details {
+
+/**
+ * @brief Thread-local size-class cache for coroutine frames.
+ *
+ * Frames are rounded up to a multiple of kGranularity and served from a
+ * per-thread free list for that size class, so spawning and completing a
+ * task touches no shared allocator state once the cache is warm. Blocks
+ * come from the global operator new one at a time, which lets a frame
+ * freed on a different thread than the one that allocated it simply join
+ * the freeing thread's cache. Each list holds at most kMaxCached blocks;
+ * surplus blocks, frames larger than kMaxSize and frames released while a
+ * thread is exiting go straight back to the global allocator.
+ *
+ * Define KOROUTINE_NO_FRAME_POOL to make TaskPromise use the global
+ * operator new/delete instead.
+ */
+class FrameAllocator {
+ public:
+  static constexpr std::size_t kGranularity = 64;
+  static constexpr std::size_t kMaxSize = 2048;
+  static constexpr std::size_t kClasses = kMaxSize / kGranularity;
+  static constexpr std::uint32_t kMaxCached = 256;
+
+  static void* allocate(std::size_t size) {
+    if (size == 0 || size > kMaxSize) return ::operator new(size);
+    std::size_t index = class_of(size);
+    // Even without a cache the block gets its full size class: it may be
+    // freed into another thread's cache and handed out from there.
+    if (cache_state == CacheState::Dead) {
+      return ::operator new(class_size(index));
+    }
+    if (FreeBlock* block = cache.heads[index]) {
+      cache.heads[index] = block->next;
+      --cache.counts[index];
+      return block;
+    }
+    return ::operator new(class_size(index));
+  }
+
+  static void deallocate(void* ptr, std::size_t size) noexcept {
+    if (ptr == nullptr) return;
+    if (size == 0 || size > kMaxSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    std::size_t index = class_of(size);
+    if (cache_state == CacheState::Dead || cache.counts[index] >= kMaxCached) {
+      ::operator delete(ptr);
+      return;
+    }
+    if (cache_state == CacheState::Unused) {
+      // Registers the cleanup that returns the cached blocks at thread exit.
+      thread_local Drainer drainer;
+      cache_state = CacheState::Active;
+    }
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = cache.heads[index];
+    cache.heads[index] = block;
+    ++cache.counts[index];
+  }
+
+  /**
+   * @brief Number of blocks cached by the calling thread.
+   */
+  static std::size_t cached() noexcept {
+    std::size_t total = 0;
+    for (auto count : cache.counts) total += count;
+    return total;
+  }
+
+  /**
+   * @brief Return every block cached by the calling thread to the global
+   * allocator.
+   */
+  static void release_cached() noexcept {
+    for (std::size_t i = 0; i < kClasses; ++i) {
+      while (FreeBlock* block = cache.heads[i]) {
+        cache.heads[i] = block->next;
+        ::operator delete(block);
+      }
+      cache.counts[i] = 0;
+    }
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Trivially destructible, so it stays usable while other thread_local
+  // objects (which may still own coroutine frames) are being destroyed.
+  struct Cache {
+    std::array<FreeBlock*, kClasses> heads;
+    std::array<std::uint32_t, kClasses> counts;
+  };
+
+  enum class CacheState : std::uint8_t { Unused, Active, Dead };
+
+  struct Drainer {
+    ~Drainer() {
+      release_cached();
+      cache_state = CacheState::Dead;
+    }
+  };
+
+  static constexpr std::size_t class_of(std::size_t size) {
+    return (size - 1) / kGranularity;
+  }
+
+  static constexpr std::size_t class_size(std::size_t index) {
+    return (index + 1) * kGranularity;
+  }
+
+  static inline thread_local Cache cache{};
+  static inline thread_local CacheState cache_state = CacheState::Unused;
+};
+
+}  // namespace koroutine::details
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "ring_queue.hpp"
+
+namespace koroutine::details {
+
+/**
+ * @brief Multi-producer single-consumer FIFO queue.
+ *
+ * The fast path is a bounded lock-free ring (Vyukov's sequence-numbered
+ * cells): a producer claims a cell with one CAS on the tail, the consumer
+ * pops without any atomic read-modify-write. When the ring is full, pushes
+ * spill into a mutex-guarded overflow queue; producers keep using the
+ * overflow until the consumer has emptied it, which preserves per-producer
+ * FIFO order. Neither path allocates once the queue reached its
+ * steady-state size.
+ *
+ * push() and size_approx() may be called from any thread; try_pop() and
+ * empty() only from the single consumer.
+ *
+ * @tparam T default-constructible, nothrow-movable element type
+ */
+template <typename T>
+class MpscQueue {
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+ public:
+  explicit MpscQueue(size_t capacity = 1024) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    cells_ = std::make_unique<Cell[]>(cap);
+    mask_ = cap - 1;
+    for (size_t i = 0; i < cap; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void push(T&& value) {
+    if (overflow_size_.load(std::memory_order_relaxed) == 0 &&
+        try_push_ring(value)) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    overflow_.push(std::move(value));
+    overflow_size_.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  /**
+   * @brief Pop the oldest element. Returns false when the queue is empty or
+   * the next element is still being published by its producer.
+   */
+  bool try_pop(T& out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[head & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) == head + 1) {
+      out = std::move(cell.value);
+      cell.sequence.store(head + mask_ + 1, std::memory_order_release);
+      head_.store(head + 1, std::memory_order_relaxed);
+      return true;
+    }
+    // Take from the overflow only once every claimed ring cell is consumed,
+    // otherwise a producer's later overflow push could overtake its earlier
+    // ring push.
+    if (tail_.load(std::memory_order_acquire) != head) return false;
+    if (overflow_size_.load(std::memory_order_acquire) == 0) return false;
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    if (overflow_.empty()) return false;
+    out = overflow_.pop();
+    overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief True when nothing has been pushed that the consumer has not yet
+   * popped, including elements still being published. The loads are
+   * seq_cst so a consumer can store its "parked" flag, call empty(), and
+   * rely on producers that push afterwards seeing the flag.
+   */
+  bool empty() const {
+    return tail_.load(std::memory_order_seq_cst) ==
+               head_.load(std::memory_order_relaxed) &&
+           overflow_size_.load(std::memory_order_seq_cst) == 0;
+  }
+
+  /**
+   * @brief Number of queued elements, for metrics. May be stale by the time
+   * the caller looks at it.
+   */
+  size_t size_approx() const {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    return (tail > head ? tail - head : 0) +
+           overflow_size_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Moves from `value` only on success.
+  bool try_push_ring(T& value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & mask_];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                  static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+
+  alignas(64) std::atomic<size_t> tail_{0};
+  // Written by the consumer only; atomic so size_approx() can read it.
+  alignas(64) std::atomic<size_t> head_{0};
+
+  alignas(64) std::atomic<size_t> overflow_size_{0};
+  std::mutex overflow_mutex_;
+  RingQueue<T> overflow_;
+};
+
+}  // namespace koroutine::details
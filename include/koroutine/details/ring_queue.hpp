@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace koroutine::details {
+
+/**
+ * @brief Growable FIFO ring buffer.
+ *
+ * Unlike std::queue (backed by std::deque), popping never frees storage and
+ * pushing only allocates when the ring has to grow, so a queue that reached
+ * its steady-state size performs no allocations at all. Not thread-safe.
+ *
+ * @tparam T default-constructible, nothrow-movable element type
+ */
+template <typename T>
+class RingQueue {
+ public:
+  explicit RingQueue(size_t capacity = 64) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    slots_ = std::make_unique<T[]>(cap);
+    mask_ = cap - 1;
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  void push(T&& value) {
+    if (size_ == mask_ + 1) grow();
+    slots_[(head_ + size_) & mask_] = std::move(value);
+    ++size_;
+  }
+
+  T& front() { return slots_[head_]; }
+
+  T pop() {
+    T value = std::move(slots_[head_]);
+    head_ = (head_ + 1) & mask_;
+    --size_;
+    return value;
+  }
+
+ private:
+  void grow() {
+    size_t cap = (mask_ + 1) * 2;
+    auto slots = std::make_unique<T[]>(cap);
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(slots_[(head_ + i) & mask_]);
+    }
+    slots_ = std::move(slots);
+    mask_ = cap - 1;
+    head_ = 0;
+  }
+
+  std::unique_ptr<T[]> slots_;
+  size_t mask_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace koroutine::details
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace koroutine::details {
+
+/**
+ * @brief A counter split across cache lines, one shard per group of threads.
+ *
+ * Each thread adds and subtracts on the shard picked for it on first use, so
+ * threads that update the counter at the same time rarely share a cache
+ * line. A unit taken on one thread may be returned on another, so a single
+ * shard can go negative; only the sum is meaningful, and it is exact only
+ * when no thread updates the counter concurrently.
+ */
+class ShardedCounter {
+ public:
+  void add() noexcept { shard().fetch_add(1, std::memory_order_seq_cst); }
+
+  void sub() noexcept { shard().fetch_sub(1, std::memory_order_release); }
+
+  int64_t load() const noexcept {
+    int64_t sum = 0;
+    for (const auto& shard : shards_) {
+      sum += shard.value.load(std::memory_order_seq_cst);
+    }
+    return sum;
+  }
+
+ private:
+  static constexpr size_t kShards = 8;
+
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+
+  std::atomic<int64_t>& shard() noexcept {
+    return shards_[thread_index()].value;
+  }
+
+  static size_t thread_index() noexcept {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index =
+        next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+  }
+
+  std::array<Shard, kShards> shards_;
+};
+
+}  // namespace koroutine::details
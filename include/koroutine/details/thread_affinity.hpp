@@ -0,0 +1,39 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace koroutine::details {
+
+/**
+ * @brief Restrict a thread to the given set of CPUs.
+ *
+ * @param thread native handle of the thread to pin
+ * @param cpus CPU indices; a single entry pins to one core
+ * @return true on success; false if the set is empty or invalid, or the
+ * platform does not support thread affinity
+ */
+inline bool set_thread_affinity(std::thread::native_handle_type thread,
+                                const std::vector<int>& cpus) {
+#ifdef __linux__
+  if (cpus.empty()) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+  (void)thread;
+  (void)cpus;
+  return false;
+#endif
+}
+
+}  // namespace koroutine::details
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "koroutine/executors/runnable.h"
+
+namespace koroutine::details {
+
+/**
+ * @brief Hierarchical timing wheel.
+ *
+ * Eight levels of 64 slots each; a slot on level `l` spans 64^l ticks, so
+ * the wheel covers 2^48 ticks (almost nine years at one tick per
+ * microsecond). Timers are kept in intrusive doubly-linked lists threaded
+ * through a node pool, which makes insert and cancel O(1). Advancing the
+ * wheel jumps straight to the next occupied slot and cascades its timers to
+ * lower levels, so idle periods cost nothing.
+ *
+ * Not thread-safe; see TimerService for the shared, locked instance.
+ */
+class TimerWheel {
+ public:
+  /**
+   * @brief Identifies a scheduled timer. Stays valid (but inert) after the
+   * timer fired or was cancelled, so stale ids are safe to cancel.
+   */
+  struct TimerId {
+    uint32_t index = 0;
+    uint32_t generation = 0;  // 0 is never issued
+
+    explicit operator bool() const noexcept { return generation != 0; }
+    bool operator==(const TimerId&) const = default;
+  };
+
+  static constexpr size_t kLevels = 8;
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlots = size_t{1} << kSlotBits;
+  static constexpr uint64_t kMaxSpan = uint64_t{1} << (kLevels * kSlotBits);
+
+  explicit TimerWheel(uint64_t now_tick = 0) : elapsed_(now_tick) {
+    for (auto& level : slots_) level.fill(kNil);
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /**
+   * @brief Schedule `callback` for `expire_tick`. Ticks in the past fire on
+   * the next advance(); ticks beyond the wheel's span are clamped to it.
+   */
+  TimerId add(uint64_t expire_tick, Runnable&& callback) {
+    expire_tick = std::clamp(expire_tick, elapsed_, elapsed_ + kMaxSpan - 1);
+
+    uint32_t index = allocate();
+    Node& node = nodes_[index];
+    node.expire = expire_tick;
+    node.callback = std::move(callback);
+    link(index);
+    ++size_;
+    return {index, node.generation};
+  }
+
+  /**
+   * @brief Cancel a pending timer. Returns false if it already fired, was
+   * already cancelled, or the id is empty.
+   */
+  bool cancel(TimerId id) {
+    if (!id || id.index >= nodes_.size()) return false;
+    Node& node = nodes_[id.index];
+    if (node.generation != id.generation || !node.linked) return false;
+    unlink(id.index);
+    release(id.index);
+    --size_;
+    return true;
+  }
+
+  /**
+   * @brief Advance the wheel to `now_tick`, moving the callbacks of every
+   * timer due at or before it into `expired`, earliest tick first. Timers
+   * due on the same tick come out in no particular order.
+   */
+  void advance(uint64_t now_tick, std::vector<Runnable>& expired) {
+    while (size_ > 0) {
+      auto [level, slot, deadline] = next_slot();
+      if (deadline > now_tick) break;
+      elapsed_ = deadline;
+
+      uint32_t index = std::exchange(slots_[level][slot], kNil);
+      occupied_[level] &= ~(uint64_t{1} << slot);
+      while (index != kNil) {
+        uint32_t next = nodes_[index].next;
+        nodes_[index].linked = false;
+        if (nodes_[index].expire <= elapsed_) {
+          expired.push_back(std::move(nodes_[index].callback));
+          release(index);
+          --size_;
+        } else {
+          link(index);  // cascade to a lower level
+        }
+        index = next;
+      }
+    }
+    elapsed_ = std::max(elapsed_, now_tick);
+  }
+
+  /**
+   * @brief Earliest tick at which advance() may fire something, or nullopt
+   * when no timer is pending. Timers on upper levels report the start of
+   * their slot, which is never later than their real expiry.
+   */
+  std::optional<uint64_t> next_expiry() const {
+    if (size_ == 0) return std::nullopt;
+    return std::get<2>(next_slot());
+  }
+
+  uint64_t now() const { return elapsed_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Drop every pending timer without running it.
+   */
+  void clear() {
+    for (size_t level = 0; level < kLevels; ++level) {
+      for (auto& head : slots_[level]) {
+        uint32_t index = std::exchange(head, kNil);
+        while (index != kNil) {
+          uint32_t next = nodes_[index].next;
+          nodes_[index].linked = false;
+          release(index);
+          index = next;
+        }
+      }
+      occupied_[level] = 0;
+    }
+    size_ = 0;
+  }
+
+ private:
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+  struct Node {
+    uint64_t expire = 0;
+    uint32_t prev = kNil;
+    uint32_t next = kNil;
+    uint32_t generation = 1;
+    uint8_t level = 0;
+    uint8_t slot = 0;
+    bool linked = false;
+    Runnable callback;
+  };
+
+  // The level of a timer is given by the highest bit in which its expiry
+  // differs from the current tick.
+  size_t level_for(uint64_t expire) const {
+    uint64_t masked = (elapsed_ ^ expire) | (kSlots - 1);
+    size_t significant = 63 - std::countl_zero(masked);
+    return std::min(significant / kSlotBits, kLevels - 1);
+  }
+
+  std::tuple<size_t, size_t, uint64_t> next_slot() const {
+    std::tuple<size_t, size_t, uint64_t> best{0, 0, UINT64_MAX};
+    for (size_t level = 0; level < kLevels; ++level) {
+      uint64_t occupied = occupied_[level];
+      if (occupied == 0) continue;
+      size_t shift = level * kSlotBits;
+      size_t now_slot = (elapsed_ >> shift) & (kSlots - 1);
+      size_t slot =
+          (std::countr_zero(std::rotr(occupied, static_cast<int>(now_slot))) +
+           now_slot) &
+          (kSlots - 1);
+      uint64_t level_range = uint64_t{1} << (shift + kSlotBits);
+      uint64_t level_start = elapsed_ & ~(level_range - 1);
+      uint64_t deadline = level_start + (uint64_t{slot} << shift);
+      if (deadline < elapsed_) deadline += level_range;
+      if (deadline < std::get<2>(best)) best = {level, slot, deadline};
+    }
+    return best;
+  }
+
+  void link(uint32_t index) {
+    Node& node = nodes_[index];
+    size_t level = level_for(node.expire);
+    size_t slot = (node.expire >> (level * kSlotBits)) & (kSlots - 1);
+    uint32_t& head = slots_[level][slot];
+
+    node.level = static_cast<uint8_t>(level);
+    node.slot = static_cast<uint8_t>(slot);
+    node.prev = kNil;
+    node.next = head;
+    node.linked = true;
+    if (head != kNil) nodes_[head].prev = index;
+    head = index;
+    occupied_[level] |= uint64_t{1} << slot;
+  }
+
+  void unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != kNil) {
+      nodes_[node.prev].next = node.next;
+    } else {
+      slots_[node.level][node.slot] = node.next;
+      if (node.next == kNil) {
+        occupied_[node.level] &= ~(uint64_t{1} << node.slot);
+      }
+    }
+    if (node.next != kNil) nodes_[node.next].prev = node.prev;
+    node.linked = false;
+  }
+
+  uint32_t allocate() {
+    if (free_ != kNil) {
+      return std::exchange(free_, nodes_[free_].next);
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  void release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.callback = Runnable();
+    if (++node.generation == 0) node.generation = 1;
+    node.next = free_;
+    free_ = index;
+  }
+
+  std::vector<Node> nodes_;
+  uint32_t free_ = kNil;
+  std::array<std::array<uint32_t, kSlots>, kLevels> slots_;
+  std::array<uint64_t, kLevels> occupied_{};
+  uint64_t elapsed_;
+  size_t size_ = 0;
+};
+
+}  // namespace koroutine::details
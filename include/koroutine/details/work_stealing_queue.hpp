@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace koroutine::details {
+
+/**
+ * @brief Lock-free work-stealing queue (Chase-Lev layout).
+ *
+ * A single owner thread pushes at the bottom; any thread (the owner
+ * included) takes from the top with a CAS. Taking from the top on the owner
+ * side keeps per-worker execution FIFO, so a coroutine that keeps
+ * re-scheduling itself cannot starve older work queued on the same worker.
+ *
+ * The ring buffer grows on demand. Retired buffers are kept until the queue
+ * is destroyed because concurrent thieves may still be reading them.
+ *
+ * @tparam T trivially copyable element type (typically a pointer)
+ */
+template <typename T>
+class WorkStealingQueue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingQueue requires trivially copyable elements");
+
+  struct Ring {
+    explicit Ring(int64_t cap)
+        : capacity(cap),
+          mask(cap - 1),
+          slots(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(cap))) {
+    }
+
+    void put(int64_t i, T value) {
+      slots[i & mask].store(value, std::memory_order_relaxed);
+    }
+    T get(int64_t i) const {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+
+    Ring* grow(int64_t bottom, int64_t top) const {
+      auto* ring = new Ring(capacity * 2);
+      for (int64_t i = top; i != bottom; ++i) ring->put(i, get(i));
+      return ring;
+    }
+
+    int64_t capacity;
+    int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+ public:
+  explicit WorkStealingQueue(int64_t capacity = 256)
+      : ring_(new Ring(round_up(capacity))) {}
+
+  ~WorkStealingQueue() { delete ring_.load(std::memory_order_relaxed); }
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  /**
+   * @brief Push an element. Must only be called by the owner thread.
+   */
+  void push(T value) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (b - t > ring->capacity - 1) {
+      retired_.emplace_back(ring);
+      ring = ring->grow(b, t);
+      ring_.store(ring, std::memory_order_release);
+    }
+    ring->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Take the oldest element. Safe to call from any thread.
+   * @return std::nullopt if the queue was empty or the race was lost
+   */
+  std::optional<T> steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return std::nullopt;
+
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    T value = ring->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  /**
+   * @brief Approximate number of queued elements.
+   */
+  size_t size() const {
+    int64_t b = bottom_.load(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+ private:
+  static int64_t round_up(int64_t capacity) {
+    int64_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    return cap;
+  }
+
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::atomic<Ring*> ring_;
+  // Only touched by the owner thread (inside push()).
+  std::vector<std::unique_ptr<Ring>> retired_;
+};
+
+}  // namespace koroutine::details
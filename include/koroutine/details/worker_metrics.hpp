@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "koroutine/runtime_metrics.h"
+
+namespace koroutine::details {
+
+inline uint64_t metrics_now_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+// One submission in this many per thread is timestamped for the
+// schedule-to-start latency histogram.
+inline constexpr uint32_t kLatencySampleInterval = 32;
+
+/**
+ * @brief Timestamp to attach to a submission, or 0 when this one is not
+ * sampled. Costs a thread-local increment on the unsampled path.
+ */
+inline uint64_t sample_enqueue_time() {
+  thread_local uint32_t submissions = 0;
+  if (++submissions < kLatencySampleInterval) return 0;
+  submissions = 0;
+  return metrics_now_ns();
+}
+
+/**
+ * @brief Counters owned by a single worker thread.
+ *
+ * Only the owning worker writes, using a relaxed load and store instead of
+ * a read-modify-write, so the run path executes no locked instruction.
+ * Readers on other threads see values that may be slightly stale. The
+ * clock is read only around parking and for sampled submissions.
+ */
+class WorkerMetrics {
+ public:
+  WorkerMetrics() : started_ns_(metrics_now_ns()) {}
+
+  // A work item is about to run; enqueued_ns is its sample timestamp or 0.
+  void on_run(uint64_t enqueued_ns = 0) {
+    bump(executed_);
+    if (enqueued_ns == 0) return;
+    uint64_t now = metrics_now_ns();
+    uint64_t latency = now > enqueued_ns ? now - enqueued_ns : 0;
+    bump(latency_[LatencyHistogram::bucket_for(latency)]);
+    bump(latency_count_);
+    bump(latency_sum_ns_, latency);
+  }
+
+  void park_begin() {
+    parked_since_.store(metrics_now_ns(), std::memory_order_relaxed);
+  }
+
+  void park_end() {
+    uint64_t since = parked_since_.load(std::memory_order_relaxed);
+    if (since == 0) return;
+    bump(idle_ns_, metrics_now_ns() - since);
+    parked_since_.store(0, std::memory_order_relaxed);
+  }
+
+  // The worker thread exits; its totals stay in the aggregate.
+  void retire() { stopped_ns_.store(metrics_now_ns(), std::memory_order_relaxed); }
+
+  void collect(RuntimeMetrics& out, uint64_t now) const {
+    uint64_t stopped = stopped_ns_.load(std::memory_order_relaxed);
+    uint64_t end = stopped != 0 ? stopped : now;
+    uint64_t idle = idle_ns_.load(std::memory_order_relaxed);
+    uint64_t since = parked_since_.load(std::memory_order_relaxed);
+    if (stopped == 0 && since != 0 && end > since) idle += end - since;
+    uint64_t lifetime = end > started_ns_ ? end - started_ns_ : 0;
+    idle = std::min(idle, lifetime);
+
+    if (stopped == 0) ++out.workers;
+    out.executed += executed_.load(std::memory_order_relaxed);
+    out.idle += std::chrono::nanoseconds(idle);
+    out.busy += std::chrono::nanoseconds(lifetime - idle);
+    for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+      out.schedule_latency.buckets[i] +=
+          latency_[i].load(std::memory_order_relaxed);
+    }
+    out.schedule_latency.count +=
+        latency_count_.load(std::memory_order_relaxed);
+    out.schedule_latency.sum_ns +=
+        latency_sum_ns_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  const uint64_t started_ns_;
+  std::atomic<uint64_t> executed_{0};
+  std::atomic<uint64_t> idle_ns_{0};
+  std::atomic<uint64_t> parked_since_{0};
+  std::atomic<uint64_t> stopped_ns_{0};
+  std::atomic<uint64_t> latency_count_{0};
+  std::atomic<uint64_t> latency_sum_ns_{0};
+  std::array<std::atomic<uint64_t>, LatencyHistogram::kBuckets> latency_{};
+};
+
+/**
+ * @brief The WorkerMetrics of one executor, summed on read.
+ *
+ * Workers register once at startup; the returned reference stays valid for
+ * the registry's lifetime.
+ */
+class MetricsRegistry {
+ public:
+  WorkerMetrics& add_worker() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_.push_back(std::make_unique<WorkerMetrics>());
+    return *workers_.back();
+  }
+
+  void collect(RuntimeMetrics& out) const {
+    uint64_t now = metrics_now_ns();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& worker : workers_) worker->collect(out, now);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<WorkerMetrics>> workers_;
+};
+
+}  // namespace koroutine::details
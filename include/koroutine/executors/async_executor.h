@@ -1,5 +1,4 @@
 #pragma once
-#include <chrono>
 #include <future>
 
 #include "../coroutine_common.h"
@@ -7,6 +6,10 @@
 namespace koroutine {
 class AsyncExecutor : public AbstractExecutor {
  public:
+  ~AsyncExecutor() override { cancel_delayed(); }
+
+  using AbstractExecutor::execute;
+
   void execute(std::function<void()>&& func) override {
     LOG_TRACE("AsyncExecutor:: Trying to lock future_lock for execute");
     std::unique_lock lock(future_lock);
@@ -22,26 +25,6 @@ class AsyncExecutor : public AbstractExecutor {
                });
   }
 
-  void execute_delayed(std::function<void()>&& func, long long ms) override {
-    LOG_TRACE(
-        "AsyncExecutor::execute_delayed - Trying to execute after delay: ", ms);
-    std::unique_lock lock(future_lock);
-    LOG_DEBUG("AsyncExecutor::execute_delayed called.", ms);
-    auto id = nextId++;
-    lock.unlock();
-
-    std::async(std::launch::async,
-               [this, func = std::move(func), id, ms]() mutable {
-                 // FIXME: below will block a thread, should just block
-                 // coroutine
-                 if (ms > 0)
-                   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-                 func();
-                 std::unique_lock lock(future_lock);
-                 futures.erase(id);
-               });
-  }
-
  private:
   std::mutex future_lock;
   std::unordered_map<int, std::future<void>> futures;
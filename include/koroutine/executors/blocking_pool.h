@@ -0,0 +1,157 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "executor.h"
+#include "koroutine/debug.h"
+#include "koroutine/details/ring_queue.hpp"
+#include "runnable.h"
+
+namespace koroutine {
+
+/**
+ * @brief Elastic pool for blocking work (getaddrinfo, std::future::get,
+ * file APIs without an async counterpart, ...).
+ *
+ * Features:
+ * - Threads are started on demand when no idle thread is available, up to
+ *   `max_threads`; beyond that work queues until a thread frees up.
+ * - A thread that stays idle for `keep_alive` exits, so a burst of blocking
+ *   calls does not leave hundreds of parked threads behind.
+ * - Steady-state blocking calls reuse parked threads and never create one
+ *   on the request path.
+ *
+ * Coroutines normally reach it through `co_await spawn_blocking(fn)`.
+ */
+class BlockingPool : public AbstractExecutor {
+ public:
+  static constexpr size_t kDefaultMaxThreads = 512;
+  static constexpr std::chrono::milliseconds kDefaultKeepAlive{10'000};
+
+  struct Stats {
+    size_t threads = 0;  // live threads
+    size_t idle = 0;     // threads parked waiting for work
+    size_t queued = 0;   // work items not picked up yet
+    size_t spawned = 0;  // threads started since construction
+  };
+
+  explicit BlockingPool(
+      size_t max_threads = kDefaultMaxThreads,
+      std::chrono::milliseconds keep_alive = kDefaultKeepAlive)
+      : max_threads_(max_threads == 0 ? 1 : max_threads),
+        keep_alive_(keep_alive) {}
+
+  ~BlockingPool() override { shutdown(); }
+
+  /**
+   * @brief The shared pool used by spawn_blocking(), the resolver and
+   * FutureAwaiter.
+   *
+   * Intentionally never destroyed, like TimerService::instance(), so work
+   * submitted during static destruction still has somewhere to run.
+   */
+  static BlockingPool& instance() {
+    static BlockingPool* pool = new BlockingPool();
+    return *pool;
+  }
+
+  using AbstractExecutor::execute;
+
+  void execute(std::function<void()>&& func) override {
+    enqueue(Runnable(std::move(func)));
+  }
+
+  void execute(std::coroutine_handle<> handle) override {
+    enqueue(Runnable(handle));
+  }
+
+  /**
+   * @brief Stop accepting work, let queued work finish and wait for every
+   * thread to exit.
+   */
+  void shutdown() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_) return;
+    stop_ = true;
+    LOG_INFO("BlockingPool: Shutting down with ", threads_, " threads");
+    cancel_delayed();
+    work_cv_.notify_all();
+    exit_cv_.wait(lock, [this] { return threads_ == 0; });
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Stats{threads_, idle_, tasks_.size(), spawned_};
+  }
+
+ private:
+  void enqueue(Runnable&& task) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_) {
+      LOG_WARN("BlockingPool: execute called on stopped pool");
+      return;
+    }
+    tasks_.push(std::move(task));
+    // Enough idle threads for everything queued, including this task.
+    if (idle_ >= tasks_.size()) {
+      lock.unlock();
+      work_cv_.notify_one();
+      return;
+    }
+    if (threads_ < max_threads_) {
+      ++threads_;
+      ++spawned_;
+      lock.unlock();
+      std::thread([this] { worker_loop(); }).detach();
+    }
+  }
+
+  void worker_loop() {
+    bind_current_thread(this);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      if (tasks_.empty() && !stop_) {
+        ++idle_;
+        bool woken = work_cv_.wait_for(lock, keep_alive_, [this] {
+          return stop_ || !tasks_.empty();
+        });
+        --idle_;
+        if (!woken) break;  // idle for keep_alive: let the thread go
+      }
+      if (tasks_.empty()) break;  // stopping and drained
+
+      Runnable task = tasks_.pop();
+      lock.unlock();
+      try {
+        task();
+      } catch (const std::exception& e) {
+        LOG_ERROR("BlockingPool: Task threw exception: ", e.what());
+      } catch (...) {
+        LOG_ERROR("BlockingPool: Task threw unknown exception");
+      }
+      task = Runnable();
+      lock.lock();
+    }
+    bind_current_thread(nullptr);
+    if (--threads_ == 0) exit_cv_.notify_all();
+  }
+
+  const size_t max_threads_;
+  const std::chrono::milliseconds keep_alive_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable exit_cv_;
+  details::RingQueue<Runnable> tasks_;
+  size_t threads_ = 0;
+  size_t idle_ = 0;
+  size_t spawned_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace koroutine
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <span>
+#include <thread>
+
+#include "executor.h"
+#include "koroutine/details/mpsc_queue.hpp"
+#include "runnable.h"
+
+namespace koroutine {
+
+/**
+ * @brief Executor without a thread of its own: the thread that calls run()
+ * becomes its worker until stop() is called.
+ *
+ * Any thread may submit work (timer wheel, IO engine threads, other
+ * executors resuming a coroutine that belongs here); submissions go through
+ * a lock-free MPSC queue and only take the wakeup path while the driving
+ * thread is parked. Work still queued when run() returns stays queued for
+ * the next run() and is dropped with the executor.
+ *
+ * CurrentThreadRuntime uses it to run a task entirely on the calling thread.
+ */
+class CurrentThreadExecutor : public AbstractExecutor {
+ public:
+  CurrentThreadExecutor() = default;
+
+  ~CurrentThreadExecutor() override { cancel_delayed(); }
+
+  using AbstractExecutor::execute;
+
+  void execute(std::function<void()>&& func) override {
+    enqueue(Runnable(std::move(func)));
+  }
+
+  void execute(std::coroutine_handle<> handle) override {
+    enqueue(Runnable(handle));
+  }
+
+  void execute_bulk(
+      std::span<const std::coroutine_handle<>> handles) override {
+    if (!is_active_.load(std::memory_order_relaxed)) {
+      LOG_WARN("CurrentThreadExecutor::execute - executor stopped, dropping");
+      return;
+    }
+    for (auto handle : handles) tasks_.push(Runnable(handle));
+    if (!handles.empty()) wake();
+  }
+
+  void execute_bulk(const std::function<void()>& func,
+                    size_t count) override {
+    if (!is_active_.load(std::memory_order_relaxed)) {
+      LOG_WARN("CurrentThreadExecutor::execute - executor stopped, dropping");
+      return;
+    }
+    for (size_t i = 0; i < count; ++i) tasks_.push(Runnable(func));
+    if (count > 0) wake();
+  }
+
+  // Only the thread currently inside run() can be routed to.
+  bool execute_on(std::thread::id thread,
+                  std::coroutine_handle<> handle) override {
+    if (thread != driver_.load(std::memory_order_acquire)) return false;
+    enqueue(Runnable(handle));
+    return true;
+  }
+
+  /**
+   * @brief Run queued work on the calling thread until stop() is called.
+   *
+   * Parks when the queue is empty. Must not be called by two threads at
+   * once; a nested call from inside a task runs until the next stop().
+   */
+  void run() {
+    const AbstractExecutor* previous = bound_executor();
+    std::thread::id previous_driver = driver_.exchange(
+        std::this_thread::get_id(), std::memory_order_acq_rel);
+    bind_current_thread(this);
+
+    Runnable task;
+    while (true) {
+      while (!stop_.load(std::memory_order_relaxed) && tasks_.try_pop(task)) {
+        task();
+        task = Runnable();
+      }
+      if (stop_.exchange(false, std::memory_order_acquire)) break;
+
+      parked_.store(true, std::memory_order_seq_cst);
+      if (!tasks_.empty() || stop_.load(std::memory_order_seq_cst)) {
+        // A producer is still publishing, or stop() raced with the drain
+        parked_.store(false, std::memory_order_relaxed);
+        std::this_thread::yield();
+        continue;
+      }
+      LOG_TRACE("CurrentThreadExecutor::run - no tasks available, parking");
+      parked_.wait(true, std::memory_order_acquire);
+    }
+
+    bind_current_thread(previous);
+    driver_.store(previous_driver, std::memory_order_release);
+  }
+
+  /**
+   * @brief Make run() return after the task it is running, from any thread.
+   */
+  void stop() {
+    stop_.store(true, std::memory_order_seq_cst);
+    wake();
+  }
+
+  void shutdown() override {
+    LOG_TRACE("CurrentThreadExecutor::shutdown - shutting down executor");
+    cancel_delayed();
+    is_active_.store(false);
+    stop();
+  }
+
+  // Queue depth and pending timers only: the driving thread is borrowed,
+  // so there is no worker whose busy/idle time would mean anything.
+  RuntimeMetrics metrics() const override {
+    RuntimeMetrics out = AbstractExecutor::metrics();
+    out.queued = tasks_.size_approx();
+    return out;
+  }
+
+ private:
+  void enqueue(Runnable&& task) {
+    if (!is_active_.load(std::memory_order_relaxed)) {
+      LOG_WARN("CurrentThreadExecutor::execute - executor stopped, dropping");
+      return;
+    }
+    tasks_.push(std::move(task));
+    wake();
+  }
+
+  void wake() {
+    if (parked_.load(std::memory_order_seq_cst) &&
+        parked_.exchange(false, std::memory_order_seq_cst)) {
+      parked_.notify_one();
+    }
+  }
+
+  details::MpscQueue<Runnable> tasks_;
+  std::atomic<std::thread::id> driver_{};
+  std::atomic<bool> parked_{false};
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> is_active_{true};
+};
+
+}  // namespace koroutine
@@ -1,37 +1,167 @@
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <coroutine>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <thread>
 
 #include "koroutine/debug.h"
+#include "koroutine/details/delay.hpp"
+#include "koroutine/queue_limit.h"
+#include "koroutine/runtime_metrics.h"
+#include "timer_service.h"
 namespace koroutine {
 
 class AbstractExecutor {
  public:
-  virtual ~AbstractExecutor() = default;
+  AbstractExecutor() : delayed_target_(std::make_shared<DelayedTarget>(this)) {}
+  virtual ~AbstractExecutor() { cancel_delayed(); }
 
   // execute immediately / enqueue for execution
   virtual void execute(std::function<void()>&& func) = 0;
 
-  // execute after delay (ms). Default implementation uses a detached thread
-  // to sleep then call execute(). Implementations may override for better
-  // timer integration.
-  virtual void execute_delayed(std::function<void()>&& func, long long ms) {
-    LOG_WARN(
-        "AbstractExecutor::execute_delayed - using default implementation "
-        "with detached thread. Consider overriding for better timer "
-        "integration.");
-    std::thread([this, f = std::move(func), ms]() mutable {
-      if (ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-      this->execute(std::move(f));
-    }).detach();
+  // resume a coroutine. Executors with their own queues override this to
+  // enqueue the handle directly, which keeps the resume path allocation-free.
+  virtual void execute(std::coroutine_handle<> handle) {
+    execute([handle]() { handle.resume(); });
   }
+
+  // resume a batch of coroutines. Executors with a shared queue override
+  // this to enqueue the whole batch under one lock and wake at most one
+  // worker per handle, instead of paying a lock and a notify per handle.
+  virtual void execute_bulk(std::span<const std::coroutine_handle<>> handles) {
+    for (auto handle : handles) execute(handle);
+  }
+
+  // run `func` as `count` separate tasks. Schedulers that keep their own
+  // run queue post one "run the next entry" task per queued coroutine;
+  // executors with a shared queue override this to take the whole batch
+  // under one lock and one round of wake-ups, as execute_bulk() does for
+  // handles.
+  virtual void execute_bulk(const std::function<void()>& func, size_t count) {
+    for (size_t i = 0; i < count; ++i) execute(std::function<void()>(func));
+  }
+
+  // resume a coroutine on a specific thread of this executor. Returns false
+  // (and does nothing) when the executor does not own `thread` or cannot
+  // route work to individual threads; callers then fall back to execute().
+  virtual bool execute_on(std::thread::id thread,
+                          std::coroutine_handle<> handle) {
+    (void)thread;
+    (void)handle;
+    return false;
+  }
+
+  // Admission control for new work (see QueueLimit). Executors without a
+  // bounded queue admit everything.
+  virtual QueueLimit queue_limit() const { return {}; }
+
+  // true when fewer than `max_depth` tasks are queued.
+  virtual bool has_capacity(size_t max_depth) const {
+    (void)max_depth;
+    return true;
+  }
+
+  // enqueue `handle` only if fewer than `max_depth` tasks are queued.
+  // Returns false, leaving the coroutine untouched, when it was refused.
+  virtual bool try_execute(std::coroutine_handle<> handle, size_t max_depth) {
+    (void)max_depth;
+    execute(handle);
+    return true;
+  }
+
+  // Under OverflowPolicy::Block, park `waiter` while the queue is full and
+  // enqueue it once a slot frees up. Returns false, without parking, when
+  // there is room already or the policy does not block.
+  virtual bool wait_for_capacity(std::coroutine_handle<> waiter) {
+    (void)waiter;
+    return false;
+  }
+
+  // execute at `deadline`. The task waits on the shared timer wheel
+  // (microsecond ticks) and is then handed to execute(). Timers still
+  // pending when the executor is destroyed are dropped.
+  virtual void execute_at(std::function<void()>&& func,
+                          TimerService::Clock::time_point deadline) {
+    delayed_target_->pending.fetch_add(1, std::memory_order_relaxed);
+    TimerService::instance().schedule_at(
+        deadline, [target = delayed_target_, func = std::move(func)]() mutable {
+          target->pending.fetch_sub(1, std::memory_order_relaxed);
+          target->execute(std::move(func));
+        });
+  }
+
+  // execute after `delay`.
+  void execute_delayed(std::function<void()>&& func,
+                       std::chrono::nanoseconds delay) {
+    execute_at(std::move(func),
+               TimerService::Clock::now() + details::clamp_delay(delay));
+  }
+
+  // execute after delay (ms).
+  void execute_delayed(std::function<void()>&& func, long long ms) {
+    execute_delayed(std::move(func), details::delay_from_ms(ms));
+  }
+
+  // true when called from one of this executor's own threads. Schedulers use
+  // it to hand control straight to the next coroutine (symmetric transfer)
+  // instead of queueing it.
+  bool owns_current_thread() const { return current_ == this; }
+
+  // Snapshot of this executor's counters. The base class only knows how
+  // many delayed tasks are pending; executors with their own workers add
+  // queue depth, per-worker busy/idle time and sampled latency.
+  virtual RuntimeMetrics metrics() const {
+    RuntimeMetrics out;
+    out.delayed = delayed_target_->pending.load(std::memory_order_relaxed);
+    return out;
+  }
+
   virtual void shutdown() {
     LOG_INFO(
         "AbstractExecutor::shutdown - default implementation does nothing");
     throw std::runtime_error("AbstractExecutor::shutdown not implemented");
   }
+
+ protected:
+  // Stop forwarding delayed tasks to this executor. Derived executors call
+  // this from shutdown()/destructor, before their queues go away.
+  void cancel_delayed() { delayed_target_->detach(); }
+
+  // Worker threads call this once on startup to claim the calling thread.
+  static void bind_current_thread(const AbstractExecutor* executor) {
+    current_ = executor;
+  }
+
+  // The executor the calling thread is bound to, if any.
+  static const AbstractExecutor* bound_executor() { return current_; }
+
+ private:
+  // Outlives the executor inside pending timer callbacks.
+  struct DelayedTarget {
+    std::recursive_mutex mutex;
+    AbstractExecutor* executor;
+    std::atomic<size_t> pending{0};  // timers scheduled but not fired
+
+    explicit DelayedTarget(AbstractExecutor* executor) : executor(executor) {}
+
+    void execute(std::function<void()>&& func) {
+      std::lock_guard<std::recursive_mutex> lock(mutex);
+      if (executor) executor->execute(std::move(func));
+    }
+
+    void detach() {
+      std::lock_guard<std::recursive_mutex> lock(mutex);
+      executor = nullptr;
+    }
+  };
+
+  std::shared_ptr<DelayedTarget> delayed_target_;
+
+  inline static thread_local const AbstractExecutor* current_ = nullptr;
 };
 
 }  // namespace koroutine
\ No newline at end of file
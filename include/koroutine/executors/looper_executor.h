@@ -1,91 +1,66 @@
 #pragma once
 
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
 #include <functional>
-#include <future>
-#include <map>
-#include <mutex>
-#include <queue>
+#include <span>
 #include <thread>
 
 #include "executor.h"
+#include "koroutine/details/mpsc_queue.hpp"
+#include "koroutine/details/worker_metrics.hpp"
+#include "runnable.h"
 
 namespace koroutine {
 
+/**
+ * @brief Executor that runs every task, in submission order, on one
+ * dedicated loop thread.
+ *
+ * Producers push into a lock-free MPSC queue and only take the wakeup path
+ * when the loop thread is parked; the loop drains everything that is ready
+ * per wakeup without taking a lock per task.
+ */
 class LooperExecutor : public AbstractExecutor {
  private:
-  using Clock = std::chrono::steady_clock;
-  using TimePoint = Clock::time_point;
-  using TaskPair = std::pair<TimePoint, std::function<void()>>;
+  details::MpscQueue<Runnable> tasks_;
 
-  struct CompareTasks {
-    bool operator()(const TaskPair& a, const TaskPair& b) const {
-      return a.first > b.first;
-    }
-  };
+  // The loop thread sets parked_ before its final emptiness check and waits
+  // on it; producers clear it (and notify) after pushing.
+  std::atomic<bool> parked_{false};
+  std::atomic<bool> is_active_{true};
 
-  std::priority_queue<TaskPair, std::vector<TaskPair>, CompareTasks>
-      delayed_tasks_;
-  std::queue<std::function<void()>> tasks_;
+  // Registered before worker_ starts so metrics() sees the loop at once.
+  details::MetricsRegistry metrics_;
+  details::WorkerMetrics& loop_metrics_ = metrics_.add_worker();
 
-  std::mutex mutex_;
-  std::condition_variable cv_;
-  std::atomic<bool> is_active_{true};
   std::thread worker_;
 
-  inline bool has_pending_tasks() {
-    return !tasks_.empty() || !delayed_tasks_.empty();
-  }
   void run_loop() {
-    while (is_active_ || !tasks_.empty() || !delayed_tasks_.empty()) {
-      LOG_TRACE("LooperExecutor::run_loop - waiting for tasks");
-      std::unique_lock lock(mutex_);
-      LOG_TRACE("LooperExecutor::run_loop - acquired lock");
-
-      if (tasks_.empty() && delayed_tasks_.empty()) {
-        LOG_INFO("LooperExecutor::run_loop - no tasks available, waiting...");
-        cv_.wait(lock, [this] {
-          return !tasks_.empty() || !delayed_tasks_.empty() || !is_active_;
-        });
-        if (!is_active_ && tasks_.empty() && delayed_tasks_.empty()) break;
-      }
-
-      if (tasks_.empty()) {
-        auto wait_time = delayed_tasks_.top().first - Clock::now();
-        if (wait_time > Clock::duration::zero()) {
-          LOG_TRACE(
-              "LooperExecutor::run_loop - waiting for delayed task to be "
-              "ready");
-          //   TODO: 如果在等待期间有新任务到来，应该提前唤醒
-          cv_.wait_for(lock, wait_time,
-                       [this] {
-                        return has_pending_tasks() || !is_active_;
-            });
-        }
-      }
-
-      // Move ready delayed tasks to the immediate queue
-      auto now = Clock::now();
-      while (!delayed_tasks_.empty() && delayed_tasks_.top().first <= now) {
-        LOG_TRACE(
-            "LooperExecutor::run_loop - moving delayed task to immediate "
-            "queue");
-        tasks_.push(
-            std::move(const_cast<TaskPair&>(delayed_tasks_.top()).second));
-        delayed_tasks_.pop();
+    bind_current_thread(this);
+    Runnable task;
+    while (true) {
+      LOG_TRACE("LooperExecutor::run_loop - draining tasks");
+      while (tasks_.try_pop(task)) {
+        loop_metrics_.on_run(task.enqueued_ns());
+        task();
+        task = Runnable();
       }
 
-      // Execute immediate tasks
+      parked_.store(true, std::memory_order_seq_cst);
       if (!tasks_.empty()) {
-        LOG_TRACE("LooperExecutor::run_loop - executing immediate task");
-        auto task = std::move(tasks_.front());
-        tasks_.pop();
-        lock.unlock();
-        task();
+        // A producer is still publishing, or pushed after the drain
+        parked_.store(false, std::memory_order_relaxed);
+        std::this_thread::yield();
+        continue;
       }
+      if (!is_active_.load()) break;
+      LOG_TRACE("LooperExecutor::run_loop - no tasks available, parking");
+      loop_metrics_.park_begin();
+      parked_.wait(true, std::memory_order_acquire);
+      loop_metrics_.park_end();
     }
+    loop_metrics_.retire();
+    bind_current_thread(nullptr);
   }
 
  public:
@@ -98,44 +73,78 @@ class LooperExecutor : public AbstractExecutor {
     }
   }
 
+  using AbstractExecutor::execute;
+
   void execute(std::function<void()>&& func) override {
-    LOG_TRACE("LooperExecutor::execute - adding task to queue");
-    {
-      std::unique_lock lock(mutex_);
-      LOG_DEBUG("LooperExecutor::execute called.");
-      if (is_active_) {
-        tasks_.push(std::move(func));
-      }
+    enqueue(Runnable(std::move(func)));
+  }
+
+  void execute(std::coroutine_handle<> handle) override {
+    enqueue(Runnable(handle));
+  }
+
+  // Publishes the whole batch before waking the loop once.
+  void execute_bulk(
+      std::span<const std::coroutine_handle<>> handles) override {
+    if (!is_active_.load(std::memory_order_relaxed)) return;
+    for (auto handle : handles) {
+      Runnable task(handle);
+      task.set_enqueued_ns(details::sample_enqueue_time());
+      tasks_.push(std::move(task));
     }
-    cv_.notify_one();
+    if (!handles.empty()) wake();
   }
 
-  void execute_delayed(std::function<void()>&& func, long long ms) override {
-    LOG_TRACE(
-        "LooperExecutor::execute_delayed - adding delayed task to queue with "
-        "delay: ",
-        ms);
-    {
-      std::unique_lock lock(mutex_);
-      LOG_DEBUG("LooperExecutor::execute_delayed called.", ms);
-      if (is_active_) {
-        auto time_point = Clock::now() + std::chrono::milliseconds(ms);
-        delayed_tasks_.push({time_point, std::move(func)});
-      }
+  void execute_bulk(const std::function<void()>& func,
+                    size_t count) override {
+    if (!is_active_.load(std::memory_order_relaxed)) return;
+    for (size_t i = 0; i < count; ++i) {
+      Runnable task(func);
+      task.set_enqueued_ns(details::sample_enqueue_time());
+      tasks_.push(std::move(task));
     }
-    cv_.notify_one();
+    if (count > 0) wake();
+  }
+
+  // The loop thread is the only thread this executor can route to.
+  bool execute_on(std::thread::id thread,
+                  std::coroutine_handle<> handle) override {
+    if (thread != worker_.get_id()) return false;
+    enqueue(Runnable(handle));
+    return true;
   }
 
   void shutdown() {
     LOG_TRACE("LooperExecutor::shutdown - shutting down executor");
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      is_active_ = false;
-    }
-    cv_.notify_all();
+    cancel_delayed();
+    is_active_.store(false);
+    wake();
   }
 
   std::thread::id get_thread_id() const { return worker_.get_id(); }
+
+  RuntimeMetrics metrics() const override {
+    RuntimeMetrics out = AbstractExecutor::metrics();
+    out.queued = tasks_.size_approx();
+    metrics_.collect(out);
+    return out;
+  }
+
+ private:
+  void enqueue(Runnable&& task) {
+    LOG_TRACE("LooperExecutor::execute - adding task to queue");
+    if (!is_active_.load(std::memory_order_relaxed)) return;
+    task.set_enqueued_ns(details::sample_enqueue_time());
+    tasks_.push(std::move(task));
+    wake();
+  }
+
+  void wake() {
+    if (parked_.load(std::memory_order_seq_cst) &&
+        parked_.exchange(false, std::memory_order_seq_cst)) {
+      parked_.notify_one();
+    }
+  }
 };
 
 }  // namespace koroutine
\ No newline at end of file
@@ -7,9 +7,14 @@
 namespace koroutine {
 class NewThreadExecutor : public AbstractExecutor {
  public:
+  ~NewThreadExecutor() override { cancel_delayed(); }
+
+  using AbstractExecutor::execute;
+
   void execute(std::function<void()>&& func) override {
     LOG_TRACE("NewThreadExecutor::execute - launching new thread");
-    std::thread([func = std::move(func)]() mutable {
+    std::thread([this, func = std::move(func)]() mutable {
+      bind_current_thread(this);
       LOG_TRACE("NewThreadExecutor::execute - executing task in new thread");
       func();
       LOG_TRACE("NewThreadExecutor::execute - task completed");
@@ -4,6 +4,10 @@
 namespace koroutine {
 class NoopExecutor : public AbstractExecutor {
  public:
+  ~NoopExecutor() override { cancel_delayed(); }
+
+  using AbstractExecutor::execute;
+
   void execute(std::function<void()>&& func) override {
     LOG_TRACE("NoopExecutor::execute - executing no-op function");
     func();
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../details/coop_budget.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief Move-only `void()` callable with inline storage.
+ *
+ * Executors store queued work as Runnable instead of std::function so that
+ * resuming a coroutine never touches the heap: a coroutine handle, a lambda
+ * capturing a handle, or a std::function being forwarded all fit in the
+ * inline buffer. Larger callables fall back to a heap allocation.
+ *
+ * It also carries the optional submission timestamp that executors use to
+ * sample schedule-to-start latency (see RuntimeMetrics).
+ */
+class Runnable {
+ public:
+  static constexpr size_t kInlineSize = 48;
+
+  Runnable() noexcept = default;
+
+  /**
+   * @brief Runnable that resumes a coroutine handle.
+   */
+  explicit Runnable(std::coroutine_handle<> handle) noexcept
+      : Runnable(ResumeHandle{handle}) {}
+
+  template <typename F>
+    requires(!std::is_same_v<std::decay_t<F>, Runnable> &&
+             std::is_invocable_r_v<void, std::decay_t<F>&>)
+  Runnable(F&& func) {  // NOLINT(google-explicit-constructor)
+    using Fn = std::decay_t<F>;
+    if constexpr (fits_inline<Fn>()) {
+      ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(func));
+      vtable_ = &inline_vtable<Fn>;
+    } else {
+      ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(func)));
+      vtable_ = &heap_vtable<Fn>;
+    }
+  }
+
+  Runnable(Runnable&& other) noexcept
+      : vtable_(other.vtable_), enqueued_ns_(other.enqueued_ns_) {
+    if (vtable_) {
+      vtable_->move(storage_, other.storage_);
+      other.vtable_ = nullptr;
+    }
+  }
+
+  Runnable& operator=(Runnable&& other) noexcept {
+    if (this != &other) {
+      reset();
+      vtable_ = other.vtable_;
+      enqueued_ns_ = other.enqueued_ns_;
+      if (vtable_) {
+        vtable_->move(storage_, other.storage_);
+        other.vtable_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  Runnable(const Runnable&) = delete;
+  Runnable& operator=(const Runnable&) = delete;
+
+  ~Runnable() { reset(); }
+
+  // Each work item starts with a full cooperative budget (see CoopBudget).
+  void operator()() {
+    details::CoopBudget::reset();
+    vtable_->invoke(storage_);
+  }
+
+  explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+  // Submission timestamp (steady clock, ns) when sampled for metrics, else 0.
+  uint64_t enqueued_ns() const noexcept { return enqueued_ns_; }
+  void set_enqueued_ns(uint64_t ns) noexcept { enqueued_ns_ = ns; }
+
+ private:
+  struct ResumeHandle {
+    std::coroutine_handle<> handle;
+    void operator()() const { handle.resume(); }
+  };
+
+  struct VTable {
+    void (*invoke)(void* storage);
+    // move-construct into dst and destroy src
+    void (*move)(void* dst, void* src) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  template <typename Fn>
+  static constexpr bool fits_inline() {
+    return sizeof(Fn) <= kInlineSize &&
+           alignof(Fn) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Fn>;
+  }
+
+  template <typename Fn>
+  static constexpr VTable inline_vtable{
+      [](void* s) { (*static_cast<Fn*>(s))(); },
+      [](void* dst, void* src) noexcept {
+        ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+        static_cast<Fn*>(src)->~Fn();
+      },
+      [](void* s) noexcept { static_cast<Fn*>(s)->~Fn(); }};
+
+  template <typename Fn>
+  static constexpr VTable heap_vtable{
+      [](void* s) { (**static_cast<Fn**>(s))(); },
+      [](void* dst, void* src) noexcept {
+        ::new (dst) Fn*(*static_cast<Fn**>(src));
+      },
+      [](void* s) noexcept { delete *static_cast<Fn**>(s); }};
+
+  void reset() noexcept {
+    if (vtable_) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) std::byte storage_[kInlineSize];
+  const VTable* vtable_ = nullptr;
+  uint64_t enqueued_ns_ = 0;
+};
+
+}  // namespace koroutine
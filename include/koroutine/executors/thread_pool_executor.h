@@ -1,17 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <coroutine>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <span>
 #include <thread>
 #include <vector>
 
 #include "executor.h"
 #include "koroutine/debug.h"
+#include "koroutine/details/cpu_relax.hpp"
+#include "koroutine/details/ring_queue.hpp"
+#include "koroutine/details/worker_metrics.hpp"
+#include "runnable.h"
 
 namespace koroutine {
 
@@ -20,175 +27,347 @@ namespace koroutine {
  *
  * Features:
  * - Fixed size thread pool for immediate task execution.
- * - Dedicated timer thread for handling delayed tasks efficiently.
+ * - Delayed tasks wait on the shared timer wheel (TimerService).
  * - Graceful shutdown mechanism.
  * - Thread-safe task submission.
+ * - Queued work is stored as Runnable in a ring buffer, so resuming a
+ *   coroutine performs no heap allocation once the queue has warmed up.
+ * - Idle workers spin for a short, tunable budget before parking on the
+ *   condition variable. While a worker is spinning, producers skip
+ *   notify_one(), so short request/response hops avoid the futex
+ *   sleep/wake round trip.
+ * - metrics() reports queue depth, per-worker busy/parked time and sampled
+ *   schedule-to-start latency.
+ * - Optional admission control (set_queue_limit): new work submitted through
+ *   try_execute() is refused once the run queue is at capacity, and under
+ *   OverflowPolicy::Block producers parked by wait_for_capacity() are let in
+ *   one per dequeued task. execute() itself is never refused.
  */
 class ThreadPoolExecutor : public AbstractExecutor {
  public:
+  // Spin iterations (each one a cpu_relax()) before an idle worker parks.
+  static constexpr uint32_t kDefaultSpinBudget = 4096;
+
+  /**
+   * @brief Idle-path counters, for tuning the spin budget.
+   */
+  struct Stats {
+    uint64_t spin_hits = 0;  // idle episodes that found work while spinning
+    uint64_t parks = 0;      // idle episodes that went to sleep
+  };
+
   /**
    * @brief Construct a new Thread Pool Executor
    *
    * @param threads Number of worker threads. Defaults to hardware concurrency.
+   * @param spin_budget Spin iterations before an idle worker parks; 0 parks
+   * immediately. Defaults to 0 on single-core machines, where spinning only
+   * delays the producer.
    */
   explicit ThreadPoolExecutor(
-      size_t threads = std::thread::hardware_concurrency())
-      : stop_(false) {
+      size_t threads = std::thread::hardware_concurrency(),
+      uint32_t spin_budget = default_spin_budget())
+      : stop_(false), spin_budget_(spin_budget) {
     if (threads == 0) threads = 1;
+    max_spinners_ = std::max<size_t>(1, threads / 2);
 
     LOG_INFO("ThreadPoolExecutor: Starting with ", threads, " threads");
 
     // Start worker threads
     for (size_t i = 0; i < threads; ++i) {
-      workers_.emplace_back([this, i] {
-        (void)i;  // Suppress unused warning if logging is disabled
-        LOG_TRACE("ThreadPoolExecutor: Worker ", i, " started");
-        while (true) {
-          std::function<void()> task;
-          {
-            std::unique_lock<std::mutex> lock(this->queue_mutex_);
-            this->condition_.wait(
-                lock, [this] { return this->stop_ || !this->tasks_.empty(); });
-
-            if (this->stop_ && this->tasks_.empty()) {
-              LOG_TRACE("ThreadPoolExecutor: Worker ", i, " stopping");
-              return;
-            }
-
-            task = std::move(this->tasks_.front());
-            this->tasks_.pop();
-          }
-          try {
-            task();
-          } catch (const std::exception& e) {
-            LOG_ERROR("ThreadPoolExecutor: Task threw exception: ", e.what());
-          } catch (...) {
-            LOG_ERROR("ThreadPoolExecutor: Task threw unknown exception");
-          }
-        }
-      });
+      auto& counters = metrics_.add_worker();
+      workers_.emplace_back(
+          [this, i, &counters] { worker_loop(i, counters); });
     }
+  }
 
-    // Start timer thread for delayed tasks
-    timer_thread_ = std::thread([this] {
-      LOG_TRACE("ThreadPoolExecutor: Timer thread started");
-      while (true) {
-        std::unique_lock<std::mutex> lock(timer_mutex_);
+  ~ThreadPoolExecutor() override { shutdown(); }
 
-        if (stop_ && delayed_tasks_.empty()) {
-          LOG_TRACE("ThreadPoolExecutor: Timer thread stopping");
-          return;
-        }
+  using AbstractExecutor::execute;
 
-        if (delayed_tasks_.empty()) {
-          timer_cv_.wait(lock,
-                         [this] { return stop_ || !delayed_tasks_.empty(); });
-          if (stop_ && delayed_tasks_.empty()) return;
-        }
+  void execute(std::function<void()>&& func) override {
+    enqueue(Runnable(std::move(func)));
+  }
 
-        // Check top task
-        auto now = std::chrono::steady_clock::now();
-        // Use const_cast to move the function out before popping, as top()
-        // returns const ref
-        if (delayed_tasks_.top().first <= now) {
-          auto task = std::move(
-              const_cast<std::function<void()>&>(delayed_tasks_.top().second));
-          delayed_tasks_.pop();
-          lock.unlock();
-
-          // Submit to main thread pool
-          execute(std::move(task));
-        } else {
-          auto next_time = delayed_tasks_.top().first;
-          timer_cv_.wait_until(lock, next_time);
-        }
-      }
-    });
+  void execute(std::coroutine_handle<> handle) override {
+    enqueue(Runnable(handle));
   }
 
-  ~ThreadPoolExecutor() override { shutdown(); }
+  bool try_execute(std::coroutine_handle<> handle, size_t max_depth) override {
+    return enqueue(Runnable(handle), max_depth);
+  }
 
-  void execute(std::function<void()>&& func) override {
-    {
-      std::unique_lock<std::mutex> lock(queue_mutex_);
-      if (stop_) {
-        LOG_WARN("ThreadPoolExecutor: execute called on stopped executor");
-        return;
-        // Alternatively throw, but logging is safer for destructors
-      }
-      tasks_.emplace(std::move(func));
-    }
-    condition_.notify_one();
+  // One lock for the whole batch; wakes at most one parked worker per
+  // task.
+  void execute_bulk(
+      std::span<const std::coroutine_handle<>> handles) override {
+    enqueue_bulk(handles.size(),
+                 [&](size_t i) { return Runnable(handles[i]); });
   }
 
-  void execute_delayed(std::function<void()>&& func, long long ms) override {
-    auto execute_at =
-        std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
-    {
-      std::unique_lock<std::mutex> lock(timer_mutex_);
-      if (stop_) {
-        LOG_WARN(
-            "ThreadPoolExecutor: execute_delayed called on stopped executor");
-        return;
-      }
-      delayed_tasks_.push({execute_at, std::move(func)});
-    }
-    // Notify timer thread to re-evaluate wait time (in case this task is
-    // sooner than current top)
-    timer_cv_.notify_one();
+  void execute_bulk(const std::function<void()>& func,
+                    size_t count) override {
+    enqueue_bulk(count, [&](size_t) { return Runnable(func); });
   }
 
   void shutdown() {
     if (stop_.exchange(true)) return;  // Already stopped
 
     LOG_INFO("ThreadPoolExecutor: Shutting down...");
+    cancel_delayed();
 
-    // Wake up all workers
+    // Wake up all workers. Parked producers go to the run queue, which the
+    // workers drain before they exit, so none of them is left suspended.
     {
       std::unique_lock<std::mutex> lock(queue_mutex_);
-      // stop_ is already true
+      release_waiters_locked(SIZE_MAX);
     }
     condition_.notify_all();
 
-    // Wake up timer thread
-    {
-      std::unique_lock<std::mutex> lock(timer_mutex_);
-      // stop_ is already true
-    }
-    timer_cv_.notify_all();
-
     for (std::thread& worker : workers_) {
       if (worker.joinable()) worker.join();
     }
-    if (timer_thread_.joinable()) timer_thread_.join();
 
     LOG_INFO("ThreadPoolExecutor: Shutdown complete");
   }
 
+  void set_spin_budget(uint32_t spin_budget) {
+    spin_budget_.store(spin_budget, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Bound the run queue for new work. Raising the limit or leaving
+   * OverflowPolicy::Block lets parked producers in straight away.
+   */
+  void set_queue_limit(QueueLimit limit) {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      capacity_ = limit.capacity;
+      policy_ = limit.policy;
+      release_waiters_locked(
+          limit.policy == OverflowPolicy::Block ? limit.capacity : SIZE_MAX);
+    }
+    condition_.notify_all();
+  }
+
+  QueueLimit queue_limit() const override {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    return QueueLimit{capacity_, policy_};
+  }
+
+  bool has_capacity(size_t max_depth) const override {
+    return queued_.load(std::memory_order_relaxed) < max_depth;
+  }
+
+  bool wait_for_capacity(std::coroutine_handle<> waiter) override {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (stop_ || policy_ != OverflowPolicy::Block || capacity_ == 0 ||
+        tasks_.size() < capacity_) {
+      return false;
+    }
+    capacity_waiters_.push(std::move(waiter));
+    return true;
+  }
+
+  Stats stats() const {
+    return Stats{spin_hits_.load(std::memory_order_relaxed),
+                 parks_.load(std::memory_order_relaxed)};
+  }
+
+  RuntimeMetrics metrics() const override {
+    RuntimeMetrics out = AbstractExecutor::metrics();
+    out.queued = queued_.load(std::memory_order_relaxed);
+    out.rejected = rejected_.load(std::memory_order_relaxed);
+    metrics_.collect(out);
+    return out;
+  }
+
  private:
+  static uint32_t default_spin_budget() {
+    return std::thread::hardware_concurrency() > 1 ? kDefaultSpinBudget : 0;
+  }
+
+  void worker_loop(size_t i, details::WorkerMetrics& counters) {
+    (void)i;  // Suppress unused warning if logging is disabled
+    LOG_TRACE("ThreadPoolExecutor: Worker ", i, " started");
+    bind_current_thread(this);
+    while (true) {
+      Runnable task;
+      if (!try_pop(task) && !spin_for(task)) {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (!stop_ && tasks_.empty()) {
+          parks_.fetch_add(1, std::memory_order_relaxed);
+          counters.park_begin();
+          ++sleepers_;
+          condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+          --sleepers_;
+          counters.park_end();
+        }
+
+        if (stop_ && tasks_.empty()) {
+          LOG_TRACE("ThreadPoolExecutor: Worker ", i, " stopping");
+          counters.retire();
+          return;
+        }
+
+        take_locked(task, lock);
+      }
+      counters.on_run(task.enqueued_ns());
+      try {
+        task();
+      } catch (const std::exception& e) {
+        LOG_ERROR("ThreadPoolExecutor: Task threw exception: ", e.what());
+      } catch (...) {
+        LOG_ERROR("ThreadPoolExecutor: Task threw unknown exception");
+      }
+    }
+  }
+
+  bool try_pop(Runnable& task) {
+    if (queued_.load(std::memory_order_relaxed) == 0) return false;
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (tasks_.empty()) return false;
+    take_locked(task, lock);
+    return true;
+  }
+
+  // Pop under the lock. The freed slot goes to a parked producer first. If
+  // more work is left, a worker is parked and nobody is spinning to pick it
+  // up, wake it so a burst is not serialised on this one.
+  void take_locked(Runnable& task, std::unique_lock<std::mutex>& lock) {
+    task = tasks_.pop();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    if (!capacity_waiters_.empty()) {
+      release_waiters_locked(capacity_);
+    }
+    bool more = !tasks_.empty() && sleepers_ > 0;
+    lock.unlock();
+    if (more && spinning_.load(std::memory_order_seq_cst) == 0) {
+      condition_.notify_one();
+    }
+  }
+
+  // Spin before parking. The worker stops counting itself in spinning_
+  // before it pops: a producer that pushes behind the task it is about to
+  // run must see spinning_ == 0 and wake a parked worker, or the new task
+  // waits until this one finishes. A producer that reads spinning_ > 0
+  // (and skips the notify) is still covered: the spinner re-checks the queue
+  // after its decrement, here or under the lock in worker_loop.
+  bool spin_for(Runnable& task) {
+    uint32_t budget = spin_budget_.load(std::memory_order_relaxed);
+    if (budget == 0 || stop_) return false;
+    if (spinning_.fetch_add(1, std::memory_order_seq_cst) >= max_spinners_) {
+      spinning_.fetch_sub(1, std::memory_order_seq_cst);
+      return false;
+    }
+    bool ready = false;
+    for (uint32_t n = 0; n < budget && !stop_; ++n) {
+      details::cpu_relax();
+      if (queued_.load(std::memory_order_relaxed) > 0) {
+        ready = true;
+        break;
+      }
+    }
+    spinning_.fetch_sub(1, std::memory_order_seq_cst);
+    if (!ready || !try_pop(task)) return false;
+    spin_hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Move parked producers to the run queue while it holds fewer than
+  // `limit` tasks (0 counts as unbounded).
+  void release_waiters_locked(size_t limit) {
+    if (limit == 0) limit = SIZE_MAX;
+    while (!capacity_waiters_.empty() && tasks_.size() < limit) {
+      Runnable task(capacity_waiters_.pop());
+      task.set_enqueued_ns(details::sample_enqueue_time());
+      tasks_.push(std::move(task));
+      queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Pushes make(0) .. make(count - 1) under one lock, then wakes at most
+  // one parked worker per task.
+  template <typename Make>
+  void enqueue_bulk(size_t count, Make&& make) {
+    if (count == 0) return;
+    size_t wake = 0;
+    size_t sleepers = 0;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      if (stop_) {
+        LOG_WARN("ThreadPoolExecutor: execute called on stopped executor");
+        return;
+      }
+      for (size_t i = 0; i < count; ++i) {
+        Runnable task = make(i);
+        task.set_enqueued_ns(details::sample_enqueue_time());
+        tasks_.push(std::move(task));
+      }
+      queued_.fetch_add(count, std::memory_order_relaxed);
+      sleepers = sleepers_;
+      wake = std::min(count, sleepers);
+    }
+    if (wake == 0) return;
+    if (wake == sleepers) {
+      condition_.notify_all();
+    } else {
+      for (size_t i = 0; i < wake; ++i) condition_.notify_one();
+    }
+  }
+
+  // Returns false when the executor is stopped or, for admission, when
+  // `max_depth` tasks are already queued.
+  bool enqueue(Runnable&& task, size_t max_depth = SIZE_MAX) {
+    task.set_enqueued_ns(details::sample_enqueue_time());
+    bool parked = false;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      if (stop_) {
+        LOG_WARN("ThreadPoolExecutor: execute called on stopped executor");
+        return false;
+        // Alternatively throw, but logging is safer for destructors
+      }
+      if (tasks_.size() >= max_depth) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      tasks_.push(std::move(task));
+      queued_.fetch_add(1, std::memory_order_relaxed);
+      parked = sleepers_ > 0;
+    }
+    // Workers that are not parked re-check the queue under the lock before
+    // waiting; a spinning worker will pick the task up without a futex wake.
+    if (parked && spinning_.load(std::memory_order_seq_cst) == 0) {
+      condition_.notify_one();
+    }
+    return true;
+  }
+
   std::vector<std::thread> workers_;
-  std::queue<std::function<void()>> tasks_;
+  details::RingQueue<Runnable> tasks_;
 
-  std::mutex queue_mutex_;
+  mutable std::mutex queue_mutex_;
   std::condition_variable condition_;
   std::atomic<bool> stop_;
+  size_t sleepers_ = 0;  // workers waiting on condition_, under queue_mutex_
 
-  // Timer related
-  using Clock = std::chrono::steady_clock;
-  using TimePoint = Clock::time_point;
-  using TaskPair = std::pair<TimePoint, std::function<void()>>;
+  // Admission control, under queue_mutex_.
+  size_t capacity_ = 0;  // 0 = unbounded
+  OverflowPolicy policy_ = OverflowPolicy::Reject;
+  details::RingQueue<std::coroutine_handle<>> capacity_waiters_{4};
+  std::atomic<uint64_t> rejected_{0};
 
-  struct CompareTasks {
-    bool operator()(const TaskPair& a, const TaskPair& b) const {
-      return a.first > b.first;  // Min heap based on time
-    }
-  };
+  // Mirrors tasks_.size() so spinners can poll without the lock.
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> spinning_{0};
+  size_t max_spinners_ = 1;
+  std::atomic<uint32_t> spin_budget_;
+
+  std::atomic<uint64_t> spin_hits_{0};
+  std::atomic<uint64_t> parks_{0};
 
-  std::priority_queue<TaskPair, std::vector<TaskPair>, CompareTasks>
-      delayed_tasks_;
-  std::mutex timer_mutex_;
-  std::condition_variable timer_cv_;
-  std::thread timer_thread_;
+  details::MetricsRegistry metrics_;
 };
 
 }  // namespace koroutine
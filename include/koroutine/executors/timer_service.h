@@ -0,0 +1,202 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include "koroutine/debug.h"
+#include "koroutine/details/delay.hpp"
+#include "koroutine/details/timer_wheel.hpp"
+#include "runnable.h"
+
+namespace koroutine {
+
+/**
+ * @brief Timer thread driving a hierarchical timing wheel.
+ *
+ * Features:
+ * - O(1) schedule and cancel with microsecond resolution, regardless of how
+ *   many timers are pending.
+ * - The thread sleeps until the next occupied wheel slot and is only woken
+ *   when a new timer is due earlier than that. On Linux the thread's timer
+ *   slack is cut to 1ns (the default is 50us), so the kernel fires its
+ *   sleep as a precise hrtimer instead of batching it with other wakeups.
+ * - Callbacks run on the timer thread and should be short; executors use it
+ *   to hand the real work to their own queues.
+ *
+ * A single process-wide instance backs every executor's execute_delayed();
+ * independent instances may be created where a separate timer thread is
+ * wanted (see TimerScheduler).
+ */
+class TimerService {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using TimerHandle = details::TimerWheel::TimerId;
+  // One wheel tick.
+  using Tick = std::chrono::microseconds;
+
+  TimerService() : start_(Clock::now()) {
+    thread_ = std::thread([this] { run_loop(); });
+  }
+
+  ~TimerService() {
+    shutdown(false);
+    join();
+  }
+
+  TimerService(const TimerService&) = delete;
+  TimerService& operator=(const TimerService&) = delete;
+
+  /**
+   * @brief The shared timer service.
+   *
+   * Intentionally never destroyed, so executors and coroutines that outlive
+   * static destruction can still schedule and cancel timers safely.
+   */
+  static TimerService& instance() {
+    static TimerService* service = new TimerService();
+    return *service;
+  }
+
+  /**
+   * @brief Run `callback` on the timer thread once `ms` milliseconds passed.
+   * @return A handle for cancel(); empty if the service is shutting down.
+   */
+  TimerHandle schedule_after(long long ms, Runnable&& callback) {
+    return schedule_after(details::delay_from_ms(ms), std::move(callback));
+  }
+
+  /**
+   * @brief Run `callback` on the timer thread once `delay` passed.
+   */
+  TimerHandle schedule_after(std::chrono::nanoseconds delay,
+                             Runnable&& callback) {
+    return schedule_at(Clock::now() + details::clamp_delay(delay),
+                       std::move(callback));
+  }
+
+  /**
+   * @brief Run `callback` on the timer thread at `when`.
+   */
+  TimerHandle schedule_at(Clock::time_point when, Runnable&& callback) {
+    uint64_t tick = tick_ceil(when);
+    TimerHandle handle;
+    bool wake = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!accepting_) {
+        LOG_WARN("TimerService: schedule called on stopped service");
+        return {};
+      }
+      handle = wheel_.add(tick, std::move(callback));
+      if (tick < wake_tick_) {
+        wake_tick_ = tick;
+        wake = true;
+      }
+    }
+    if (wake) cv_.notify_one();
+    return handle;
+  }
+
+  /**
+   * @brief Cancel a pending timer.
+   * @return true if the timer was still pending and will not run.
+   */
+  bool cancel(TimerHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return wheel_.cancel(handle);
+  }
+
+  size_t pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return wheel_.size();
+  }
+
+  /**
+   * @brief Stop accepting timers.
+   * @param wait_for_empty Keep running until every pending timer fired;
+   * otherwise pending timers are dropped.
+   */
+  void shutdown(bool wait_for_empty = true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      accepting_ = false;
+      if (!wait_for_empty) wheel_.clear();
+    }
+    cv_.notify_all();
+  }
+
+  void join() {
+    if (thread_.joinable()) thread_.join();
+  }
+
+ private:
+  static constexpr uint64_t kNever = UINT64_MAX;
+
+  uint64_t tick_floor(Clock::time_point tp) const {
+    if (tp <= start_) return 0;
+    return std::chrono::floor<Tick>(tp - start_).count();
+  }
+
+  uint64_t tick_ceil(Clock::time_point tp) const {
+    if (tp <= start_) return 0;
+    return std::chrono::ceil<Tick>(tp - start_).count();
+  }
+
+  void run_loop() {
+    LOG_TRACE("TimerService: Timer thread started");
+#ifdef __linux__
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+    std::vector<Runnable> expired;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wheel_.advance(tick_floor(Clock::now()), expired);
+      if (!expired.empty()) {
+        lock.unlock();
+        for (auto& callback : expired) {
+          try {
+            callback();
+          } catch (const std::exception& e) {
+            LOG_ERROR("TimerService: Timer callback threw exception: ",
+                      e.what());
+          } catch (...) {
+            LOG_ERROR("TimerService: Timer callback threw unknown exception");
+          }
+        }
+        expired.clear();
+        lock.lock();
+        continue;
+      }
+
+      if (!accepting_ && wheel_.empty()) break;
+
+      auto next = wheel_.next_expiry();
+      wake_tick_ = next ? *next : kNever;
+      if (next) {
+        cv_.wait_until(lock, start_ + Tick(*next));
+      } else {
+        cv_.wait(lock);
+      }
+      wake_tick_ = kNever;
+    }
+    LOG_TRACE("TimerService: Timer thread stopping");
+  }
+
+  const Clock::time_point start_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  details::TimerWheel wheel_;
+  uint64_t wake_tick_ = kNever;
+  bool accepting_ = true;
+  std::thread thread_;
+};
+
+}  // namespace koroutine
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "executor.h"
+#include "koroutine/debug.h"
+#include "koroutine/details/ring_queue.hpp"
+#include "koroutine/details/thread_affinity.hpp"
+#include "koroutine/details/work_stealing_queue.hpp"
+#include "koroutine/details/worker_metrics.hpp"
+
+namespace koroutine {
+
+/**
+ * @brief A multi-threaded executor where every worker owns its own run queue.
+ *
+ * Features:
+ * - Tasks submitted from a worker thread go to that worker's lock-free local
+ *   queue; no shared lock is touched on this path.
+ * - Tasks submitted from foreign threads (timers, I/O engines, main) go to a
+ *   shared injection queue that workers drain in batches.
+ * - Idle workers steal from their siblings before parking.
+ * - execute_on() routes a coroutine to one specific worker through that
+ *   worker's inbox; inbox entries are never stolen.
+ * - Workers can be pinned to CPUs or cpusets (Linux).
+ * - Coroutine handles are queued as tagged frame addresses, so resuming a
+ *   coroutine does not allocate.
+ * - Delayed tasks wait on the shared timer wheel (TimerService).
+ * - metrics() reports queue depth and per-worker busy/parked time. Entries
+ *   are bare tagged pointers, so schedule-to-start latency is not sampled.
+ */
+class WorkStealingExecutor : public AbstractExecutor {
+  using Job = std::function<void()>;
+  // Queue entries are either a heap-allocated Job or a coroutine frame
+  // address tagged with the low bit.
+  using Entry = uintptr_t;
+
+ public:
+  /**
+   * @brief Construct a new Work Stealing Executor
+   *
+   * @param threads Number of worker threads. Defaults to hardware concurrency.
+   */
+  explicit WorkStealingExecutor(
+      size_t threads = std::thread::hardware_concurrency())
+      : stop_(false) {
+    if (threads == 0) threads = 1;
+
+    LOG_INFO("WorkStealingExecutor: Starting with ", threads, " threads");
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>());
+      workers_.back()->rng = static_cast<uint32_t>(i * 2654435761u + 1);
+      workers_.back()->metrics = &metrics_.add_worker();
+    }
+    for (size_t i = 0; i < threads; ++i) {
+      workers_[i]->thread = std::thread([this, i] { run_worker(i); });
+      workers_[i]->id = workers_[i]->thread.get_id();
+    }
+  }
+
+  ~WorkStealingExecutor() override {
+    shutdown();
+    // Drop whatever was still queued when the workers stopped.
+    for (auto& worker : workers_) {
+      while (auto entry = worker->queue.steal()) drop_entry(*entry);
+    }
+    while (!injector_.empty()) drop_entry(injector_.pop());
+    for (auto& worker : workers_) {
+      while (!worker->inbox.empty()) drop_entry(worker->inbox.pop());
+    }
+  }
+
+  using AbstractExecutor::execute;
+
+  void execute(std::function<void()>&& func) override {
+    if (stop_) {
+      LOG_WARN("WorkStealingExecutor: execute called on stopped executor");
+      return;
+    }
+    enqueue(reinterpret_cast<Entry>(new Job(std::move(func))));
+  }
+
+  void execute(std::coroutine_handle<> handle) override {
+    if (stop_) {
+      LOG_WARN("WorkStealingExecutor: execute called on stopped executor");
+      return;
+    }
+    enqueue(reinterpret_cast<Entry>(handle.address()) | kHandleTag);
+  }
+
+  // From a worker the batch goes to its local queue where siblings can
+  // steal it; from outside it takes the injector lock once.
+  void execute_bulk(
+      std::span<const std::coroutine_handle<>> handles) override {
+    if (handles.empty()) return;
+    if (stop_) {
+      LOG_WARN("WorkStealingExecutor: execute called on stopped executor");
+      return;
+    }
+    if (tls_context_.owner == this) {
+      auto& queue = workers_[tls_context_.index]->queue;
+      for (auto handle : handles) {
+        queue.push(reinterpret_cast<Entry>(handle.address()) | kHandleTag);
+      }
+    } else {
+      std::lock_guard<std::mutex> lock(injector_mutex_);
+      for (auto handle : handles) {
+        injector_.push(reinterpret_cast<Entry>(handle.address()) | kHandleTag);
+      }
+      injector_size_.store(injector_.size(), std::memory_order_relaxed);
+    }
+    wake(handles.size());
+  }
+
+  void execute_bulk(const std::function<void()>& func,
+                    size_t count) override {
+    if (count == 0) return;
+    if (stop_) {
+      LOG_WARN("WorkStealingExecutor: execute called on stopped executor");
+      return;
+    }
+    if (tls_context_.owner == this) {
+      auto& queue = workers_[tls_context_.index]->queue;
+      for (size_t i = 0; i < count; ++i) {
+        queue.push(reinterpret_cast<Entry>(new Job(func)));
+      }
+    } else {
+      std::lock_guard<std::mutex> lock(injector_mutex_);
+      for (size_t i = 0; i < count; ++i) {
+        injector_.push(reinterpret_cast<Entry>(new Job(func)));
+      }
+      injector_size_.store(injector_.size(), std::memory_order_relaxed);
+    }
+    wake(count);
+  }
+
+  bool execute_on(std::thread::id thread,
+                  std::coroutine_handle<> handle) override {
+    Worker* target = nullptr;
+    for (auto& worker : workers_) {
+      if (worker->id == thread) {
+        target = worker.get();
+        break;
+      }
+    }
+    if (!target) return false;
+    if (stop_) {
+      LOG_WARN("WorkStealingExecutor: execute_on called on stopped executor");
+      return true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(target->inbox_mutex);
+      target->inbox.push(reinterpret_cast<Entry>(handle.address()) |
+                         kHandleTag);
+      target->inbox_size.store(target->inbox.size(),
+                               std::memory_order_relaxed);
+    }
+    // Only the owner may run inbox entries, so wake it specifically.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (target->parked.load(std::memory_order_relaxed)) {
+      {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+      }
+      park_cv_.notify_all();
+    }
+    return true;
+  }
+
+  void shutdown() override {
+    if (stop_.exchange(true)) return;  // Already stopped
+
+    LOG_INFO("WorkStealingExecutor: Shutting down...");
+    cancel_delayed();
+
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    park_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+      if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    LOG_INFO("WorkStealingExecutor: Shutdown complete");
+  }
+
+  size_t worker_count() const { return workers_.size(); }
+
+  /**
+   * @brief Thread id of worker `index`, usable as ScheduleMetadata::affinity.
+   */
+  std::thread::id worker_id(size_t index) const { return workers_[index]->id; }
+
+  /**
+   * @brief Restrict worker `index` to the given CPUs; a single entry pins it
+   * to one core.
+   * @return false if the index or CPU set is invalid, or the platform does
+   * not support thread affinity.
+   */
+  bool pin_worker(size_t index, const std::vector<int>& cpus) {
+    if (index >= workers_.size()) return false;
+    return details::set_thread_affinity(workers_[index]->thread.native_handle(),
+                                        cpus);
+  }
+
+  /**
+   * @brief Pin worker i to cpus[i % cpus.size()]. Defaults to one worker per
+   * core, in core order.
+   */
+  bool pin_workers(std::vector<int> cpus = {}) {
+    if (cpus.empty()) {
+      unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned cpu = 0; cpu < cores; ++cpu) {
+        cpus.push_back(static_cast<int>(cpu));
+      }
+    }
+    bool pinned = true;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      pinned &= pin_worker(i, {cpus[i % cpus.size()]});
+    }
+    return pinned;
+  }
+
+  /**
+   * @brief Whether the calling thread is one of this executor's workers.
+   */
+  bool is_worker_thread() const { return tls_context_.owner == this; }
+
+  RuntimeMetrics metrics() const override {
+    RuntimeMetrics out = AbstractExecutor::metrics();
+    out.queued = injector_size_.load(std::memory_order_relaxed);
+    for (auto& worker : workers_) {
+      out.queued += worker->queue.size() +
+                    worker->inbox_size.load(std::memory_order_relaxed);
+    }
+    metrics_.collect(out);
+    return out;
+  }
+
+ private:
+  struct Worker {
+    details::WorkStealingQueue<Entry> queue;
+    std::thread thread;
+    std::thread::id id;
+    uint32_t rng = 1;
+    std::atomic<bool> parked{false};
+    details::WorkerMetrics* metrics = nullptr;
+
+    // Work pinned to this worker by execute_on()
+    std::mutex inbox_mutex;
+    details::RingQueue<Entry> inbox;
+    std::atomic<size_t> inbox_size{0};
+  };
+
+  struct WorkerContext {
+    const WorkStealingExecutor* owner;
+    size_t index;
+  };
+
+  // Upper bound of tasks moved from the injection queue per visit.
+  static constexpr size_t kInjectorBatch = 32;
+  static constexpr Entry kHandleTag = 1;
+
+  void enqueue(Entry entry) {
+    if (tls_context_.owner == this) {
+      workers_[tls_context_.index]->queue.push(entry);
+    } else {
+      std::lock_guard<std::mutex> lock(injector_mutex_);
+      injector_.push(std::move(entry));
+      injector_size_.store(injector_.size(), std::memory_order_relaxed);
+    }
+    wake(1);
+  }
+
+  void run_worker(size_t index) {
+    tls_context_ = {this, index};
+    bind_current_thread(this);
+    LOG_TRACE("WorkStealingExecutor: Worker ", index, " started");
+    Worker& self = *workers_[index];
+    while (true) {
+      if (Entry entry = find_entry(index)) {
+        self.metrics->on_run();
+        details::CoopBudget::reset();
+        run_entry(entry);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      self.parked.store(true, std::memory_order_seq_cst);
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      // Re-check after announcing ourselves as a sleeper: a producer that
+      // missed the announcement published its task before we look here.
+      bool idle = !has_work(index);
+      bool stopping = idle && stop_;
+      if (idle && !stopping) {
+        self.metrics->park_begin();
+        park_cv_.wait(lock);
+        self.metrics->park_end();
+      }
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      self.parked.store(false, std::memory_order_relaxed);
+      if (stopping) break;
+    }
+    LOG_TRACE("WorkStealingExecutor: Worker ", index, " stopping");
+    self.metrics->retire();
+    tls_context_ = {nullptr, 0};
+    bind_current_thread(nullptr);
+  }
+
+  Entry find_entry(size_t index) {
+    Worker& self = *workers_[index];
+    if (Entry entry = take_from_inbox(self)) return entry;
+    if (auto entry = self.queue.steal()) return *entry;
+    if (Entry entry = take_from_injector(self)) return entry;
+    return steal_from_siblings(index);
+  }
+
+  static Entry take_from_inbox(Worker& self) {
+    if (self.inbox_size.load(std::memory_order_relaxed) == 0) return 0;
+    std::lock_guard<std::mutex> lock(self.inbox_mutex);
+    if (self.inbox.empty()) return 0;
+    Entry entry = self.inbox.pop();
+    self.inbox_size.store(self.inbox.size(), std::memory_order_relaxed);
+    return entry;
+  }
+
+  Entry take_from_injector(Worker& self) {
+    if (injector_size_.load(std::memory_order_relaxed) == 0) return 0;
+    std::lock_guard<std::mutex> lock(injector_mutex_);
+    if (injector_.empty()) return 0;
+
+    Entry first = injector_.pop();
+    // Take a fair share so the rest of the batch becomes stealable without
+    // another trip through the lock.
+    size_t share =
+        std::min(kInjectorBatch, injector_.size() / workers_.size());
+    for (size_t i = 0; i < share; ++i) {
+      self.queue.push(injector_.pop());
+    }
+    injector_size_.store(injector_.size(), std::memory_order_relaxed);
+    return first;
+  }
+
+  Entry steal_from_siblings(size_t index) {
+    size_t n = workers_.size();
+    if (n < 2) return 0;
+    Worker& self = *workers_[index];
+    // xorshift32: cheap per-worker randomisation of the victim order
+    self.rng ^= self.rng << 13;
+    self.rng ^= self.rng >> 17;
+    self.rng ^= self.rng << 5;
+    size_t start = self.rng % n;
+    for (size_t i = 0; i < n; ++i) {
+      size_t victim = (start + i) % n;
+      if (victim == index) continue;
+      if (auto entry = workers_[victim]->queue.steal()) return *entry;
+    }
+    return 0;
+  }
+
+  bool has_work(size_t index) const {
+    if (injector_size_.load(std::memory_order_seq_cst) != 0) return true;
+    if (workers_[index]->inbox_size.load(std::memory_order_seq_cst) != 0) {
+      return true;
+    }
+    for (auto& worker : workers_) {
+      if (!worker->queue.empty()) return true;
+    }
+    return false;
+  }
+
+  // Wake up to `count` parked workers.
+  void wake(size_t count) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    size_t sleepers = sleepers_.load(std::memory_order_relaxed);
+    if (sleepers == 0) return;
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    if (count >= sleepers) {
+      park_cv_.notify_all();
+    } else {
+      for (size_t i = 0; i < count; ++i) park_cv_.notify_one();
+    }
+  }
+
+  static void run_entry(Entry entry) {
+    if (entry & kHandleTag) {
+      std::coroutine_handle<>::from_address(
+          reinterpret_cast<void*>(entry & ~kHandleTag))
+          .resume();
+      return;
+    }
+    std::unique_ptr<Job> owned(reinterpret_cast<Job*>(entry));
+    try {
+      (*owned)();
+    } catch (const std::exception& e) {
+      LOG_ERROR("WorkStealingExecutor: Task threw exception: ", e.what());
+    } catch (...) {
+      LOG_ERROR("WorkStealingExecutor: Task threw unknown exception");
+    }
+  }
+
+  static void drop_entry(Entry entry) {
+    if (!(entry & kHandleTag)) delete reinterpret_cast<Job*>(entry);
+  }
+
+  inline static thread_local WorkerContext tls_context_{nullptr, 0};
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> stop_;
+
+  // Injection queue for submissions from non-worker threads
+  std::mutex injector_mutex_;
+  details::RingQueue<Entry> injector_;
+  std::atomic<size_t> injector_size_{0};
+
+  // Parking
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+  std::atomic<size_t> sleepers_{0};
+
+  details::MetricsRegistry metrics_;
+};
+
+}  // namespace koroutine
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "async_scope.hpp"
+#include "awaiters/blocking_awaiter.hpp"
 #include "awaiters/switch_executor_awaiter.hpp"
 #include "channel.hpp"
+#include "coroutine_local.hpp"
+#include "current_thread_runtime.hpp"
 #include "generator.hpp"
 #include "runtime.hpp"
 #include "schedulers/scheduler.h"
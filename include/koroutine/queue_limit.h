@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace koroutine {
+
+/**
+ * @brief What a bounded executor does with new work once its run queue is
+ * at capacity.
+ *
+ * Only admission is bounded: try_execute() / try_schedule() and admit().
+ * execute() and schedule() always enqueue, because they are also how
+ * already-running coroutines are resumed, and refusing those would strand
+ * them without freeing anything.
+ */
+enum class OverflowPolicy {
+  // Refuse new work straight away.
+  Reject,
+  // admit() suspends the producing coroutine until a slot frees up;
+  // try_execute() / try_schedule() still refuse immediately.
+  Block,
+  // Refuse lower priorities first: Low may fill half of the queue, Normal
+  // three quarters, High all of it.
+  ShedLowest,
+};
+
+/**
+ * @brief Run queue bound for an executor. A capacity of 0 means unbounded.
+ */
+struct QueueLimit {
+  size_t capacity = 0;
+  OverflowPolicy policy = OverflowPolicy::Reject;
+
+  bool bounded() const { return capacity != 0; }
+};
+
+}  // namespace koroutine
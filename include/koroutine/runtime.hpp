@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "coroutine_common.h"
+#include "executors/current_thread_executor.h"
 #include "scheduler_manager.h"
 #include "schedulers/scheduler.h"
 #include "task.hpp"
@@ -57,6 +58,8 @@ struct BlockOnPromise {
   std::atomic<bool>* is_completed = nullptr;
   std::mutex* mtx = nullptr;
   std::condition_variable* cv = nullptr;
+  // CurrentThreadRuntime：调用线程正在驱动的循环，完成时让 run() 返回
+  CurrentThreadExecutor* loop = nullptr;
 
   struct BlockOnTask {
     using promise_type = BlockOnPromise;
@@ -73,11 +76,14 @@ struct BlockOnPromise {
     BlockOnPromise& p;
     bool await_ready() const noexcept { return false; }
     void await_suspend(std::coroutine_handle<>) const noexcept {
+      // 唤醒等待者之后它可能立即销毁本协程帧，之后不能再访问 p
+      auto* loop = p.loop;
       if (p.mtx && p.cv && p.is_completed) {
         std::lock_guard lock(*p.mtx);
         p.is_completed->store(true);
         p.cv->notify_one();
       }
+      if (loop) loop->stop();
     }
     void await_resume() const noexcept {}
   };
@@ -94,7 +100,7 @@ struct BlockOnPromise {
   auto await_transform(Task<R>&& task) {
     LOG_TRACE("BlockOnPromise::await_transform - installing default scheduler");
     auto awaiter = TaskAwaiter<R>{std::move(task)};
-    awaiter.install_scheduler(SchedulerManager::get_default_scheduler());
+    awaiter.install_scheduler(SchedulerManager::current_scheduler());
     return awaiter;
   }
 };
@@ -129,7 +135,7 @@ static ResultType block_on(Task<ResultType>&& task) {
   wrapper_task.handle.promise().is_completed = &is_completed;
 
   // Start manually using default scheduler
-  auto scheduler = SchedulerManager::get_default_scheduler();
+  auto* scheduler = SchedulerManager::current_scheduler();
   ScheduleMetadata meta(ScheduleMetadata::Priority::Normal, "block_on_wrapper");
   scheduler->schedule(ScheduleRequest(wrapper_task.handle, std::move(meta)), 0);
 
@@ -162,6 +168,26 @@ static void block_on(Task<void>&& task) {
   block_on(std::move(wrapper_task));
 }
 
+/**
+ * @brief join_all 包装协程的完成信号
+ * 在 await_suspend 中递减计数：此时包装协程已挂起且不会再恢复，
+ * 等待方被唤醒后销毁包装协程是安全的
+ */
+struct JoinSignal {
+  std::mutex& mtx;
+  std::condition_variable& cv;
+  std::atomic<size_t>& remaining;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<>) const noexcept {
+    std::lock_guard lk(mtx);
+    if (remaining.fetch_sub(1) == 1) {
+      cv.notify_one();
+    }
+  }
+  void await_resume() const noexcept {}
+};
+
 /**
  * @brief 启动多个协程并等待全部完成
  * @tparam Tasks 任务类型参数包
@@ -185,25 +211,18 @@ static void join_all(Tasks&&... tasks) {
         // 丢弃非 void 任务的结果
         (void)co_await std::forward<TaskType>(task);
       }
-      if (remaining.fetch_sub(1) == 1) {
-        cv.notify_one();
-      }
     } catch (...) {
       std::lock_guard lk(mtx);
       exceptions.push_back(std::current_exception());
-      if (remaining.fetch_sub(1) == 1) {
-        cv.notify_one();
-      }
     }
+    co_await JoinSignal{mtx, cv, remaining};
   };
 
   // 创建所有包装任务并存储
   (wrappers.push_back(wrap_task(std::forward<Tasks>(tasks))), ...);
 
-  // 启动所有包装任务
-  for (auto& wrapper : wrappers) {
-    wrapper.start();
-  }
+  // 整批启动包装任务：一次入队，而不是每个任务各加一次队列锁
+  Task<void>::start_all(wrappers);
 
   // 等待所有任务完成
   std::unique_lock lk(mtx);
@@ -237,34 +256,28 @@ static void join_all(std::vector<TaskType> tasks) {
   std::vector<Task<void>> wrappers;
   wrappers.reserve(tasks.size());
 
-  // 为每个任务创建包装协程
-  for (auto& task : tasks) {
-    auto wrapper = [&mtx, &cv, &remaining,
-                    &exceptions]<typename T>(T&& t) -> Task<void> {
-      try {
-        if constexpr (std::is_same_v<std::decay_t<T>, Task<void>>) {
-          co_await std::forward<T>(t);
-        } else {
-          (void)co_await std::forward<T>(t);
-        }
-        if (remaining.fetch_sub(1) == 1) {
-          cv.notify_one();
-        }
-      } catch (...) {
-        std::lock_guard lk(mtx);
-        exceptions.push_back(std::current_exception());
-        if (remaining.fetch_sub(1) == 1) {
-          cv.notify_one();
-        }
+  // 为每个任务创建包装协程。lambda 必须活到所有包装协程结束：
+  // 协程帧只保存闭包的地址，捕获的引用从闭包中读取
+  auto wrapper = [&mtx, &cv, &remaining,
+                  &exceptions]<typename T>(T&& t) -> Task<void> {
+    try {
+      if constexpr (std::is_same_v<std::decay_t<T>, Task<void>>) {
+        co_await std::forward<T>(t);
+      } else {
+        (void)co_await std::forward<T>(t);
       }
-    };
+    } catch (...) {
+      std::lock_guard lk(mtx);
+      exceptions.push_back(std::current_exception());
+    }
+    co_await JoinSignal{mtx, cv, remaining};
+  };
+  for (auto& task : tasks) {
     wrappers.push_back(wrapper(std::move(task)));
   }
 
-  // 启动所有包装任务
-  for (auto& wrapper : wrappers) {
-    wrapper.start();
-  }
+  // 整批启动包装任务：一次入队，而不是每个任务各加一次队列锁
+  Task<void>::start_all(wrappers);
 
   // 等待完成
   std::unique_lock lk(mtx);
@@ -277,8 +290,16 @@ static void join_all(std::vector<TaskType> tasks) {
 
 template <typename T>
 static void spawn(Task<T>&& task) {
-  task.start();
-  task.detach();
+  task.start_detached();
+}
+
+/**
+ * @brief 经过准入控制启动并分离任务
+ * @return false 表示调度器的运行队列已满，任务没有启动并随之销毁
+ */
+template <typename T>
+static bool try_spawn(Task<T>&& task) {
+  return task.try_start_detached();
 }
 
 };  // namespace Runtime
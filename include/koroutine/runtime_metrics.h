@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace koroutine {
+
+/**
+ * @brief Log2 histogram of latencies in nanoseconds.
+ *
+ * Bucket i counts samples in [2^i, 2^(i+1)) ns; bucket 0 also holds 0 ns.
+ * Percentiles are therefore accurate to a factor of two, which is enough to
+ * tell a 5 us hop from a 5 ms one.
+ */
+struct LatencyHistogram {
+  static constexpr size_t kBuckets = 40;  // the last bucket holds >= ~9 min
+
+  std::array<uint64_t, kBuckets> buckets{};
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+
+  static size_t bucket_for(uint64_t ns) {
+    if (ns == 0) return 0;
+    return std::min<size_t>(kBuckets - 1, std::bit_width(ns) - 1);
+  }
+
+  // Exclusive upper bound of bucket i, in nanoseconds.
+  static uint64_t bucket_limit(size_t i) { return uint64_t{2} << i; }
+
+  /**
+   * @brief Upper bound of the bucket that holds quantile q (0..1); 0 when
+   * the histogram is empty.
+   */
+  std::chrono::nanoseconds percentile(double q) const {
+    if (count == 0) return std::chrono::nanoseconds::zero();
+    q = std::clamp(q, 0.0, 1.0);
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return std::chrono::nanoseconds(bucket_limit(i));
+      }
+    }
+    return std::chrono::nanoseconds(bucket_limit(kBuckets - 1));
+  }
+
+  std::chrono::nanoseconds mean() const {
+    return std::chrono::nanoseconds(count == 0 ? 0 : sum_ns / count);
+  }
+
+  LatencyHistogram& operator+=(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    sum_ns += other.sum_ns;
+    return *this;
+  }
+};
+
+/**
+ * @brief Point-in-time view of an executor, or of the executor behind a
+ * scheduler, as returned by metrics().
+ *
+ * Counters are kept per worker thread by their single writer and summed
+ * when the snapshot is taken, so collecting them costs nothing on the
+ * scheduling path beyond plain stores. Fields an executor does not track
+ * stay zero.
+ */
+struct RuntimeMetrics {
+  size_t workers = 0;  // threads currently running this executor's work
+  size_t queued = 0;   // accepted work not started yet
+  size_t delayed = 0;  // execute_at / execute_delayed timers not fired yet
+  uint64_t executed = 0;  // work items started since construction
+  uint64_t rejected = 0;  // new work refused by admission control
+  uint64_t expired = 0;   // work resumed after its deadline had passed
+
+  // Summed over workers: time spent parked waiting for work, and the rest.
+  std::chrono::nanoseconds busy{0};
+  std::chrono::nanoseconds idle{0};
+
+  // Sampled time from execute() to the work starting on a worker.
+  LatencyHistogram schedule_latency;
+
+  // busy / (busy + idle); 0 before any worker has run.
+  double utilization() const {
+    auto total = busy + idle;
+    return total.count() == 0
+               ? 0.0
+               : static_cast<double>(busy.count()) /
+                     static_cast<double>(total.count());
+  }
+};
+
+}  // namespace koroutine
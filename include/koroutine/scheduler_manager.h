@@ -8,9 +8,35 @@ namespace koroutine {
 
 namespace SchedulerManager {
 
+// 全局默认调度器在第一次被用到时才创建（含线程池），
+// 只使用线程默认调度器的程序不会启动任何线程池线程
 std::shared_ptr<AbstractScheduler> get_default_scheduler();
 
+// 被替换下来的全局默认调度器由 SchedulerManager 保留，之前创建的协程以裸指针
+// 绑定它，替换后仍可以继续在上面恢复。之后每次调用时回收已经没有协程绑定的
+// 旧调度器（连同它的执行器和线程），回收在锁外进行；重新设为默认的调度器
+// 不再算作被替换下来的
 void set_default_scheduler(std::shared_ptr<AbstractScheduler> scheduler);
 
+// 仅对当前线程生效的默认调度器，优先于全局默认调度器；传入 nullptr 取消。
+// 调用者负责让它活过所有绑定到它的协程
+void set_thread_default_scheduler(std::shared_ptr<AbstractScheduler> scheduler);
+
+// 当前线程的默认调度器，未设置时为 nullptr
+std::shared_ptr<AbstractScheduler> get_thread_default_scheduler();
+
+// 新协程绑定的调度器：线程默认调度器，否则为全局默认调度器。
+// 返回不拥有所有权的裸指针，稳态下只读两个指针，不做引用计数
+AbstractScheduler* current_scheduler();
+
+// 与 current_scheduler() 相同，供协程 promise 绑定时使用：得到的是全局默认
+// 调度器时为它登记一次绑定并把 counted 置为 true，之后须调用
+// release_default_binding 注销；线程默认调度器不登记，由调用者保活
+AbstractScheduler* bind_current_scheduler(bool& counted);
+
+// 注销 bind_current_scheduler 登记的绑定。scheduler 仍是全局默认调度器时
+// 无锁完成，已被替换下来时加锁查找它的条目
+void release_default_binding(AbstractScheduler* scheduler);
+
 }  // namespace SchedulerManager
 }  // namespace koroutine
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "koroutine/debug.h"
+#include "koroutine/schedulers/queued_scheduler.hpp"
+namespace koroutine {
+namespace details {
+/**
+ * @brief DeadlineScheduler 的运行队列：按截止时间排序的小顶堆
+ *
+ * 截止时间相同的按提交顺序取出；没有截止时间的视为无限远。
+ */
+class DeadlineRunQueue {
+ public:
+  using Clock = AbstractScheduler::Clock;
+  static constexpr const char* kName = "DeadlineScheduler";
+  using Key = Clock::time_point;
+
+  static Key key_of(const ScheduleMetadata& metadata) {
+    return metadata.deadline.value_or(Clock::time_point::max());
+  }
+
+  void push(std::coroutine_handle<> handle, Key deadline) {
+    _heap.push_back(Entry{deadline, _seq++, handle});
+    std::push_heap(_heap.begin(), _heap.end(), Later{});
+  }
+
+  bool pop(std::coroutine_handle<>& handle, Key& deadline) {
+    if (_heap.empty()) return false;
+    std::pop_heap(_heap.begin(), _heap.end(), Later{});
+    handle = _heap.back().handle;
+    deadline = _heap.back().deadline;
+    _heap.pop_back();
+    return true;
+  }
+
+  void before_resume(const Key& deadline) {
+    if (deadline != Clock::time_point::max() && deadline <= Clock::now()) {
+      // 任务在下一个 co_await 处以 OperationCancelledException 结束
+      _expired.fetch_add(1, std::memory_order_relaxed);
+      LOG_DEBUG("DeadlineScheduler::run_next - resuming expired coroutine");
+    }
+  }
+
+  void add_metrics(RuntimeMetrics& out) const {
+    out.expired += _expired.load(std::memory_order_relaxed);
+  }
+
+  size_t size() const { return _heap.size(); }
+
+ private:
+  struct Entry {
+    Clock::time_point deadline;
+    uint64_t seq;
+    std::coroutine_handle<> handle;
+  };
+
+  // std::push_heap 维护大顶堆，比较取反得到截止时间最早（同时间先提交）的在堆顶
+  struct Later {
+    bool operator()(const Entry& a, const Entry& b) const {
+      if (a.deadline != b.deadline) return a.deadline > b.deadline;
+      return a.seq > b.seq;
+    }
+  };
+
+  std::vector<Entry> _heap;
+  uint64_t _seq = 0;
+  std::atomic<uint64_t> _expired{0};
+};
+}  // namespace details
+
+/**
+ * @brief 按截止时间（ScheduleMetadata::deadline）排序的最早截止优先（EDF）调度器
+ *
+ * 运行队列是一个按截止时间排序的小顶堆。schedule 把协程放入堆中，并向执行器
+ * 投递一个“取任务”回调；回调真正执行时才取出截止时间最早的协程恢复。
+ * 因此执行器积压时，截止时间近的请求会越过排在前面、截止时间远的请求。
+ * 没有截止时间的请求排在所有带截止时间的请求之后，彼此之间按提交顺序执行。
+ *
+ * 截止时间来自 Task::with_deadline，随协程本地上下文传给被 co_await 的子任务，
+ * 任务的启动请求和每次挂起后的恢复请求都带着它。
+ *
+ * 已过截止时间的请求仍会被恢复（计入 RuntimeMetrics::expired），由任务自己
+ * 结束：在下一个 co_await 处抛出 OperationCancelledException，尚未开始执行的
+ * 任务不再执行函数体。这样挂起中的协程帧和它持有的资源都能正常释放。
+ *
+ * 带有线程亲和性（ScheduleMetadata::affinity）且执行器能够路由到该线程的请求
+ * 直接投递到目标线程，不参与排序。
+ *
+ * 使用示例：
+ * @code
+ * auto scheduler = std::make_shared<DeadlineScheduler>();
+ * SchedulerManager::set_default_scheduler(scheduler);
+ * auto task = handle(request);
+ * task.with_deadline(Clock::now() + 50ms);
+ * task.start();
+ * @endcode
+ */
+class DeadlineScheduler : public QueuedScheduler<details::DeadlineRunQueue> {
+ public:
+  DeadlineScheduler()
+      : DeadlineScheduler(std::make_shared<ThreadPoolExecutor>()) {}
+
+  explicit DeadlineScheduler(std::shared_ptr<AbstractExecutor> executor)
+      : QueuedScheduler(std::move(executor)) {}
+
+  /**
+   * @brief 队列中等待恢复的协程数量
+   */
+  size_t pending() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+  }
+};
+}  // namespace koroutine
@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+
+#include "koroutine/details/ring_queue.hpp"
+#include "koroutine/schedulers/queued_scheduler.hpp"
+namespace koroutine {
+namespace details {
+/**
+ * @brief PriorityScheduler 的运行队列：每个优先级一个环形队列
+ *
+ * 取出时用平滑加权轮询（smooth weighted round-robin）在非空队列之间选择。
+ */
+class PriorityRunQueue {
+ public:
+  static constexpr const char* kName = "PriorityScheduler";
+  static constexpr size_t kLevels = 3;
+  using Key = size_t;
+
+  /**
+   * @brief 各优先级的权重
+   * 所有队列都非空时，每 (low + normal + high) 次恢复中各级分别获得的次数。
+   * 权重为 0 时按 1 处理。
+   */
+  struct Weights {
+    unsigned low = 1;
+    unsigned normal = 4;
+    unsigned high = 16;
+  };
+
+  explicit PriorityRunQueue(Weights weights)
+      : _weights{std::max(weights.low, 1u), std::max(weights.normal, 1u),
+                 std::max(weights.high, 1u)} {}
+
+  static size_t level_of(ScheduleMetadata::Priority priority) {
+    return std::min(static_cast<size_t>(priority), kLevels - 1);
+  }
+
+  static Key key_of(const ScheduleMetadata& metadata) {
+    return level_of(metadata.priority);
+  }
+
+  void push(std::coroutine_handle<> handle, Key level) {
+    _queues[level].push(std::move(handle));
+  }
+
+  bool pop(std::coroutine_handle<>& handle, Key& level) {
+    level = pick_level();
+    if (level == kLevels) return false;
+    handle = _queues[level].pop();
+    return true;
+  }
+
+  void before_resume(const Key&) {}
+
+  void add_metrics(RuntimeMetrics&) const {}
+
+  size_t size(Key level) const { return _queues[level].size(); }
+
+ private:
+  // 平滑加权轮询：非空队列的 current 加上自身权重，选 current 最大者，
+  // 再减去本轮参与者的权重之和。空队列的 current 清零。
+  size_t pick_level() {
+    size_t best = kLevels;
+    unsigned total = 0;
+    for (size_t level = kLevels; level-- > 0;) {
+      if (_queues[level].empty()) {
+        _current[level] = 0;
+        continue;
+      }
+      _current[level] += static_cast<int>(_weights[level]);
+      total += _weights[level];
+      if (best == kLevels || _current[level] > _current[best]) best = level;
+    }
+    if (best != kLevels) _current[best] -= static_cast<int>(total);
+    return best;
+  }
+
+  std::array<unsigned, kLevels> _weights;
+  std::array<RingQueue<std::coroutine_handle<>>, kLevels> _queues;
+  std::array<int, kLevels> _current{};
+};
+}  // namespace details
+
+/**
+ * @brief 按 ScheduleMetadata::Priority 分级调度的调度器
+ *
+ * 每个优先级各有一个运行队列。schedule 把协程放入对应队列，并向执行器投递一个
+ * “取任务”回调；回调真正执行时，才用平滑加权轮询（smooth weighted
+ * round-robin）在非空队列之间选出下一个要恢复的协程。
+ *
+ * 因此执行器积压时，IO 完成、取消续体等高优先级请求会越过排在前面的批处理协程；
+ * 低优先级队列仍按权重获得执行机会，不会被饿死。
+ *
+ * 带有线程亲和性（ScheduleMetadata::affinity）且执行器能够路由到该线程的请求
+ * 直接投递到目标线程，不参与优先级排序。
+ *
+ * 使用示例：
+ * @code
+ * auto scheduler = std::make_shared<PriorityScheduler>();
+ * SchedulerManager::set_default_scheduler(scheduler);
+ * // 批处理协程主动降级
+ * co_await scheduler->dispatch_to(ScheduleMetadata::Priority::Low);
+ * @endcode
+ */
+class PriorityScheduler : public QueuedScheduler<details::PriorityRunQueue> {
+ public:
+  using Priority = ScheduleMetadata::Priority;
+  using Weights = details::PriorityRunQueue::Weights;
+
+  PriorityScheduler()
+      : PriorityScheduler(std::make_shared<ThreadPoolExecutor>()) {}
+
+  explicit PriorityScheduler(std::shared_ptr<AbstractExecutor> executor)
+      : PriorityScheduler(std::move(executor), Weights()) {}
+
+  /**
+   * @param executor 底层执行器
+   * @param weights 各优先级的调度权重
+   */
+  PriorityScheduler(std::shared_ptr<AbstractExecutor> executor,
+                    Weights weights)
+      : QueuedScheduler(std::move(executor), weights) {}
+
+  /**
+   * @brief 某一优先级队列中等待恢复的协程数量
+   */
+  size_t pending(Priority priority) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size(details::PriorityRunQueue::level_of(priority));
+  }
+};
+}  // namespace koroutine
@@ -1,4 +1,8 @@
 #pragma once
+#include <coroutine>
+#include <span>
+#include <vector>
+
 #include "koroutine/debug.h"
 #include "koroutine/executors/thread_pool_executor.h"
 #include "koroutine/schedulers/scheduler.h"
@@ -6,34 +10,112 @@ namespace koroutine {
 class SimpleScheduler : public AbstractScheduler {
  public:
   SimpleScheduler() : _executor(std::make_shared<ThreadPoolExecutor>()) {}
+
+  /**
+   * @brief 使用指定的执行器作为底层执行器
+   * @param executor 底层执行器，例如 WorkStealingExecutor
+   *
+   * 使用示例：
+   * @code
+   * auto scheduler = std::make_shared<SimpleScheduler>(
+   *     std::make_shared<WorkStealingExecutor>());
+   * SchedulerManager::set_default_scheduler(scheduler);
+   * @endcode
+   */
+  explicit SimpleScheduler(std::shared_ptr<AbstractExecutor> executor)
+      : _executor(std::move(executor)) {}
+
   ~SimpleScheduler() override { _executor->shutdown(); }
 
-  // 引入基类的 schedule(long long) 方法
+  // 引入基类的 schedule(request, delay) 及 awaitable 重载
   using AbstractScheduler::dispatch_to;
   using AbstractScheduler::schedule;
 
-  // 实现核心接口：调度 ScheduleRequest
-  void schedule(ScheduleRequest request, long long delay_ms = 0) override {
-    LOG_TRACE("SimpleScheduler::schedule - scheduling request with delay: ",
-              delay_ms);
+  bool owns_current_thread() const override {
+    return _executor->owns_current_thread();
+  }
 
+  RuntimeMetrics metrics() const override { return _executor->metrics(); }
+
+  // 实现核心接口：立即调度 ScheduleRequest
+  void schedule(ScheduleRequest request) override {
     if (!request) {
       LOG_ERROR("SimpleScheduler::schedule - invalid request (null handle)");
       return;
     }
 
     LOG_DEBUG("SimpleScheduler::schedule - request debug name: ",
-              request.metadata().debug_name);
-
-    if (delay_ms > 0) {
-      LOG_TRACE(
-          "SimpleScheduler::schedule - scheduling delayed request with delay: ",
-          delay_ms);
-      _executor->execute_delayed(
-          [req = std::move(request)]() mutable { req.resume(); }, delay_ms);
+              request.metadata().debug_name.view());
+
+    // 指定了线程亲和性时投递到该线程；执行器无法路由时退回普通队列
+    const auto& affinity = request.metadata().affinity;
+    if (affinity && _executor->execute_on(*affinity, request.handle())) {
+      return;
+    }
+    // 直接把协程句柄交给执行器，恢复路径上不产生堆分配
+    _executor->execute(request.handle());
+  }
+
+  // 准入控制交给执行器的有界队列；指定了线程亲和性的请求直接投递，不受限制
+  bool try_schedule(ScheduleRequest request) override {
+    if (!request) {
+      LOG_ERROR(
+          "SimpleScheduler::try_schedule - invalid request (null handle)");
+      return false;
+    }
+    const auto& affinity = request.metadata().affinity;
+    if (affinity && _executor->execute_on(*affinity, request.handle())) {
+      return true;
+    }
+    return _executor->try_execute(
+        request.handle(), admission_depth(_executor->queue_limit(),
+                                          request.metadata().priority));
+  }
+
+  bool has_capacity(ScheduleMetadata::Priority priority) const override {
+    return _executor->has_capacity(
+        admission_depth(_executor->queue_limit(), priority));
+  }
+
+  bool wait_for_capacity(std::coroutine_handle<> waiter) override {
+    return _executor->wait_for_capacity(waiter);
+  }
+
+  // 整批交给执行器；指定了线程亲和性的请求仍逐个路由
+  void schedule_bulk(std::span<ScheduleRequest> requests) override {
+    std::vector<std::coroutine_handle<>> handles;
+    handles.reserve(requests.size());
+    for (auto& request : requests) {
+      if (!request) {
+        LOG_ERROR(
+            "SimpleScheduler::schedule_bulk - invalid request (null handle)");
+        continue;
+      }
+      const auto& affinity = request.metadata().affinity;
+      if (affinity && _executor->execute_on(*affinity, request.handle())) {
+        continue;
+      }
+      handles.push_back(request.handle());
+    }
+    _executor->execute_bulk(handles);
+  }
+
+  // 实现核心接口：到达截止时间后调度
+  void schedule_at(ScheduleRequest request,
+                   Clock::time_point deadline) override {
+    if (!request) {
+      LOG_ERROR(
+          "SimpleScheduler::schedule_at - invalid request (null handle)");
+      return;
+    }
+
+    if (request.metadata().affinity) {
+      // 到期后重新走一次立即调度，以便投递到指定线程
+      _executor->execute_at([this, request]() { schedule(request); },
+                            deadline);
     } else {
-      _executor->execute(
-          [req = std::move(request)]() mutable { req.resume(); });
+      _executor->execute_at(
+          [handle = request.handle()]() { handle.resume(); }, deadline);
     }
   }
 
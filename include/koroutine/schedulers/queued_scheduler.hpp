@@ -0,0 +1,178 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+
+#include "koroutine/debug.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/schedulers/scheduler.h"
+namespace koroutine {
+/**
+ * @brief 自带运行队列的调度器的公共实现
+ *
+ * schedule 把协程按 Queue 给出的键放入调度器自己的运行队列，并向执行器投递
+ * 一个“取任务”回调；回调真正执行时才从队列里取出下一个要恢复的协程。
+ * 执行器积压时，恢复顺序因此由队列决定，而不是由提交顺序决定。带有线程
+ * 亲和性且执行器能够路由到该线程的请求直接投递到目标线程，不进入队列。
+ *
+ * 入队、批量提交、定时、准入控制和指标都在这里实现，排序策略由 Queue 提供。
+ * 除 before_resume 外，Queue 的成员都在持有调度器锁时调用：
+ * @code
+ * struct Queue {
+ *   static constexpr const char* kName;  // 日志中的调度器名
+ *   using Key = ...;                     // 排序键，入队时从元数据算出
+ *   static Key key_of(const ScheduleMetadata& metadata);
+ *   void push(std::coroutine_handle<> handle, Key key);
+ *   bool pop(std::coroutine_handle<>& handle, Key& key);  // 队列空时 false
+ *   void before_resume(const Key& key);         // 锁外，恢复协程之前
+ *   void add_metrics(RuntimeMetrics& out) const;
+ * };
+ * @endcode
+ *
+ * 队列是调度器的成员而不是派生类的成员：析构时先关闭执行器，仍在执行的
+ * 取任务回调结束之后队列才被销毁。
+ */
+template <typename Queue>
+class QueuedScheduler : public AbstractScheduler {
+ public:
+  using Key = typename Queue::Key;
+
+  /**
+   * @param executor 底层执行器
+   * @param args 转发给运行队列的构造参数
+   */
+  template <typename... Args>
+  explicit QueuedScheduler(std::shared_ptr<AbstractExecutor> executor,
+                           Args&&... args)
+      : _executor(std::move(executor)), _queue(std::forward<Args>(args)...) {}
+
+  ~QueuedScheduler() override { _executor->shutdown(); }
+
+  using AbstractScheduler::dispatch_to;
+  using AbstractScheduler::schedule;
+
+  bool owns_current_thread() const override {
+    return _executor->owns_current_thread();
+  }
+
+  // 每个排队的协程都对应执行器中的一个取任务回调，queued 已包含它们
+  RuntimeMetrics metrics() const override {
+    RuntimeMetrics out = _executor->metrics();
+    out.rejected += _rejected.load(std::memory_order_relaxed);
+    _queue.add_metrics(out);
+    return out;
+  }
+
+  void schedule(ScheduleRequest request) override {
+    if (!request) {
+      LOG_ERROR(Queue::kName, "::schedule - invalid request (null handle)");
+      return;
+    }
+
+    const auto& affinity = request.metadata().affinity;
+    if (!affinity || !_executor->execute_on(*affinity, request.handle())) {
+      enqueue(request.handle(), Queue::key_of(request.metadata()));
+    }
+  }
+
+  // 按优先级检查执行器的队列深度后再入队。检查与入队之间不加锁，并发
+  // 提交时队列可能略超出上限，超出量不超过同时提交的线程数
+  bool try_schedule(ScheduleRequest request) override {
+    if (!request) {
+      LOG_ERROR(Queue::kName,
+                "::try_schedule - invalid request (null handle)");
+      return false;
+    }
+    if (!has_capacity(request.metadata().priority)) {
+      _rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    schedule(std::move(request));
+    return true;
+  }
+
+  bool has_capacity(ScheduleMetadata::Priority priority) const override {
+    return _executor->has_capacity(
+        admission_depth(_executor->queue_limit(), priority));
+  }
+
+  bool wait_for_capacity(std::coroutine_handle<> waiter) override {
+    return _executor->wait_for_capacity(waiter);
+  }
+
+  // 亲和性请求先在锁外交给目标线程，不在调度器锁内再取执行器的锁；其余
+  // 请求在一次加锁内入队，对应的取任务回调也整批交给执行器，只加一次队列锁
+  void schedule_bulk(std::span<ScheduleRequest> requests) override {
+    for (auto& request : requests) {
+      if (!request) {
+        LOG_ERROR(Queue::kName,
+                  "::schedule_bulk - invalid request (null handle)");
+        continue;
+      }
+      const auto& affinity = request.metadata().affinity;
+      if (affinity && _executor->execute_on(*affinity, request.handle())) {
+        request = ScheduleRequest(nullptr);  // 已交出，不再入队
+      }
+    }
+    size_t queued = 0;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (auto& request : requests) {
+        if (!request) continue;
+        _queue.push(request.handle(), Queue::key_of(request.metadata()));
+        ++queued;
+      }
+    }
+    _executor->execute_bulk([this]() { run_next(); }, queued);
+  }
+
+  void schedule_at(ScheduleRequest request, Clock::time_point when) override {
+    if (!request) {
+      LOG_ERROR(Queue::kName, "::schedule_at - invalid request (null handle)");
+      return;
+    }
+
+    if (request.metadata().affinity) {
+      _executor->execute_at([this, request]() { schedule(request); }, when);
+    } else {
+      // 到期后再排队，排序键在提交时就已算出
+      _executor->execute_at(
+          [this, handle = request.handle(),
+           key = Queue::key_of(request.metadata())]() { enqueue(handle, key); },
+          when);
+    }
+  }
+
+ protected:
+  std::shared_ptr<AbstractExecutor> _executor;
+  mutable std::mutex _mutex;
+  Queue _queue;
+
+ private:
+  void enqueue(std::coroutine_handle<> handle, Key key) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _queue.push(handle, std::move(key));
+    }
+    // 每个入队的协程对应一次取任务回调，回调只捕获 this，不产生堆分配
+    _executor->execute([this]() { run_next(); });
+  }
+
+  void run_next() {
+    std::coroutine_handle<> handle;
+    Key key{};
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_queue.pop(handle, key)) return;
+    }
+    _queue.before_resume(key);
+    handle.resume();
+  }
+
+  std::atomic<uint64_t> _rejected{0};
+};
+}  // namespace koroutine
@@ -1,12 +1,42 @@
 #pragma once
 
+#include <chrono>
 #include <coroutine>
+#include <cstddef>
 #include <optional>
-#include <string>
+#include <string_view>
 #include <thread>
 
 namespace koroutine {
 
+/**
+ * @brief 调度请求的调试名称，只能由字符串字面量构造
+ *
+ * 只保存视图、不拷贝字符串，调度路径上不会发生堆分配。构造函数是 consteval，
+ * 保证视图指向静态存储：运行时拼出的 std::string 或 const char* 变量
+ * 无法传入，编译期即报错，而不会留下指向已销毁临时对象的视图。
+ */
+class DebugName {
+ public:
+  constexpr DebugName() noexcept = default;
+
+  template <std::size_t N>
+  consteval DebugName(const char (&literal)[N]) noexcept
+      : view_(literal, N - 1) {}
+
+  constexpr std::string_view view() const noexcept { return view_; }
+  constexpr bool empty() const noexcept { return view_.empty(); }
+  constexpr operator std::string_view() const noexcept { return view_; }
+
+  friend constexpr bool operator==(DebugName lhs,
+                                   std::string_view rhs) noexcept {
+    return lhs.view_ == rhs;
+  }
+
+ private:
+  std::string_view view_;
+};
+
 /**
  * @brief 调度元数据 - 提供调度策略的额外信息
  */
@@ -22,7 +52,9 @@ struct ScheduleMetadata {
 
   Priority priority = Priority::Normal;     ///< 任务优先级
   std::optional<std::thread::id> affinity;  ///< 线程亲和性（可选）
-  std::string debug_name;                   ///< 调试用名称（可选）
+  DebugName debug_name;                     ///< 调试用名称（可选，字符串字面量）
+  /// 所属任务的截止时间（可选），DeadlineScheduler 按它排序
+  std::optional<std::chrono::steady_clock::time_point> deadline;
 
   // 默认构造
   ScheduleMetadata() = default;
@@ -30,9 +62,9 @@ struct ScheduleMetadata {
   // 便捷构造：只设置优先级
   explicit ScheduleMetadata(Priority p) : priority(p) {}
 
-  // 便捷构造：设置优先级和调试名称
-  ScheduleMetadata(Priority p, std::string name)
-      : priority(p), debug_name(std::move(name)) {}
+  // 便捷构造：设置优先级和调试名称（只接受字符串字面量，见 DebugName）
+  ScheduleMetadata(Priority p, DebugName name)
+      : priority(p), debug_name(name) {}
 };
 
 /**
@@ -1,9 +1,16 @@
 #pragma once
+#include <algorithm>
+#include <chrono>
 #include <coroutine>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 
 #include "koroutine/debug.h"
+#include "koroutine/details/delay.hpp"
+#include "koroutine/queue_limit.h"
+#include "koroutine/runtime_metrics.h"
 #include "schedule_request.hpp"
 
 namespace koroutine {
@@ -11,6 +18,7 @@ namespace koroutine {
 // 前向声明
 class ScheduleAwaiter;
 class DispatchAwaiter;
+class AdmitAwaiter;
 
 /**
  * @brief 抽象调度器接口
@@ -22,12 +30,124 @@ class AbstractScheduler
  public:
   virtual ~AbstractScheduler() = default;
 
+  using Clock = std::chrono::steady_clock;
+
   /**
-   * @brief 调度协程句柄（核心接口）
+   * @brief 立即调度协程句柄（核心接口）
    * @param request 调度请求，包含协程句柄和元数据
+   */
+  virtual void schedule(ScheduleRequest request) = 0;
+
+  /**
+   * @brief 在截止时间到达后调度协程句柄（核心接口）
+   * @param request 调度请求
+   * @param deadline 截止时间，已过去时尽快执行
+   */
+  virtual void schedule_at(ScheduleRequest request,
+                           Clock::time_point deadline) = 0;
+
+  /**
+   * @brief 批量立即调度（扇出场景）
+   * @param requests 调度请求，调用后其中的请求可能已被移走
+   *
+   * 默认逐个调用 schedule()。基于执行器的调度器把整批交给
+   * AbstractExecutor::execute_bulk，只加一次锁、最多唤醒与批次大小
+   * 相同数量的空闲线程。
+   */
+  virtual void schedule_bulk(std::span<ScheduleRequest> requests) {
+    for (auto& request : requests) schedule(std::move(request));
+  }
+
+  /**
+   * @brief 准入控制：运行队列有空位时调度一个新协程，否则立即拒绝
+   * @return false 表示被拒绝，协程没有入队，由调用方决定如何处理
+   * （销毁任务、返回 503 等）
+   *
+   * 只用于接纳新工作；已在运行的协程仍经由 schedule() 恢复，不受容量限制。
+   * 默认（队列无界）总是接受。
+   */
+  virtual bool try_schedule(ScheduleRequest request) {
+    schedule(std::move(request));
+    return true;
+  }
+
+  /**
+   * @brief 当前能否接纳给定优先级的新工作（不预留位置）
+   */
+  virtual bool has_capacity(ScheduleMetadata::Priority priority) const {
+    (void)priority;
+    return true;
+  }
+
+  /**
+   * @brief OverflowPolicy::Block 下，队列满时挂起 waiter，腾出空位后恢复它
+   * @return false 表示没有挂起（有空位或策略不阻塞），调用方继续执行
+   */
+  virtual bool wait_for_capacity(std::coroutine_handle<> waiter) {
+    (void)waiter;
+    return false;
+  }
+
+  /**
+   * @brief 返回一个 awaitable，在接纳新工作之前做背压
+   * @return AdmitAwaiter，co_await 的结果为 true 表示可以提交新工作
+   *
+   * 队列有空位时不挂起并返回 true；满了时按 OverflowPolicy 处理：
+   * Block 挂起当前协程直到有空位，Reject / ShedLowest 立即返回 false。
+   *
+   * 使用示例：
+   * @code
+   * while (running) {
+   *   bool admitted = co_await scheduler->admit();
+   *   auto conn = co_await listener->accept();
+   *   if (!admitted) { co_await conn->close(); continue; }
+   *   Runtime::spawn(handle(conn));
+   * }
+   * @endcode
+   */
+  AdmitAwaiter admit(
+      ScheduleMetadata::Priority priority = ScheduleMetadata::Priority::Normal);
+
+  /**
+   * @brief 延迟调度协程句柄
+   * @param delay 延迟时间，支持微秒级精度；不大于 0 时立即执行
+   */
+  void schedule(ScheduleRequest request, std::chrono::nanoseconds delay) {
+    if (delay <= std::chrono::nanoseconds::zero()) {
+      schedule(std::move(request));
+    } else {
+      schedule_at(std::move(request),
+                  Clock::now() + details::clamp_delay(delay));
+    }
+  }
+
+  /**
+   * @brief 延迟调度协程句柄
    * @param delay_ms 延迟时间（毫秒），0表示立即执行
    */
-  virtual void schedule(ScheduleRequest request, long long delay_ms = 0) = 0;
+  void schedule(ScheduleRequest request, long long delay_ms) {
+    if (delay_ms <= 0) {
+      schedule(std::move(request));
+    } else {
+      schedule(std::move(request), details::delay_from_ms(delay_ms));
+    }
+  }
+
+  /**
+   * @brief 当前线程是否由该调度器驱动
+   *
+   * 返回 true 时，调用方可以直接在当前线程上恢复属于该调度器的协程（对称转移），
+   * 不必再经过一次入队。默认返回 false，即总是经由 schedule() 恢复。
+   */
+  virtual bool owns_current_thread() const { return false; }
+
+  /**
+   * @brief 运行指标快照：队列深度、待触发的定时器、工作线程忙/闲时间、
+   * 调度到开始执行的延迟直方图
+   *
+   * 基于执行器的调度器返回底层执行器的 metrics()；默认返回全零。
+   */
+  virtual RuntimeMetrics metrics() const { return {}; }
 
   /**
    * @brief 返回一个awaitable，用于延迟执行
@@ -41,16 +161,50 @@ class AbstractScheduler
    */
   ScheduleAwaiter schedule(long long delay_ms);
 
+  /**
+   * @brief 返回一个awaitable，用于微秒级延迟执行
+   *
+   * @code
+   * co_await scheduler->schedule(250us);
+   * @endcode
+   */
+  ScheduleAwaiter schedule(std::chrono::nanoseconds delay);
+
   /**
    * @brief 返回一个awaitable，用于切换到此调度器
+   * @param priority 恢复请求的优先级，支持优先级的调度器（如
+   * PriorityScheduler）据此决定执行顺序
    * @return DispatchAwaiter 可以被 co_await 的对象
    *
    * 使用示例：
    * @code
    * co_await scheduler->dispatch_to();  // 切换到这个调度器执行
+   * co_await scheduler->dispatch_to(ScheduleMetadata::Priority::Low);
    * @endcode
    */
-  DispatchAwaiter dispatch_to();
+  DispatchAwaiter dispatch_to(
+      ScheduleMetadata::Priority priority = ScheduleMetadata::Priority::Normal);
+
+ protected:
+  /**
+   * @brief 给定优先级的新工作最多允许排到的队列深度
+   *
+   * 无界时为 SIZE_MAX。ShedLowest 下低优先级先被拒绝：Low 只能用到容量的
+   * 一半，Normal 到四分之三，High 可以用满；其他策略各级都是容量本身。
+   */
+  static size_t admission_depth(const QueueLimit& limit,
+                                ScheduleMetadata::Priority priority) {
+    if (!limit.bounded()) return SIZE_MAX;
+    if (limit.policy != OverflowPolicy::ShedLowest) return limit.capacity;
+    switch (priority) {
+      case ScheduleMetadata::Priority::Low:
+        return std::max<size_t>(1, limit.capacity / 2);
+      case ScheduleMetadata::Priority::Normal:
+        return std::max<size_t>(1, limit.capacity * 3 / 4);
+      default:
+        return limit.capacity;
+    }
+  }
 };
 
 }  // namespace koroutine
@@ -62,11 +216,22 @@ namespace koroutine {
 
 // 实现成员函数
 inline ScheduleAwaiter AbstractScheduler::schedule(long long delay_ms) {
-  return ScheduleAwaiter(shared_from_this(), delay_ms);
+  return ScheduleAwaiter(this, details::delay_from_ms(delay_ms));
+}
+
+inline ScheduleAwaiter AbstractScheduler::schedule(
+    std::chrono::nanoseconds delay) {
+  return ScheduleAwaiter(this, delay);
+}
+
+inline DispatchAwaiter AbstractScheduler::dispatch_to(
+    ScheduleMetadata::Priority priority) {
+  return DispatchAwaiter(this, priority);
 }
 
-inline DispatchAwaiter AbstractScheduler::dispatch_to() {
-  return DispatchAwaiter(shared_from_this());
+inline AdmitAwaiter AbstractScheduler::admit(
+    ScheduleMetadata::Priority priority) {
+  return AdmitAwaiter(this, priority);
 }
 
 }  // namespace koroutine
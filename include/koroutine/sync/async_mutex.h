@@ -22,19 +22,27 @@ class AsyncMutex {
     LockAwaiter(const LockAwaiter&) = delete;
     LockAwaiter& operator=(const LockAwaiter&) = delete;
 
+    // Uncontended: take the lock without suspending
+    bool try_complete_inline() override {
+      if (!mutex->try_lock()) return false;
+      owns_mutex_on_resume = true;
+      this->_result = Result<void>();
+      return true;
+    }
+
     // When suspended, try to acquire or enqueue
     void after_suspend() override {
       std::unique_lock<std::mutex> lk(mutex->internal_mutex);
       if (!mutex->_locked) {
-        // acquire immediately and resume
+        // released since try_complete_inline: acquire and resume
         mutex->_locked = true;
         owns_mutex_on_resume = true;
         lk.unlock();
-        // resume the awaiting coroutine immediately
         this->resume();
         return;
       }
       // otherwise enqueue
+      queued = true;
       mutex->waiters.push_back(this);
     }
 
@@ -42,14 +50,16 @@ class AsyncMutex {
         override { /* ownership is indicated by owns_mutex_on_resume */ }
 
     ~LockAwaiter() {
-      // remove from waiters if still enqueued
-      if (mutex) {
+      // remove from waiters if still enqueued; only a destroyed suspended
+      // coroutine can get here with queued set
+      if (mutex && queued) {
         std::lock_guard<std::mutex> lk(mutex->internal_mutex);
         mutex->waiters.remove(this);
       }
     }
 
     bool owns_mutex_on_resume;
+    bool queued = false;  // guarded by mutex->internal_mutex
     AsyncMutex* mutex;
   };
 
@@ -78,6 +88,7 @@ class AsyncMutex {
       if (!waiters.empty()) {
         next = waiters.front();
         waiters.pop_front();
+        next->queued = false;
       } else {
         _locked = false;
       }
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
 #include "coroutine_common.h"
 #include "scheduler_manager.h"
 #include "task_promise.hpp"
@@ -143,39 +148,164 @@ class TaskBase {
    * token.cancel();
    * @endcode
    */
-  Derived& with_cancellation(CancellationToken token) {
+  Derived& with_cancellation(const CancellationToken& token) {
     LOG_TRACE("Task::with_cancellation - setting cancellation token");
     handle_.promise().set_cancellation_token(token);
     return static_cast<Derived&>(*this);
   }
 
+  /**
+   * @brief 设置截止时间
+   * @param deadline 只能提前，不能推迟从父任务继承来的截止时间
+   * @return 返回任务自身以支持链式调用
+   *
+   * 截止时间随任务的调度请求交给调度器（ScheduleMetadata::deadline），
+   * DeadlineScheduler 按它排序，被 co_await 的子任务也继承它。
+   * 过了截止时间，任务在下一个 co_await 处抛出 OperationCancelledException；
+   * 还没开始执行的任务不再执行函数体。必须在 start() 之前调用。
+   */
+  Derived& with_deadline(std::chrono::steady_clock::time_point deadline) {
+    handle_.promise().set_deadline(deadline);
+    return static_cast<Derived&>(*this);
+  }
+
+  /**
+   * @brief 注册结束钩子，任务执行完毕（is_done() 为 true）后调用一次
+   * @param hook 在完成任务的线程上调用，可以在其中销毁本任务；
+   *             钩子对象必须活到被调用为止
+   *
+   * 必须在 start() 之前注册。用于 TaskManager 这类需要在任务结束时
+   * 立即得到通知、而不是轮询 is_done() 的场景。
+   */
+  Derived& on_finished(FinishHook* hook) {
+    handle_.promise().set_finish_hook(hook);
+    return static_cast<Derived&>(*this);
+  }
+
   void start() {
+    auto* scheduler = claim_start();
+    if (!scheduler) return;
+    LOG_TRACE("Task::start - starting task with scheduler, handle: ",
+              handle_.address());
+
+    // 使用 ScheduleRequest 调度协程
+    scheduler->schedule(start_request(), 0);
+  }
+
+  /**
+   * @brief 启动并分离任务，任务结束后自行销毁协程帧
+   *
+   * 先标记分离再启动：任务在 start() 返回之前就结束时，协程帧也能被回收，
+   * 而 start() 之后再 detach() 的写法会把它泄漏掉。
+   */
+  void start_detached() {
+    if (!handle_) return;
+    handle_.promise().set_detached(true);
+    start();
+    handle_ = nullptr;
+  }
+
+  /**
+   * @brief 经过准入控制启动任务
+   * @return false 表示调度器的运行队列已满（见 AbstractScheduler::try_schedule），
+   * 任务没有启动，可以稍后重试或直接销毁
+   */
+  bool try_start() {
+    auto* scheduler = claim_start();
+    if (!scheduler) return false;
+    if (scheduler->try_schedule(start_request())) return true;
+    LOG_DEBUG("Task::try_start - refused by admission control, handle: ",
+              handle_.address());
+    handle_.promise().clear_started();
+    return false;
+  }
+
+  /**
+   * @brief 经过准入控制启动并分离任务
+   * @return false 表示任务被拒绝：没有启动，也没有分离，仍由本对象持有
+   *
+   * 与 start_detached() 一样先标记分离再提交，避免任务在别的线程上跑完
+   * 之后才写入分离标记。
+   */
+  bool try_start_detached() {
+    if (!handle_) return false;
+    handle_.promise().set_detached(true);
+    if (!try_start()) {
+      handle_.promise().set_detached(false);
+      return false;
+    }
+    handle_ = nullptr;
+    return true;
+  }
+
+  /**
+   * @brief 批量启动任务（扇出场景）
+   * @param tasks 任务，或指向任务的（智能）指针组成的范围
+   *
+   * 相邻且属于同一调度器的任务合并为一次 schedule_bulk：整批只加一次
+   * 队列锁，最多唤醒与批次大小相同数量的空闲线程，而不是每个任务
+   * 各加一次锁、各唤醒一次。已启动的任务被跳过。
+   */
+  template <typename Range>
+  static void start_all(Range&& tasks) {
+    std::vector<ScheduleRequest> batch;
+    if constexpr (std::ranges::sized_range<Range>) {
+      batch.reserve(std::ranges::size(tasks));
+    }
+    AbstractScheduler* batch_scheduler = nullptr;
+    auto flush = [&] {
+      if (!batch.empty()) batch_scheduler->schedule_bulk(batch);
+      batch.clear();
+    };
+
+    for (auto&& item : tasks) {
+      TaskBase* task = nullptr;
+      if constexpr (std::is_base_of_v<TaskBase,
+                                      std::remove_cvref_t<decltype(item)>>) {
+        task = &item;
+      } else {
+        task = &*item;
+      }
+      auto* scheduler = task->claim_start();
+      if (!scheduler) continue;
+      if (scheduler != batch_scheduler) {
+        flush();
+        batch_scheduler = scheduler;
+      }
+      batch.push_back(task->start_request());
+    }
+    flush();
+  }
+
+  bool is_done() const { return !handle_ || handle_.done(); }
+
+ protected:
+  handle_type handle_;
+
+ private:
+  // 标记为已启动并返回要投递到的调度器；任务已启动时返回空
+  AbstractScheduler* claim_start() {
     // 防止重复启动
     if (handle_.promise().is_started()) {
       LOG_ERROR("Task::start - task already started, ignoring duplicate start");
-      return;
+      return nullptr;
     }
     handle_.promise().set_started();
 
-    std::shared_ptr<AbstractScheduler> scheduler =
-        handle_.promise().get_scheduler().lock();
+    auto* scheduler = handle_.promise().get_scheduler();
     if (!scheduler) {
       LOG_WARN("Task::start - no scheduler set, using default scheduler");
-      scheduler = SchedulerManager::get_default_scheduler();
-      handle_.promise().set_scheduler(scheduler);
+      handle_.promise().bind_current_scheduler();
+      scheduler = handle_.promise().get_scheduler();
     }
-    LOG_TRACE("Task::start - starting task with scheduler, handle: ",
-              handle_.address());
+    return scheduler;
+  }
 
-    // 使用 ScheduleRequest 调度协程
+  ScheduleRequest start_request() const {
     ScheduleMetadata meta(ScheduleMetadata::Priority::Normal, "task_start");
-    scheduler->schedule(ScheduleRequest(handle_, std::move(meta)), 0);
+    meta.deadline = handle_.promise().deadline();
+    return ScheduleRequest(handle_, std::move(meta));
   }
-
-  bool is_done() const { return !handle_ || handle_.done(); }
-
- protected:
-  handle_type handle_;
 };
 
 // 通用模板 - 非 void 类型
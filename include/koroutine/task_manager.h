@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -17,15 +18,64 @@ namespace koroutine {
  */
 class TaskManager {
  private:
-  struct TaskEntry {
+  struct Group;
+  class JoinAwaiter;
+
+  // The FinishHook base is what the task calls back when it finishes
+  struct TaskEntry : FinishHook {
     std::shared_ptr<Task<void>> task;
-    CancellationTokenSource cts;
     std::string name;
+    // Back references used by the finish callback to unlink this entry in O(1)
+    TaskManager* manager = nullptr;
+    Group* group = nullptr;
+    std::list<TaskEntry>::iterator self;
+  };
+
+  struct Group {
+    // Unfinished tasks; an entry unlinks itself when its task finishes
+    std::list<TaskEntry> tasks;
+    // Shared by every task in the group. Each task's promise registers an
+    // intrusive callback on it and drops it in O(1) when the task finishes,
+    // so submitting a task allocates nothing for cancellation
+    CancellationTokenSource cts;
+    // Joins waiting for this group to become empty
+    std::vector<JoinAwaiter*> waiters;
   };
 
-  // Protects groups_ and is_shutdown_
+  /**
+   * @brief Suspends until a group (or every group) has no unfinished tasks.
+   *
+   * Registered in the group's waiter list and resumed by the finish callback
+   * of the last task, so a join wakes as soon as the work is done.
+   */
+  class JoinAwaiter : public AwaiterBase<void> {
+   public:
+    JoinAwaiter(TaskManager* manager, std::string name)
+        : manager_(manager), name_(std::move(name)) {}
+
+   protected:
+    bool try_complete_inline() override;
+    void after_suspend() override;
+
+   private:
+    friend class TaskManager;
+    TaskManager* manager_;
+    std::string name_;
+  };
+
+  static void on_task_finished(FinishHook* hook);
+  // Caller holds mtx_; adds task to group and installs its token and hook
+  void register_locked(Group& group, const std::string& name,
+                       const std::shared_ptr<Task<void>>& task);
+  // Caller holds mtx_; true when the group (empty name: all groups) is empty
+  bool is_idle_locked(const std::string& name) const;
+
+  // Protects groups_, all_waiters_, active_ and is_shutdown_
   mutable std::mutex mtx_;
-  std::unordered_map<std::string, std::vector<TaskEntry>> groups_;
+  std::unordered_map<std::string, Group> groups_;
+  // Joins on every group, woken when active_ drops to zero
+  std::vector<JoinAwaiter*> all_waiters_;
+  size_t active_ = 0;
   bool is_shutdown_ = false;
 
  public:
@@ -34,10 +84,22 @@ class TaskManager {
   /**
    * @brief Submit a task to a named group, the task will start immediately
    * @param name The name of the task group
-   * @param task The task to be submitted
+   * @param task The task to be submitted, must not have been started yet
+   *
+   * The manager drops its reference as soon as the task finishes.
    */
   virtual void submit_to_group(const std::string& name,
                                std::shared_ptr<Task<void>> task);
+  /**
+   * @brief Submit a batch of tasks to a named group and start them together
+   * @param name The name of the task group
+   * @param tasks Tasks that have not been started yet
+   *
+   * Registers the whole batch under one lock and starts it with
+   * Task::start_all, so fanning out many tasks enqueues them in one go.
+   */
+  virtual void submit_all_to_group(
+      const std::string& name, std::vector<std::shared_ptr<Task<void>>> tasks);
   /**
    * @brief Wait for all tasks in a named group to complete
    * @param name The name of the task group
@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <list>
-#include <mutex>
+#include <memory>
 #include <optional>
+#include <utility>
 
 #include "awaiters/awaiter.hpp"
 #include "awaiters/sleep_awaiter.hpp"
 #include "awaiters/task_awaiter.hpp"
 #include "cancellation.hpp"
 #include "coroutine_common.h"
+#include "coroutine_local.hpp"
+#include "details/coop_budget.hpp"
+#include "details/frame_allocator.hpp"
 #include "scheduler_manager.h"
 
 namespace koroutine {
@@ -22,32 +27,98 @@ class TaskBase;
 template <typename ResultType>
 class Task;
 
+/**
+ * @brief 任务结束钩子
+ *
+ * 嵌入到关心任务结束的对象中（通常作为基类），通过 Task::on_finished 注册。
+ * 回调收到的就是注册时的钩子指针，可以据此还原出外层对象，
+ * promise 只需保存一个指针。
+ */
+struct FinishHook {
+  void (*on_finished)(FinishHook*) = nullptr;
+};
+
 // CRTP 基类 - Derived 是派生类 (TaskPromise<ResultType>)
+// 取消回调节点作为基类嵌入：设置取消令牌不分配内存，任务结束时 O(1) 注销
 template <typename ResultType, typename Derived>
-struct TaskPromiseBase {
-  auto initial_suspend() {
+struct TaskPromiseBase : protected details::CancellationNode {
+#ifndef KOROUTINE_NO_FRAME_POOL
+  // 协程帧从线程本地的分级空闲链表分配，避免 spawn/完成路径上的 malloc 竞争
+  static void* operator new(std::size_t size) {
+    return details::FrameAllocator::allocate(size);
+  }
+
+  static void operator delete(void* ptr, std::size_t size) noexcept {
+    details::FrameAllocator::deallocate(ptr, size);
+  }
+#endif
+
+  // 启动时已过截止时间的任务不执行函数体：await_resume 抛出的异常由
+  // unhandled_exception 接住，任务直接以 OperationCancelledException 结束
+  struct InitialAwaiter {
+    const TaskPromiseBase& promise;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    void await_resume() const {
+      if (promise.expired()) {
+        LOG_WARN("TaskPromise::initial_suspend - deadline exceeded");
+        throw OperationCancelledException();
+      }
+    }
+  };
+
+  InitialAwaiter initial_suspend() {
     LOG_TRACE("TaskPromise::initial_suspend - suspending initially");
-    return std::suspend_always{};
+    return InitialAwaiter{*this};
   }
 
   struct FinalAwaiter {
     bool detached;
     std::coroutine_handle<> continuation;
-    std::weak_ptr<AbstractScheduler> scheduler;
-
-    bool await_ready() const noexcept { return detached; }
-
-    void await_suspend(std::coroutine_handle<>) const noexcept {
+    AbstractScheduler* scheduler;
+    FinishHook* finish_hook;
+    std::optional<AbstractScheduler::Clock::time_point> deadline;
+
+    // 分离且没有结束钩子的任务不挂起，协程帧随之自动销毁
+    bool await_ready() const noexcept { return detached && !finish_hook; }
+
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<> self) const noexcept {
+      if (detached) {
+        // 分离任务没有 continuation：先销毁自己的协程帧（本 awaiter
+        // 也在其中），再调用钩子，钩子返回时任务已经不占任何资源
+        auto* hook = finish_hook;
+        self.destroy();
+        hook->on_finished(hook);
+        return std::noop_coroutine();
+      }
+      // 先取出钩子：continuation 一旦交给其他线程，可能在本函数返回前
+      // 就结束并销毁本任务（连同本 awaiter 所在的协程帧）
+      auto* hook = finish_hook;
+      std::coroutine_handle<> next = std::noop_coroutine();
       if (continuation) {
-        auto sched = scheduler.lock();
-        if (sched) {
+        // 当前线程就属于该调度器时直接对称转移到 continuation，嵌套的
+        // co_await 链逐层返回时不再入队。编译器不一定把转移生成尾调用，
+        // 因此与 TaskAwaiter 一样消耗协作预算，预算用完时改为入队，
+        // 调用栈最多随预算增长
+        if (scheduler && scheduler->owns_current_thread() &&
+            details::CoopBudget::consume()) {
+          next = continuation;
+        } else {
           ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
                                 "continuation_final");
-          sched->schedule(ScheduleRequest(continuation, std::move(meta)), 0);
-        } else {
-          continuation.resume();
+          // 默认留在当前工作线程上恢复，子任务刚写入的结果仍在缓存中
+          meta.affinity = std::this_thread::get_id();
+          meta.deadline = deadline;
+          auto* target =
+              scheduler ? scheduler : SchedulerManager::current_scheduler();
+          target->schedule(ScheduleRequest(continuation, std::move(meta)), 0);
         }
       }
+      // 回调可能销毁任务本身（连同本 awaiter 所在的协程帧），必须最后调用
+      if (hook) hook->on_finished(hook);
+      return next;
     }
 
     void await_resume() const noexcept {}
@@ -66,7 +137,8 @@ struct TaskPromiseBase {
           "TaskPromise::final_suspend - task is not detached, will resume "
           "continuation if any");
     }
-    return FinalAwaiter{detached_, continuation_, scheduler};
+    return FinalAwaiter{detached_, continuation_, scheduler, finish_hook_,
+                        deadline()};
   }
 
   void set_detached(bool detached) { detached_ = detached; }
@@ -74,22 +146,86 @@ struct TaskPromiseBase {
   template <typename _ResultType>
   TaskAwaiter<_ResultType> await_transform(Task<_ResultType>&& task) {
     LOG_TRACE("TaskPromise::await_transform - transforming Task<_ResultType>");
+    // 子任务继承协程本地变量：共享同一个上下文，写入时各自复制
+    task.handle_.promise().inherit_locals(locals_);
     auto awaiter = TaskAwaiter<_ResultType>{std::move(task)};
-    awaiter.install_scheduler(scheduler.lock());
+    install(awaiter);
     return awaiter;
   }
 
   template <typename _Rep, typename _Period>
   auto await_transform(std::chrono::duration<_Rep, _Period>&& duration) {
-    long long delay_ms =
-        std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-    LOG_TRACE("TaskPromise::await_transform - transforming sleep duration: ",
-              delay_ms, " ms");
-    auto awaiter = SleepAwaiter(delay_ms);
-    awaiter.install_scheduler(scheduler.lock());
+    LOG_TRACE("TaskPromise::await_transform - transforming sleep duration");
+    auto awaiter = SleepAwaiter(duration);
+    install(awaiter);
     return awaiter;
   }
 
+  // 协程本地变量的读写不挂起，一次下标访问
+  template <typename T>
+  auto await_transform(LocalGet<T>&& op) {
+    const void* value = locals_ ? locals_->get(op.key.index()) : nullptr;
+    return details::ReadyValue<const T*>{static_cast<const T*>(value)};
+  }
+
+  template <typename T>
+  std::suspend_never await_transform(LocalSet<T>&& op) {
+    if (op.value) {
+      locals_ = details::LocalContext::writable(locals_);
+      locals_->set(op.key.index(), std::move(*op.value));
+    } else if (locals_ && locals_->get(op.key.index())) {
+      locals_ = details::LocalContext::writable(locals_);
+      locals_->reset(op.key.index());
+    }
+    return {};
+  }
+
+  auto await_transform(details::CurrentLocals&&) {
+    return details::ReadyValue<details::LocalContext*>{locals_};
+  }
+
+  /**
+   * @brief 共享另一个任务的协程本地变量（包括截止时间），在任务启动前调用
+   * @param locals 可以为空，表示没有任何变量
+   *
+   * 本任务启动前已经有自己的上下文时（如调用过 with_deadline）两者合并，
+   * 本任务自己的值优先，截止时间取较早的一个。
+   */
+  void inherit_locals(details::LocalContext* locals) {
+    if (!locals || locals == locals_) return;
+    if (locals_) {
+      locals_ = details::LocalContext::merge(*locals, locals_);
+      return;
+    }
+    locals->add_ref();
+    locals_ = locals;
+  }
+
+  /**
+   * @brief 设置截止时间，在任务启动前调用
+   *
+   * 只能提前：从父任务继承来的截止时间更早时保持不变。
+   */
+  void set_deadline(AbstractScheduler::Clock::time_point deadline) {
+    if (locals_ && locals_->deadline() <= deadline) return;
+    locals_ = details::LocalContext::writable(locals_);
+    locals_->set_deadline(deadline);
+  }
+
+  std::optional<AbstractScheduler::Clock::time_point> deadline() const {
+    if (!locals_ ||
+        locals_->deadline() == AbstractScheduler::Clock::time_point::max()) {
+      return std::nullopt;
+    }
+    return locals_->deadline();
+  }
+
+  bool expired() const {
+    return locals_ &&
+           locals_->deadline() != AbstractScheduler::Clock::time_point::max() &&
+           AbstractScheduler::Clock::now() >= locals_->deadline();
+  }
+
   template <typename AwaiterImpl>
     requires AwaiterImplRestriction<AwaiterImpl,
                                     typename AwaiterImpl::ResultType>
@@ -98,13 +234,10 @@ struct TaskPromiseBase {
         "TaskPromise::await_transform - installing scheduler and checking "
         "cancellation");
 
-    // 检查取消状态
-    if (cancel_token_ && cancel_token_->is_cancelled()) {
-      LOG_WARN("TaskPromise::await_transform - operation cancelled");
-      throw OperationCancelledException();
-    }
+    // 检查取消状态和截止时间
+    throw_if_cancelled();
 
-    awaiter.install_scheduler(scheduler.lock());
+    install(awaiter);
     return std::move(awaiter);
   }
 
@@ -114,29 +247,62 @@ struct TaskPromiseBase {
   Awaitable&& await_transform(Awaitable&& awaitable) {
     LOG_TRACE("TaskPromise::await_transform - generic awaitable");
 
-    // 检查取消状态
-    if (cancel_token_ && cancel_token_->is_cancelled()) {
-      LOG_WARN("TaskPromise::await_transform - operation cancelled");
-      throw OperationCancelledException();
-    }
+    // 检查取消状态和截止时间
+    throw_if_cancelled();
 
     return std::forward<Awaitable>(awaitable);
   }
 
   void unhandled_exception() {
-    {
-      std::lock_guard lock(completion_lock);
-      result = Result<ResultType>(std::current_exception());
-      completion.notify_all();
+    finish(Result<ResultType>(std::current_exception()));
+  }
+
+ private:
+  // 任务被取消或已过截止时间时，在 co_await 处抛出 OperationCancelledException
+  void throw_if_cancelled() const {
+    if (cancel_state_ && cancel_state_->is_cancelled()) {
+      LOG_WARN("TaskPromise::await_transform - operation cancelled");
+      throw OperationCancelledException();
     }
+    if (expired()) {
+      LOG_WARN("TaskPromise::await_transform - deadline exceeded");
+      throw OperationCancelledException();
+    }
+  }
+
+  // 把调度器和截止时间交给 awaiter，恢复请求带着截止时间入队
+  template <typename Awaiter>
+  void install(Awaiter& awaiter) const {
+    awaiter.install_scheduler(scheduler);
+    awaiter.install_deadline(deadline());
+  }
+
+ public:
+
+  /**
+   * @brief 把协程绑定到指定调度器
+   *
+   * 只记录裸指针，不持有所有权：调用者必须让调度器活过本协程（直到协程帧
+   * 销毁）。不提供 shared_ptr 重载，传入 make_shared 的临时对象会在语句
+   * 结束时被释放；调用处写 .get() 表明所有权留在调用者手里。
+   */
+  void set_scheduler(AbstractScheduler* ex) {
+    release_default_binding();
+    scheduler = ex;
   }
 
-  void set_scheduler(std::shared_ptr<AbstractScheduler> ex) { scheduler = ex; }
+  // 改绑到当前线程的默认调度器（见 SchedulerManager::bind_current_scheduler）
+  void bind_current_scheduler() {
+    release_default_binding();
+    scheduler = SchedulerManager::bind_current_scheduler(bound_default_);
+  }
 
   bool is_started() const { return started; }
   void set_started() { started = true; }
+  // 启动被准入控制拒绝时撤销，任务可以重试或直接销毁
+  void clear_started() { started = false; }
 
-  std::weak_ptr<AbstractScheduler> get_scheduler() { return scheduler; }
+  AbstractScheduler* get_scheduler() const { return scheduler; }
 
   /**
    * @brief 设置 continuation - 当前任务完成后要恢复的协程
@@ -148,6 +314,15 @@ struct TaskPromiseBase {
     continuation_ = handle;
   }
 
+  /**
+   * @brief 设置结束钩子
+   * @param hook 协程到达 final suspend 点（handle.done() 已为 true）后调用
+   *
+   * 钩子在完成任务的线程上调用，此后不再访问协程帧，因此回调里可以销毁任务。
+   * 分离（detach）的任务在调用钩子之前已经销毁了自己的协程帧。
+   */
+  void set_finish_hook(FinishHook* hook) { finish_hook_ = hook; }
+
   /**
    * @brief 设置取消令牌
    * @param token 取消令牌
@@ -155,51 +330,17 @@ struct TaskPromiseBase {
    * 当令牌被取消时，任务会在下一个 co_await 点检查并抛出
    * OperationCancelledException。
    */
-  void set_cancellation_token(CancellationToken token) {
+  void set_cancellation_token(const CancellationToken& token) {
     LOG_TRACE(
         "TaskPromise::set_cancellation_token - setting cancellation token");
-    cancel_token_ = token;
-
-    // 注册取消回调
-    // 注意：使用 weak reference 避免循环引用和生命周期问题
-    auto weak_scheduler = scheduler;
-    auto continuation_handle = &continuation_;
-    auto result_ptr = &result;
-    auto lock_ptr = &completion_lock;
-    auto cv_ptr = &completion;
-
-    token.on_cancel([weak_scheduler, continuation_handle, result_ptr, lock_ptr,
-                     cv_ptr]() {
-      LOG_INFO("TaskPromise - cancellation requested");
-      // 设置异常结果
-      {
-        std::lock_guard lock(*lock_ptr);
-        if (!result_ptr->has_value()) {
-          *result_ptr = Result<ResultType>(
-              std::make_exception_ptr(OperationCancelledException()));
-          cv_ptr->notify_all();
-        }
-      }
-
-      // 如果有 continuation，立即恢复（让它处理取消）
-      if (*continuation_handle) {
-        auto sched = weak_scheduler.lock();
-        if (sched) {
-          sched->schedule(
-              ScheduleRequest(*continuation_handle,
-                              ScheduleMetadata(ScheduleMetadata::Priority::High,
-                                               "cancellation_continuation")),
-              0);
-        } else {
-          LOG_ERROR(
-              "TaskPromise - cancellation: no scheduler available to resume "
-              "continuation");
-          // 不再直接 resume，必须有调度器
-          throw std::runtime_error(
-              "No scheduler available to resume continuation on cancellation");
-        }
-      }
-    });
+    detach_cancellation();
+    auto* state = details::CancellationAccess::state(token);
+    if (!state) return;
+    state->add_ref();
+    cancel_state_ = state;
+    invoke = &TaskPromiseBase::on_cancelled;
+    // 令牌已经取消时立即执行回调
+    if (!state->add(this)) on_cancelled(this, true);
   }
 
   // CRTP: 通过派生类访问 get_return_object
@@ -209,38 +350,143 @@ struct TaskPromiseBase {
 
   ResultType get_result() {
     LOG_TRACE("TaskPromise::get_result - waiting for result");
-    std::unique_lock lock(completion_lock);
-    LOG_TRACE("TaskPromise::get_result - acquired lock");
-    if (!result.has_value()) {
-      LOG_TRACE("TaskPromise::get_result - waiting on condition variable");
-      completion.wait(lock);
-      LOG_TRACE("TaskPromise::get_result - woke up from wait");
+    uint32_t state = state_.load(std::memory_order_acquire);
+    while (!(state & kReady)) {
+      // 只有真正阻塞的调用者才登记，完成方据此决定是否需要唤醒
+      if (!(state & kWaiting) &&
+          !state_.compare_exchange_weak(state, state | kWaiting,
+                                        std::memory_order_acquire)) {
+        continue;
+      }
+      LOG_TRACE("TaskPromise::get_result - blocking until completion");
+      state_.wait(state | kWaiting, std::memory_order_acquire);
+      state = state_.load(std::memory_order_acquire);
     }
     LOG_TRACE("TaskPromise::get_result - returning result");
     if constexpr (std::is_void_v<ResultType>) {
-      result->get_or_throw();
+      result.get_or_throw();
       return;
     } else {
-      return result->get_or_throw();
+      return result.get_or_throw();
     }
   }
 
  protected:
   friend class TaskBase<ResultType, Task<ResultType>>;
 
-  std::optional<Result<ResultType>> result;
-  std::mutex completion_lock;
-  std::condition_variable completion;
-  std::weak_ptr<AbstractScheduler> scheduler =
-      SchedulerManager::get_default_scheduler();
+  // state_ 的位：结果正在写入 / 结果已就绪 / 有线程阻塞在 get_result()
+  static constexpr uint32_t kWriting = 1;
+  static constexpr uint32_t kReady = 2;
+  static constexpr uint32_t kWaiting = 4;
+
+  /**
+   * @brief 写入结果并唤醒阻塞的等待者
+   * @return false 表示结果已经由别处（如取消回调）写入，本次结果被丢弃
+   */
+  bool complete(Result<ResultType>&& value) {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    do {
+      if (state & (kWriting | kReady)) return false;
+    } while (!state_.compare_exchange_weak(state, state | kWriting,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed));
+    // 原地重建而不是赋值：结果类型只需可移动构造
+    std::destroy_at(&result);
+    std::construct_at(&result, std::move(value));
+    if (state_.fetch_or(kReady, std::memory_order_acq_rel) & kWaiting) {
+      state_.notify_all();
+    }
+    return true;
+  }
+
+  // 协程体结束时写入结果。先注销取消回调（回调正在别的线程执行时等它
+  // 返回），之后回调不会再碰 continuation_。必须在 final_suspend 之前
+  // 完成：GCC 在调用 final_suspend() 时 done() 已经为 true，轮询
+  // is_done() 的一方可能随即销毁协程帧
+  void finish(Result<ResultType>&& value) {
+    detach_cancellation();
+    complete(std::move(value));
+  }
+
+  ~TaskPromiseBase() {
+    detach_cancellation();
+    if (locals_) locals_->release();
+    release_default_binding();
+  }
+
+  // 取消回调：先于任务写入结果时以 OperationCancelledException 完成任务，
+  // 并立即恢复等待者
+  static void on_cancelled(details::CancellationNode* node, bool cancelled) {
+    if (!cancelled) return;
+    auto& self = static_cast<TaskPromiseBase&>(*node);
+    LOG_INFO("TaskPromise - cancellation requested");
+    // 设置异常结果；任务已经先一步完成时保留它自己的结果
+    if (!self.complete(Result<ResultType>(
+            std::make_exception_ptr(OperationCancelledException())))) {
+      return;
+    }
+
+    // 如果有 continuation，立即恢复（让它处理取消）
+    if (self.continuation_) {
+      if (!self.scheduler) {
+        LOG_ERROR(
+            "TaskPromise - cancellation: no scheduler available to resume "
+            "continuation");
+        // 不再直接 resume，必须有调度器
+        throw std::runtime_error(
+            "No scheduler available to resume continuation on cancellation");
+      }
+      // 取走 continuation，final awaiter 不会再恢复它一次
+      auto continuation = std::exchange(self.continuation_, nullptr);
+      self.scheduler->schedule(
+          ScheduleRequest(continuation,
+                          ScheduleMetadata(ScheduleMetadata::Priority::High,
+                                           "cancellation_continuation")),
+          0);
+    }
+  }
+
+  // O(1) 注销取消回调；回调正在另一个线程上执行时等它返回
+  void detach_cancellation() noexcept {
+    if (!cancel_state_) return;
+    cancel_state_->remove(this);
+    cancel_state_->release();
+    cancel_state_ = nullptr;
+  }
+
+  // 协程帧销毁或改绑时注销对全局默认调度器的绑定，被替换下来的默认
+  // 调度器在最后一个绑定注销后才会被回收
+  void release_default_binding() noexcept {
+    if (!bound_default_) return;
+    bound_default_ = false;
+    SchedulerManager::release_default_binding(scheduler);
+  }
+
+  // 是否已写入由 state_ 的 kReady 位表示，不再额外包一层 optional
+  Result<ResultType> result;
+  std::atomic<uint32_t> state_{0};
+  // 三个标志紧跟在 state_ 之后，填进它的对齐空隙
   bool started = false;    // 防止重复启动
   bool detached_ = false;  // 是否分离（自动销毁）
+  // scheduler 是否登记为全局默认调度器的一次绑定。须声明在 scheduler 之前：
+  // scheduler 的初始化会写入它
+  bool bound_default_ = false;
+  // 协程绑定的调度器。不持有所有权：恢复路径上不做原子引用计数，
+  // 调度器的生命周期由运行时（SchedulerManager / 各 Runtime）保证
+  AbstractScheduler* scheduler =
+      SchedulerManager::bind_current_scheduler(bound_default_);
 
   // Continuation: 当前任务完成后要恢复的协程句柄
   std::coroutine_handle<> continuation_ = nullptr;
 
-  // Cancellation token: 用于协作式取消
-  std::optional<CancellationToken> cancel_token_;
+  // 取消令牌的共享状态（持有一个引用），未设置令牌时为空
+  details::CancellationState* cancel_state_ = nullptr;
+
+  // 结束钩子：侵入式，只占一个指针，保持 promise 紧凑
+  FinishHook* finish_hook_ = nullptr;
+
+  // 协程本地变量（持有一个引用），没有设置过任何变量时为空
+  details::LocalContext* locals_ = nullptr;
 
  public:
   /**
@@ -250,13 +496,12 @@ struct TaskPromiseBase {
     if (continuation_) {
       LOG_TRACE("TaskPromise::resume_continuation - resuming continuation: ",
                 continuation_.address());
-      auto sched = scheduler.lock();
-      if (sched) {
+      if (scheduler) {
         // 通过调度器恢复 continuation
-        ScheduleMetadata meta(
-            ScheduleMetadata::Priority::Normal,
-            "continuation_" + std::to_string((uintptr_t)this));
-        sched->schedule(ScheduleRequest(continuation_, std::move(meta)), 0);
+        ScheduleMetadata meta(ScheduleMetadata::Priority::Normal,
+                              "continuation");
+        meta.affinity = std::this_thread::get_id();
+        scheduler->schedule(ScheduleRequest(continuation_, std::move(meta)), 0);
       } else {
         LOG_WARN(
             "TaskPromise::resume_continuation - no scheduler available, "
@@ -273,20 +518,13 @@ template <typename ResultType>
 struct TaskPromise : TaskPromiseBase<ResultType, TaskPromise<ResultType>> {
   using result_type = ResultType;
   using Base = TaskPromiseBase<ResultType, TaskPromise<ResultType>>;
-  using Base::completion;
-  using Base::completion_lock;
-  using Base::result;
 
   // CRTP 实现
   Task<ResultType> get_return_object_impl();
 
   void return_value(ResultType value) {
     LOG_TRACE("TaskPromise::return_value - returning value");
-    {
-      std::lock_guard lock(completion_lock);
-      result = Result<ResultType>(std::move(value));
-      completion.notify_all();
-    }
+    this->finish(Result<ResultType>(std::move(value)));
   }
 };
 
@@ -301,11 +539,7 @@ struct TaskPromise<void> : TaskPromiseBase<void, TaskPromise<void>> {
 
   void return_void() {
     LOG_TRACE("TaskPromise<void>::return_void - returning void");
-    {
-      std::lock_guard lock(completion_lock);
-      result = Result<void>();
-      completion.notify_all();
-    }
+    finish(Result<void>());
   }
 };
 
@@ -1,8 +1,29 @@
 #pragma once
 
 #include "awaiters/sleep_awaiter.hpp"
+#include "awaiters/yield_awaiter.hpp"
+#include "details/coop_budget.hpp"
 
 namespace koroutine {
 SleepAwaiter sleep_for(long long duration_ms);
 
+// 支持微秒级精度，例如 co_await sleep_for(250us)
+template <typename Rep, typename Period>
+SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> duration) {
+  return SleepAwaiter(duration);
+}
+
+// 睡眠到指定的截止时间，适合固定节拍的循环（不会累积漂移）
+inline SleepAwaiter sleep_until(SleepAwaiter::Clock::time_point deadline) {
+  return SleepAwaiter(deadline);
+}
+
+// 让出工作线程，重新排到调度队列末尾：co_await yield()
+inline YieldAwaiter yield() { return YieldAwaiter(); }
+
+// 连续多少次无需挂起的 await 之后强制让出一次；0 表示关闭
+inline void set_coop_budget(uint32_t budget) {
+  details::CoopBudget::set_budget(budget);
+}
+
 }  // namespace koroutine
\ No newline at end of file
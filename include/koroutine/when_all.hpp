@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -30,15 +32,55 @@ using task_result_type_t = typename task_result_type<T>::type;
 template <typename... ResultTypes>
 struct WhenAllState {
   std::tuple<std::optional<ResultTypes>...> results;
-  std::atomic<size_t> remaining{sizeof...(ResultTypes)};
+  // 每个子任务一份，等待方一份：最后一个到达者恢复等待方
+  std::atomic<size_t> pending{sizeof...(ResultTypes) + 1};
   std::mutex mtx;
-  std::condition_variable cv;
   std::vector<std::exception_ptr> exceptions;
   std::coroutine_handle<> continuation = nullptr;
-  std::shared_ptr<AbstractScheduler> scheduler;
+  AbstractScheduler* scheduler = nullptr;
   // std::vector<Task<void>> wrappers;  // 移出 State 以避免循环引用
+};
 
-  bool all_completed() const { return remaining.load() == 0; }
+/**
+ * @brief when_all 包装协程的最后一步
+ *
+ * 在包装协程已经挂起之后才登记完成。包装协程停在这里不再恢复，随
+ * when_all 协程帧中的 Task 一起销毁，因此最后一个到达者调度等待方之后，
+ * 等待方立即销毁包装协程也是安全的。
+ */
+template <typename State>
+struct WhenAllArrive {
+  State* state;
+  DebugName debug_name;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<>) const noexcept {
+    State* s = state;
+    DebugName name = debug_name;
+    if (s->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      s->scheduler->schedule(
+          ScheduleRequest(s->continuation,
+                          ScheduleMetadata(ScheduleMetadata::Priority::Normal,
+                                           name)),
+          0);
+    }
+  }
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief when_all 的等待方：登记续体后到达，子任务已经全部完成时不挂起
+ */
+template <typename State>
+struct WhenAllWait {
+  State* state;
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> handle) const noexcept {
+    state->continuation = handle;
+    return state->pending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+  }
+  void await_resume() const noexcept {}
 };
 
 }  // namespace details
@@ -68,12 +110,12 @@ Task<std::tuple<details::task_result_type_t<Tasks>...>> when_all(
       details::WhenAllState<details::task_result_type_t<Tasks>...>>();
 
   // 获取调度器
-  state->scheduler = SchedulerManager::get_default_scheduler();
+  state->scheduler = SchedulerManager::current_scheduler();
   if (!state->scheduler) {
     LOG_ERROR("when_all - no default scheduler available!");
     throw std::runtime_error("No default scheduler available for when_all");
   }
-  LOG_TRACE("when_all - got scheduler: ", (void*)state->scheduler.get());
+  LOG_TRACE("when_all - got scheduler: ", (void*)state->scheduler);
 
   std::vector<Task<void>> wrappers;
   wrappers.reserve(sizeof...(Tasks));
@@ -90,58 +132,18 @@ Task<std::tuple<details::task_result_type_t<Tasks>...>> when_all(
               T result = co_await std::move(t);
               LOG_TRACE("wrapper for index ", I,
                         " task completed successfully with result");
-              {
-                std::lock_guard lock(s->mtx);
-                LOG_TRACE("wrapper for index ", I, " storing result at index ",
-                          I);
-                std::get<I>(s->results) = std::move(result);
-              }
-              auto remaining = s->remaining.fetch_sub(1);
-              LOG_TRACE("wrapper for index ", I,
-                        " remaining before decrement: ", remaining);
-
-              if (remaining == 1) {
-                // 最后一个任务完成
-                LOG_TRACE("wrapper for index ", I,
-                          " LAST TASK, notifying and resuming continuation");
-                s->cv.notify_one();
-
-                // 恢复 continuation
-                if (s->continuation && s->scheduler) {
-                  LOG_TRACE("wrapper for index ", I,
-                            " scheduling continuation, handle=",
-                            s->continuation.address());
-                  s->scheduler->schedule(
-                      ScheduleRequest(
-                          s->continuation,
-                          ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                           "when_all_continuation")),
-                      0);
-                } else {
-                  LOG_ERROR("wrapper for index ", I,
-                            " continuation or scheduler is null! continuation=",
-                            s->continuation.address(),
-                            " scheduler=", (void*)s->scheduler.get());
-                }
-              }
+              std::lock_guard lock(s->mtx);
+              LOG_TRACE("wrapper for index ", I, " storing result at index ",
+                        I);
+              std::get<I>(s->results) = std::move(result);
             } catch (...) {
               LOG_TRACE("when_all - task ", I, " failed with exception");
               std::lock_guard lock(s->mtx);
               s->exceptions.push_back(std::current_exception());
-
-              if (s->remaining.fetch_sub(1) == 1) {
-                s->cv.notify_one();
-
-                if (s->continuation && s->scheduler) {
-                  s->scheduler->schedule(
-                      ScheduleRequest(
-                          s->continuation,
-                          ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                           "when_all_continuation")),
-                      0);
-                }
-              }
             }
+            // 最后一个到达者恢复 continuation
+            co_await details::WhenAllArrive<std::remove_cvref_t<decltype(*s)>>{
+                s.get(), "when_all_continuation"};
           };
 
           wrappers.push_back(wrapper(state, std::move(task)));
@@ -149,12 +151,17 @@ Task<std::tuple<details::task_result_type_t<Tasks>...>> when_all(
         ...);
   }(std::index_sequence_for<Tasks...>{});
 
-  // 启动所有包装任务
+  // 包装任务不经过 TaskAwaiter 启动，显式继承调用者的协程本地变量，
+  // 它们 co_await 的子任务再从包装任务继承
+  auto* locals = co_await details::CurrentLocals{};
   for (auto& wrapper : wrappers) {
-    LOG_TRACE("when_all - starting wrapper task");
-    wrapper.start();
+    wrapper.handle_.promise().inherit_locals(locals);
   }
 
+  // 整批启动包装任务：一次入队，而不是每个任务各加一次队列锁
+  LOG_TRACE("when_all - starting wrapper tasks");
+  Task<void>::start_all(wrappers);
+
   LOG_TRACE(
       "when_all - all wrapper tasks started, creating awaiter");  // 创建
                                                                   // awaiter
@@ -164,33 +171,17 @@ Task<std::tuple<details::task_result_type_t<Tasks>...>> when_all(
         details::WhenAllState<details::task_result_type_t<Tasks>...>>
         state;
 
-    bool await_ready() const { return state->all_completed(); }
+    bool await_ready() const { return false; }
 
-    void await_suspend(std::coroutine_handle<> handle) {
+    // 子任务已经全部完成时不挂起，否则由最后一个完成的子任务恢复
+    bool await_suspend(std::coroutine_handle<> handle) {
       LOG_TRACE(
           "WhenAllAwaiter::await_suspend - suspending until all tasks "
           "complete, handle=",
           handle.address());
-      state->continuation = handle;
-      LOG_TRACE(
-          "WhenAllAwaiter::await_suspend - continuation set, checking if "
-          "already completed");
-
-      // 如果在设置 continuation 之前所有任务已经完成，立即恢复
-      if (state->all_completed() && state->scheduler) {
-        LOG_TRACE(
-            "WhenAllAwaiter::await_suspend - tasks already completed, "
-            "scheduling immediate resume");
-        state->scheduler->schedule(
-            ScheduleRequest(handle,
-                            ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                             "when_all_immediate")),
-            0);
-      } else {
-        LOG_TRACE(
-            "WhenAllAwaiter::await_suspend - tasks not yet completed, "
-            "waiting...");
-      }
+      return details::WhenAllWait<std::remove_cvref_t<decltype(*state)>>{
+          state.get()}
+          .await_suspend(handle);
     }
 
     ResultTuple await_resume() {
@@ -209,7 +200,10 @@ Task<std::tuple<details::task_result_type_t<Tasks>...>> when_all(
     }
   };
 
-  co_return co_await WhenAllAwaiter{state};
+  // 用具名 awaiter：GCC 12 会把 co_return co_await 里的临时 awaiter 析构两次，
+  // 其中的 shared_ptr 被多释放一次
+  WhenAllAwaiter awaiter{state};
+  co_return co_await awaiter;
 }
 
 /**
@@ -237,16 +231,17 @@ Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
   // 共享状态
   struct State {
     std::vector<std::optional<T>> results;
-    std::atomic<size_t> remaining;
+    // 每个子任务一份，等待方一份：最后一个到达者恢复等待方
+    std::atomic<size_t> pending;
     std::mutex mtx;
     std::vector<std::exception_ptr> exceptions;
     std::coroutine_handle<> continuation = nullptr;
-    std::shared_ptr<AbstractScheduler> scheduler;
+    AbstractScheduler* scheduler = nullptr;
 
     State(size_t count)
         : results(count),
-          remaining(count),
-          scheduler(SchedulerManager::get_default_scheduler()) {}
+          pending(count + 1),
+          scheduler(SchedulerManager::current_scheduler()) {}
   };
 
   auto state = std::make_shared<State>(tasks.size());
@@ -261,58 +256,37 @@ Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
         LOG_TRACE("when_all(vector) - task ", i, " completed : ", result);
         std::lock_guard lock(state->mtx);
         state->results[i] = std::move(result);
-
-        if (state->remaining.fetch_sub(1) == 1 && state->continuation &&
-            state->scheduler) {
-          state->scheduler->schedule(
-              ScheduleRequest(
-                  state->continuation,
-                  ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                   "when_all_vec_continuation")),
-              0);
-        }
       } catch (...) {
         LOG_TRACE("when_all(vector) - task ", i, " failed");
         std::lock_guard lock(state->mtx);
         state->exceptions.push_back(std::current_exception());
-
-        if (state->remaining.fetch_sub(1) == 1 && state->continuation &&
-            state->scheduler) {
-          state->scheduler->schedule(
-              ScheduleRequest(
-                  state->continuation,
-                  ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                   "when_all_vec_continuation")),
-              0);
-        }
       }
+      // 最后一个到达者恢复 continuation
+      co_await details::WhenAllArrive<State>{state.get(),
+                                             "when_all_vec_continuation"};
     };
 
     wrappers.push_back(wrapper(i, state, std::move(tasks[i])));
   }
 
-  // 启动所有包装任务
+  auto* locals = co_await details::CurrentLocals{};
   for (auto& wrapper : wrappers) {
-    wrapper.start();
+    wrapper.handle_.promise().inherit_locals(locals);
   }
 
+  // 整批启动包装任务：一次入队，而不是每个任务各加一次队列锁
+  Task<void>::start_all(wrappers);
+
   // Awaiter
   struct WhenAllVectorAwaiter {
     std::shared_ptr<State> state;
 
-    bool await_ready() const { return state->remaining.load() == 0; }
+    bool await_ready() const { return false; }
 
-    void await_suspend(std::coroutine_handle<> handle) {
+    // 子任务已经全部完成时不挂起，否则由最后一个完成的子任务恢复
+    bool await_suspend(std::coroutine_handle<> handle) {
       LOG_TRACE("WhenAllVectorAwaiter::await_suspend");
-      state->continuation = handle;
-
-      if (state->remaining.load() == 0 && state->scheduler) {
-        state->scheduler->schedule(
-            ScheduleRequest(handle,
-                            ScheduleMetadata(ScheduleMetadata::Priority::Normal,
-                                             "when_all_vec_immediate")),
-            0);
-      }
+      return details::WhenAllWait<State>{state.get()}.await_suspend(handle);
     }
 
     std::vector<T> await_resume() {
@@ -331,7 +305,8 @@ Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
     }
   };
 
-  co_return co_await WhenAllVectorAwaiter{state};
+  WhenAllVectorAwaiter awaiter{state};
+  co_return co_await awaiter;
 }
 
 }  // namespace koroutine
@@ -45,9 +45,9 @@ Task<std::pair<size_t, T>> when_any(std::vector<Task<T>> tasks) {
     std::optional<std::pair<size_t, T>> result;
     std::exception_ptr exception;
     std::coroutine_handle<> continuation = nullptr;
-    std::shared_ptr<AbstractScheduler> scheduler;
+    AbstractScheduler* scheduler;
 
-    State() : scheduler(SchedulerManager::get_default_scheduler()) {}
+    State() : scheduler(SchedulerManager::current_scheduler()) {}
   };
 
   auto state = std::make_shared<State>();
@@ -157,7 +157,10 @@ Task<std::pair<size_t, T>> when_any(std::vector<Task<T>> tasks) {
     }
   };
 
-  co_return co_await WhenAnyAwaiter{state};
+  // 用具名 awaiter：GCC 12 会把 co_return co_await 里的临时 awaiter 析构两次，
+  // 其中的 shared_ptr 被多释放一次
+  WhenAnyAwaiter awaiter{state};
+  co_return co_await awaiter;
 }
 
 /**
@@ -179,9 +182,9 @@ inline Task<size_t> when_any(std::vector<Task<void>> tasks) {
     std::optional<size_t> result_index;
     std::exception_ptr exception;
     std::coroutine_handle<> continuation = nullptr;
-    std::shared_ptr<AbstractScheduler> scheduler;
+    AbstractScheduler* scheduler;
 
-    State() : scheduler(SchedulerManager::get_default_scheduler()) {}
+    State() : scheduler(SchedulerManager::current_scheduler()) {}
   };
 
   auto state = std::make_shared<State>();
@@ -274,7 +277,8 @@ inline Task<size_t> when_any(std::vector<Task<void>> tasks) {
     }
   };
 
-  co_return co_await WhenAnyVoidAwaiter{state};
+  WhenAnyVoidAwaiter awaiter{state};
+  co_return co_await awaiter;
 }
 
 namespace details {
@@ -287,10 +291,10 @@ struct WhenAnyVariadicState {
   std::optional<std::variant<ResultTypes...>> result;
   std::exception_ptr exception;
   std::coroutine_handle<> continuation = nullptr;
-  std::shared_ptr<AbstractScheduler> scheduler;
+  AbstractScheduler* scheduler;
 
   WhenAnyVariadicState()
-      : scheduler(SchedulerManager::get_default_scheduler()) {}
+      : scheduler(SchedulerManager::current_scheduler()) {}
 };
 
 }  // namespace details
@@ -404,7 +408,8 @@ when_any(Tasks&&... tasks) {
     }
   };
 
-  co_return co_await Awaiter{state};
+  Awaiter awaiter{state};
+  co_return co_await awaiter;
 }
 
 }  // namespace koroutine
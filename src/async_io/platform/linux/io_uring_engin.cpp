@@ -44,12 +44,18 @@ IoUringIOEngine::~IoUringIOEngine() {
 }
 
 void IoUringIOEngine::submit(std::shared_ptr<AsyncIOOp> op) {
-  {
-    std::lock_guard<std::mutex> lock(ops_mutex_);
-    pending_ops_.push(op);
+  // 在驱动 ring 的线程上提交时直接写入 SQ，随下一次 poll 批量提交，无需唤醒
+  if (std::this_thread::get_id() ==
+      poll_thread_.load(std::memory_order_relaxed)) {
+    process_op(std::move(op));
+    return;
   }
 
-  // 唤醒事件循环
+  pending_ops_.push(std::move(op));
+  wakeup();
+}
+
+void IoUringIOEngine::wakeup() {
   uint64_t val = 1;
   if (write(event_fd_, &val, sizeof(val)) == -1) {
     // 忽略 EAGAIN，记录其他错误
@@ -59,99 +65,113 @@ void IoUringIOEngine::submit(std::shared_ptr<AsyncIOOp> op) {
   }
 }
 
+void IoUringIOEngine::arm_wakeup() {
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe) {
+    io_uring_prep_read(sqe, event_fd_, &wakeup_buf_, sizeof(wakeup_buf_), 0);
+    io_uring_sqe_set_data(sqe, (void*)WAKEUP_USER_DATA);
+  }
+}
+
 void IoUringIOEngine::run() {
   running_.store(true);
 
-  uint64_t ev_buf = 0;
-  struct iovec ev_iov;
-  ev_iov.iov_base = &ev_buf;
-  ev_iov.iov_len = sizeof(ev_buf);
-
-  // 初始提交 eventfd 读操作
-  {
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
-    if (sqe) {
-      io_uring_prep_read(sqe, event_fd_, &ev_buf, sizeof(ev_buf), 0);
-      io_uring_sqe_set_data(sqe, (void*)WAKEUP_USER_DATA);
-      io_uring_submit(&ring_);
-    }
+  while (running_.load()) {
+    if (poll_once(-1) < 0) break;
   }
+}
 
-  while (running_.load()) {
-    // 处理可能在唤醒前添加的待处理操作
+size_t IoUringIOEngine::poll(int timeout_ms) {
+  int completed = poll_once(timeout_ms);
+  return completed < 0 ? 0 : static_cast<size_t>(completed);
+}
 
-    struct io_uring_cqe* cqe;
+int IoUringIOEngine::poll_once(int timeout_ms) {
+  poll_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  if (!wakeup_armed_) {
+    // 初始提交 eventfd 读操作
+    arm_wakeup();
+    wakeup_armed_ = true;
+  }
+
+  struct io_uring_cqe* cqe;
+  int ret;
+  if (timeout_ms < 0) {
     // 等待至少一个事件
-    int ret = io_uring_submit_and_wait(&ring_, 1);
-    if (ret < 0) {
-      if (ret == -EINTR) continue;
-      LOG_ERROR("io_uring_submit_and_wait failed: ", -ret);
-      break;
-    }
+    ret = io_uring_submit_and_wait(&ring_, 1);
+  } else if (timeout_ms == 0) {
+    ret = io_uring_submit(&ring_);
+  } else {
+    struct __kernel_timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+    ret = io_uring_submit_and_wait_timeout(&ring_, &cqe, 1, &ts, nullptr);
+    if (ret == -ETIME) ret = 0;
+  }
+  if (ret < 0) {
+    if (ret == -EINTR) return 0;
+    LOG_ERROR("io_uring_submit_and_wait failed: ", -ret);
+    return ret;
+  }
 
-    unsigned head;
-    unsigned count = 0;
-    io_uring_for_each_cqe(&ring_, head, cqe) {
-      count++;
-      uintptr_t user_data = (uintptr_t)io_uring_cqe_get_data(cqe);
-      int res = cqe->res;
+  unsigned head;
+  unsigned count = 0;
+  int completed = 0;
+  io_uring_for_each_cqe(&ring_, head, cqe) {
+    count++;
+    uintptr_t user_data = (uintptr_t)io_uring_cqe_get_data(cqe);
+    int res = cqe->res;
 
-      if (user_data == WAKEUP_USER_DATA) {
-        // 唤醒事件
-        if (res < 0) {
-          LOG_ERROR("Eventfd read failed: ", -res);
-        }
+    if (user_data == WAKEUP_USER_DATA) {
+      // 唤醒事件
+      if (res < 0) {
+        LOG_ERROR("Eventfd read failed: ", -res);
+      }
 
-        // 处理待处理的操作
-        std::queue<std::shared_ptr<AsyncIOOp>> ops_to_process;
-        {
-          std::lock_guard<std::mutex> lock(ops_mutex_);
-          ops_to_process.swap(pending_ops_);
-        }
+      // 处理待处理的操作
+      std::shared_ptr<AsyncIOOp> op;
+      while (pending_ops_.try_pop(op)) {
+        process_op(std::move(op));
+      }
 
-        while (!ops_to_process.empty()) {
-          process_op(ops_to_process.front());
-          ops_to_process.pop();
-        }
+      // 重新提交 eventfd 读操作
+      arm_wakeup();
+    } else {
+      // 用户操作
+      auto* op_ptr = reinterpret_cast<AsyncIOOp*>(user_data);
+      auto it = in_flight_ops_.find(op_ptr);
+      if (it != in_flight_ops_.end()) {
+        auto op = it->second;
+        in_flight_ops_.erase(it);
 
-        // 重新提交 eventfd 读操作
-        struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
-        if (sqe) {
-          io_uring_prep_read(sqe, event_fd_, &ev_buf, sizeof(ev_buf), 0);
-          io_uring_sqe_set_data(sqe, (void*)WAKEUP_USER_DATA);
-        }
-      } else {
-        // 用户操作
-        auto* op_ptr = reinterpret_cast<AsyncIOOp*>(user_data);
-        auto it = in_flight_ops_.find(op_ptr);
-        if (it != in_flight_ops_.end()) {
-          auto op = it->second;
-          in_flight_ops_.erase(it);
-
-          if (res < 0) {
-            op->error = std::make_error_code(static_cast<std::errc>(-res));
-            op->actual_size = 0;
-          } else {
-            op->actual_size = static_cast<size_t>(res);
-            op->error = std::error_code();
-
-            if (op->type == OpType::RECVFROM) {
-              op->addr_len = op->msg.msg_namelen;
-            }
+        if (res < 0) {
+          op->error = std::make_error_code(static_cast<std::errc>(-res));
+          op->actual_size = 0;
+        } else {
+          op->actual_size = static_cast<size_t>(res);
+          op->error = std::error_code();
+
+          if (op->type == OpType::RECVFROM) {
+            op->addr_len = op->msg.msg_namelen;
           }
-          complete(op);
         }
+        complete(op);
+        completed++;
       }
     }
-    io_uring_cq_advance(&ring_, count);
   }
+  io_uring_cq_advance(&ring_, count);
+  return completed;
 }
 
 void IoUringIOEngine::process_op(std::shared_ptr<AsyncIOOp> op) {
   struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
   if (!sqe) {
-    // 队列已满？应该处理这种情况。目前先记录日志并失败。
-    // 理想情况下应该将其保留在 pending 中并重试。
+    // SQ 已满：先把已准备好的 SQE 提交给内核，腾出位置后重试
+    io_uring_submit(&ring_);
+    sqe = io_uring_get_sqe(&ring_);
+  }
+  if (!sqe) {
     LOG_ERROR("io_uring SQ full");
     op->error = std::make_error_code(std::errc::no_buffer_space);
     complete(op);
@@ -231,8 +251,7 @@ void IoUringIOEngine::process_op(std::shared_ptr<AsyncIOOp> op) {
 
 void IoUringIOEngine::stop() {
   running_.store(false);
-  uint64_t val = 1;
-  write(event_fd_, &val, sizeof(val));
+  wakeup();
 }
 
 bool IoUringIOEngine::is_running() { return running_.load(); }
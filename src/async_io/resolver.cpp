@@ -3,10 +3,9 @@
 #include <cstring>
 #include <mutex>
 #include <system_error>
-#include <thread>
 
 #include "koroutine/awaiters/awaiter.hpp"
-#include "koroutine/executors/new_thread_executor.h"
+#include "koroutine/executors/blocking_pool.h"
 #include "koroutine/scheduler_manager.h"
 #include "koroutine/schedulers/schedule_request.hpp"
 
@@ -54,11 +53,9 @@ struct ResolveAwaiter
 #ifdef _WIN32
     ensure_winsock_init();
 #endif
-    // TODO: Use NewThreadExecutor to run blocking getaddrinfo
-    // In a real system, we might use a thread pool
-    static auto executor = std::make_shared<NewThreadExecutor>();
-
-    executor->execute([this, handle = this->_caller_handle]() {
+    // getaddrinfo blocks; run it on the shared blocking pool, which reuses
+    // idle threads instead of starting one per lookup.
+    BlockingPool::instance().execute([this]() {
       struct addrinfo hints, *res = nullptr;
       std::memset(&hints, 0, sizeof(hints));
       hints.ai_family = AF_UNSPEC;
@@ -94,7 +91,7 @@ Task<std::expected<std::vector<Endpoint>, int>> Resolver::resolve(
     const std::string& host, const std::string& service) {
   ResolveAwaiter awaiter(host, service);
   // Install the current scheduler so we can resume on it
-  awaiter.install_scheduler(SchedulerManager::get_default_scheduler());
+  awaiter.install_scheduler(SchedulerManager::current_scheduler());
   co_return co_await std::move(awaiter);
 }
 
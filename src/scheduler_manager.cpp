@@ -1,18 +1,184 @@
 #include "koroutine/scheduler_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "koroutine/details/sharded_counter.hpp"
 #include "koroutine/schedulers/SimpleScheduler.h"
 namespace koroutine {
 
 namespace SchedulerManager {
-static std::shared_ptr<AbstractScheduler> default_scheduler =
-    std::make_shared<SimpleScheduler>();
+// 全局默认调度器（当前的和被替换下来的）各占一个条目，记录绑定到它的协程数。
+// 条目只复用、从不释放：读到旧条目的线程可以安全地在上面加一，发现它已不是
+// 当前条目后再减回去重试，不会访问已经释放的调度器
+struct DefaultEntry {
+  // 只在持有 default_scheduler_mutex 时写入，release_default_binding 无锁读取
+  std::atomic<AbstractScheduler*> scheduler{nullptr};
+  details::ShardedCounter bindings;
+};
+
+struct RetiredScheduler {
+  std::shared_ptr<AbstractScheduler> scheduler;
+  DefaultEntry* entry;
+};
+
+static std::mutex default_scheduler_mutex;
+static std::shared_ptr<AbstractScheduler> default_scheduler;
+// default_scheduler 的裸指针镜像，供 current_scheduler() 无锁读取
+static std::atomic<AbstractScheduler*> default_scheduler_raw{nullptr};
+// default_scheduler 的条目，供 bind_current_scheduler() 无锁读取
+static std::atomic<DefaultEntry*> default_entry{nullptr};
+// 以下均由 default_scheduler_mutex 保护
+static std::deque<DefaultEntry> entries;  // deque：扩容时条目地址不变
+static std::vector<DefaultEntry*> free_entries;
+// 被替换下来、仍可能有协程绑定的全局默认调度器，见 set_default_scheduler
+static std::vector<RetiredScheduler> retired_schedulers;
+static thread_local std::shared_ptr<AbstractScheduler> thread_default_scheduler;
+static thread_local AbstractScheduler* thread_default_scheduler_raw = nullptr;
+
+static DefaultEntry* acquire_entry_locked(AbstractScheduler* scheduler) {
+  DefaultEntry* entry;
+  if (free_entries.empty()) {
+    entry = &entries.emplace_back();
+  } else {
+    entry = free_entries.back();
+    free_entries.pop_back();
+  }
+  entry->scheduler.store(scheduler, std::memory_order_relaxed);
+  return entry;
+}
+
+// 调用者持有 default_scheduler_mutex。把已经没有协程绑定的旧调度器移入
+// reclaimed，由调用者在锁外释放：析构会关闭执行器并等待它的线程退出。
+// 当前线程属于其执行器的调度器留到下一次，避免线程等待自己退出
+static void sweep_retired_locked(
+    std::vector<std::shared_ptr<AbstractScheduler>>& reclaimed) {
+  std::erase_if(retired_schedulers, [&](RetiredScheduler& retired) {
+    if (retired.entry->bindings.load() != 0 ||
+        retired.scheduler->owns_current_thread()) {
+      return false;
+    }
+    retired.entry->scheduler.store(nullptr, std::memory_order_relaxed);
+    free_entries.push_back(retired.entry);
+    reclaimed.push_back(std::move(retired.scheduler));
+    return true;
+  });
+}
+
+// 调用者持有 default_scheduler_mutex
+static void replace_default_locked(
+    std::shared_ptr<AbstractScheduler> scheduler) {
+  DefaultEntry* entry = nullptr;
+  if (scheduler) {
+    // 重新设为默认的调度器（例如测试结束时恢复原来的默认值）沿用原来的条目，
+    // 不再算作被替换下来的
+    auto it = std::find_if(
+        retired_schedulers.begin(), retired_schedulers.end(),
+        [&](const RetiredScheduler& r) { return r.scheduler == scheduler; });
+    if (it != retired_schedulers.end()) {
+      entry = it->entry;
+      retired_schedulers.erase(it);
+    } else {
+      entry = acquire_entry_locked(scheduler.get());
+    }
+  }
+  if (default_scheduler) {
+    retired_schedulers.push_back(
+        {std::move(default_scheduler),
+         default_entry.load(std::memory_order_relaxed)});
+  }
+  default_scheduler = std::move(scheduler);
+  default_scheduler_raw.store(default_scheduler.get(),
+                              std::memory_order_release);
+  default_entry.store(entry, std::memory_order_seq_cst);
+}
+
+// 调用者持有 default_scheduler_mutex。每次设置都顺带回收旧调度器，
+// 包括设回当前默认值的调用
+static void install_default_locked(
+    std::shared_ptr<AbstractScheduler> scheduler,
+    std::vector<std::shared_ptr<AbstractScheduler>>& reclaimed) {
+  if (scheduler != default_scheduler) {
+    replace_default_locked(std::move(scheduler));
+  }
+  sweep_retired_locked(reclaimed);
+}
+
 std::shared_ptr<AbstractScheduler> get_default_scheduler() {
-  // set looper executor as default executor
+  if (thread_default_scheduler) return thread_default_scheduler;
+  std::vector<std::shared_ptr<AbstractScheduler>> reclaimed;
+  std::lock_guard<std::mutex> lock(default_scheduler_mutex);
+  if (!default_scheduler) {
+    // set looper executor as default executor
+    install_default_locked(std::make_shared<SimpleScheduler>(), reclaimed);
+  }
   return default_scheduler;
 }
 
 void set_default_scheduler(std::shared_ptr<AbstractScheduler> scheduler) {
-  default_scheduler = std::move(scheduler);
+  std::vector<std::shared_ptr<AbstractScheduler>> reclaimed;
+  std::lock_guard<std::mutex> lock(default_scheduler_mutex);
+  install_default_locked(std::move(scheduler), reclaimed);
+}
+
+void set_thread_default_scheduler(
+    std::shared_ptr<AbstractScheduler> scheduler) {
+  thread_default_scheduler = std::move(scheduler);
+  thread_default_scheduler_raw = thread_default_scheduler.get();
+}
+
+std::shared_ptr<AbstractScheduler> get_thread_default_scheduler() {
+  return thread_default_scheduler;
+}
+
+AbstractScheduler* current_scheduler() {
+  if (thread_default_scheduler_raw) return thread_default_scheduler_raw;
+  if (auto* scheduler = default_scheduler_raw.load(std::memory_order_acquire)) {
+    return scheduler;
+  }
+  return get_default_scheduler().get();
+}
+
+AbstractScheduler* bind_current_scheduler(bool& counted) {
+  counted = false;
+  if (thread_default_scheduler_raw) return thread_default_scheduler_raw;
+  while (true) {
+    auto* entry = default_entry.load(std::memory_order_acquire);
+    if (!entry) {
+      get_default_scheduler();
+      continue;
+    }
+    // 先登记再确认条目仍是当前的：回收方要么看到这次登记，要么已经换掉了
+    // 条目，这里就撤销登记重读
+    entry->bindings.add();
+    if (default_entry.load(std::memory_order_seq_cst) == entry) {
+      counted = true;
+      return entry->scheduler.load(std::memory_order_relaxed);
+    }
+    entry->bindings.sub();
+  }
+}
+
+void release_default_binding(AbstractScheduler* scheduler) {
+  // 绑定未注销前，scheduler 的条目不会被回收复用：当前条目属于它时就是它的
+  auto* entry = default_entry.load(std::memory_order_acquire);
+  if (entry && entry->scheduler.load(std::memory_order_relaxed) == scheduler) {
+    entry->bindings.sub();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(default_scheduler_mutex);
+  entry = default_entry.load(std::memory_order_relaxed);
+  if (!entry || entry->scheduler.load(std::memory_order_relaxed) != scheduler) {
+    auto it = std::find_if(retired_schedulers.begin(), retired_schedulers.end(),
+                           [&](const RetiredScheduler& r) {
+                             return r.scheduler.get() == scheduler;
+                           });
+    entry = it->entry;
+  }
+  entry->bindings.sub();
 }
 }  // namespace SchedulerManager
-}  // namespace koroutine
\ No newline at end of file
+}  // namespace koroutine
@@ -2,8 +2,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
-#include "koroutine/awaiters/sleep_awaiter.hpp"
 #include "koroutine/debug.h"
 #include "koroutine/runtime.hpp"
 
@@ -20,90 +20,122 @@ TaskManager::~TaskManager() {
 
 void TaskManager::submit_to_group(const std::string& name,
                                   std::shared_ptr<Task<void>> task) {
-  std::lock_guard lock(mtx_);
-  if (is_shutdown_) {
-    LOG_WARN("TaskManager::submit_to_group - manager is shutdown, ignoring");
-    return;
+  {
+    std::lock_guard lock(mtx_);
+    if (is_shutdown_) {
+      LOG_WARN("TaskManager::submit_to_group - manager is shutdown, ignoring");
+      return;
+    }
+    register_locked(groups_[name], name, task);
+  }
+
+  // Start outside the lock: the finish hook needs mtx_ and may run as soon as
+  // the task is scheduled
+  task->start();
+}
+
+void TaskManager::submit_all_to_group(
+    const std::string& name, std::vector<std::shared_ptr<Task<void>>> tasks) {
+  if (tasks.empty()) return;
+  {
+    std::lock_guard lock(mtx_);
+    if (is_shutdown_) {
+      LOG_WARN(
+          "TaskManager::submit_all_to_group - manager is shutdown, ignoring");
+      return;
+    }
+    auto& group = groups_[name];
+    for (auto& task : tasks) register_locked(group, name, task);
   }
 
-  TaskEntry entry;
+  Task<void>::start_all(tasks);
+}
+
+void TaskManager::register_locked(Group& group, const std::string& name,
+                                  const std::shared_ptr<Task<void>>& task) {
+  auto& entry = group.tasks.emplace_back();
   entry.task = task;
   entry.name = name;
+  entry.manager = this;
+  entry.group = &group;
+  entry.self = std::prev(group.tasks.end());
+  ++active_;
 
-  // Install cancellation token to the task
-  entry.task->with_cancellation(entry.cts.token());
-
-  // Start and add
-  entry.task->start();
-  groups_[name].push_back(std::move(entry));
+  // Install cancellation token and the finish hook before the task runs
+  task->with_cancellation(group.cts.token());
+  entry.on_finished = &TaskManager::on_task_finished;
+  task->on_finished(&entry);
 
   LOG_TRACE("TaskManager::submit_to_group - submitted task to group: ", name,
-            " total=", groups_[name].size());
+            " total=", group.tasks.size());
 }
 
-Task<void> TaskManager::join_group(std::string name) {
-  return [](TaskManager* self, std::string groupName) -> Task<void> {
-    while (true) {
-      // Build a list of active tasks without holding the lock while awaiting
-      // Debug print
-      LOG_TRACE("TaskManager::join_group - scanning groups for name: ",
-                groupName);
-      std::vector<std::weak_ptr<Task<void>>> active;
-      {
-        std::lock_guard lock(self->mtx_);
-
-        if (groupName.empty()) {
-          // all groups
-          for (auto& [gname, vec] : self->groups_) {
-            for (auto& e : vec) {
-              if (e.task && !e.task->is_done()) active.push_back(e.task);
-            }
-          }
-        } else {
-          auto it = self->groups_.find(groupName);
-          if (it != self->groups_.end()) {
-            for (auto& e : it->second) {
-              if (e.task && !e.task->is_done()) active.push_back(e.task);
-            }
-          }
-        }
-      }
+void TaskManager::on_task_finished(FinishHook* hook) {
+  auto* entry = static_cast<TaskEntry*>(hook);
+  TaskManager* self = entry->manager;
+  std::shared_ptr<Task<void>> task;
+  std::vector<JoinAwaiter*> ready;
+  {
+    std::lock_guard lock(self->mtx_);
+    Group* group = entry->group;
+    std::string name = std::move(entry->name);
+    task = std::move(entry->task);
+    group->tasks.erase(entry->self);
+    --self->active_;
+
+    if (group->tasks.empty()) {
+      ready = std::move(group->waiters);
+      self->groups_.erase(name);
+    }
+    if (self->active_ == 0) {
+      ready.insert(ready.end(), self->all_waiters_.begin(),
+                   self->all_waiters_.end());
+      self->all_waiters_.clear();
+    }
+    LOG_TRACE("TaskManager::on_task_finished - task finished in group: ", name,
+              " waking ", ready.size(), " joins");
+  }
 
-      if (active.empty()) break;  // no active tasks, done
-
-      // Remove finished tasks from groups to avoid growth (cleanup)
-      {
-        std::lock_guard lock(self->mtx_);
-        if (groupName.empty()) {
-          for (auto it = self->groups_.begin(); it != self->groups_.end();) {
-            auto& vec = it->second;
-            vec.erase(std::remove_if(vec.begin(), vec.end(),
-                                     [](const TaskEntry& e) {
-                                       return !e.task || e.task->is_done();
-                                     }),
-                      vec.end());
-            if (vec.empty())
-              it = self->groups_.erase(it);
-            else
-              ++it;
-          }
-        } else {
-          auto git = self->groups_.find(groupName);
-          if (git != self->groups_.end()) {
-            auto& vec = git->second;
-            vec.erase(std::remove_if(vec.begin(), vec.end(),
-                                     [](const TaskEntry& e) {
-                                       return !e.task || e.task->is_done();
-                                     }),
-                      vec.end());
-            if (vec.empty()) self->groups_.erase(git);
-          }
-        }
-      }
+  // A woken join may destroy the manager, so do not touch self from here on
+  for (auto* waiter : ready) waiter->resume();
+  // Dropping what may be the last reference destroys the finishing coroutine
+  // frame; FinalAwaiter no longer touches it once this hook has been called
+}
+
+bool TaskManager::is_idle_locked(const std::string& name) const {
+  if (name.empty()) return active_ == 0;
+  // Groups are erased as soon as their last task finishes
+  return groups_.find(name) == groups_.end();
+}
 
-      co_await SleepAwaiter(20);
+bool TaskManager::JoinAwaiter::try_complete_inline() {
+  std::lock_guard lock(manager_->mtx_);
+  if (!manager_->is_idle_locked(name_)) return false;
+  _result = Result<void>();
+  return true;
+}
+
+void TaskManager::JoinAwaiter::after_suspend() {
+  {
+    // Re-check under the lock: the last task may have finished since
+    // try_complete_inline
+    std::lock_guard lock(manager_->mtx_);
+    if (!manager_->is_idle_locked(name_)) {
+      if (name_.empty()) {
+        manager_->all_waiters_.push_back(this);
+      } else {
+        manager_->groups_[name_].waiters.push_back(this);
+      }
+      return;
     }
+  }
+  resume();
+}
 
+Task<void> TaskManager::join_group(std::string name) {
+  return [](TaskManager* self, std::string groupName) -> Task<void> {
+    LOG_TRACE("TaskManager::join_group - waiting for group: ", groupName);
+    co_await JoinAwaiter(self, std::move(groupName));
     co_return;
   }(this, std::move(name));
 }
@@ -114,21 +146,23 @@ void TaskManager::sync_wait_group(const std::string& name) {
 
 Task<void> TaskManager::cancel_group(std::string name) {
   return [](TaskManager* self, std::string groupName) -> Task<void> {
+    // Tasks submitted after this point get a fresh source and are not
+    // cancelled; the callbacks run outside mtx_
+    std::vector<CancellationTokenSource> sources;
     {
       std::lock_guard lock(self->mtx_);
       if (groupName.empty()) {
-        for (auto& [gname, vec] : self->groups_) {
-          for (auto& e : vec) {
-            e.cts.cancel();
-          }
+        for (auto& [gname, group] : self->groups_) {
+          sources.push_back(std::exchange(group.cts, {}));
         }
       } else {
         auto it = self->groups_.find(groupName);
         if (it != self->groups_.end()) {
-          for (auto& e : it->second) e.cts.cancel();
+          sources.push_back(std::exchange(it->second.cts, {}));
         }
       }
     }
+    for (auto& source : sources) source.cancel();
 
     // Wait until all related tasks are gone
     co_await self->join_group(groupName);
@@ -161,11 +195,8 @@ void TaskManager::sync_shutdown() { Runtime::block_on(shutdown()); }
 std::vector<std::pair<std::string, size_t>> TaskManager::list_groups() const {
   std::lock_guard lock(mtx_);
   std::vector<std::pair<std::string, size_t>> res;
-  for (auto& [name, vec] : groups_) {
-    size_t cnt = std::count_if(vec.begin(), vec.end(), [](auto& e) {
-      return e.task && !e.task->is_done();
-    });
-    if (cnt > 0) res.emplace_back(name, cnt);
+  for (auto& [name, group] : groups_) {
+    if (!group.tasks.empty()) res.emplace_back(name, group.tasks.size());
   }
   return res;
 }
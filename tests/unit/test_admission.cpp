@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <latch>
+#include <memory>
+#include <thread>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+using Priority = ScheduleMetadata::Priority;
+
+namespace {
+
+// 占住单线程池唯一的工作线程，之后提交的工作都留在队列里
+class BusyWorker {
+ public:
+  explicit BusyWorker(AbstractExecutor& executor) {
+    executor.execute([this] {
+      running_.count_down();
+      release_.wait();
+      // 最后一次访问本对象：析构函数等到这里才返回
+      done_.store(true);
+    });
+    running_.wait();
+  }
+  ~BusyWorker() {
+    release();
+    while (!done_.load()) std::this_thread::yield();
+  }
+
+  void release() {
+    if (!released_.exchange(true)) release_.count_down();
+  }
+
+ private:
+  std::latch running_{1};
+  std::latch release_{1};
+  std::atomic<bool> released_{false};
+  std::atomic<bool> done_{false};
+};
+
+std::coroutine_handle<> noop() { return std::noop_coroutine(); }
+
+ScheduleRequest request(Priority priority) {
+  return ScheduleRequest(noop(), ScheduleMetadata(priority));
+}
+
+Task<int> value(int v) { co_return v; }
+
+}  // namespace
+
+TEST(AdmissionTest, UnboundedExecutorAdmitsEverything) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  SimpleScheduler scheduler(pool);
+  BusyWorker busy(*pool);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(scheduler.try_schedule(request(Priority::Low)));
+  }
+  EXPECT_TRUE(scheduler.has_capacity(Priority::Low));
+  EXPECT_EQ(pool->metrics().rejected, 0u);
+}
+
+TEST(AdmissionTest, RejectRefusesNewWorkButNotResumes) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({4, OverflowPolicy::Reject});
+  BusyWorker busy(*pool);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(pool->try_execute(noop(), 4));
+  }
+  EXPECT_FALSE(pool->has_capacity(4));
+  EXPECT_FALSE(pool->try_execute(noop(), 4));
+  EXPECT_EQ(pool->metrics().rejected, 1u);
+
+  // 恢复已在运行的协程走 execute()，不受容量限制
+  pool->execute(noop());
+  EXPECT_EQ(pool->metrics().queued, 5u);
+
+  busy.release();
+  while (pool->metrics().queued != 0) std::this_thread::yield();
+  EXPECT_TRUE(pool->try_execute(noop(), 4));
+}
+
+// ShedLowest：Low 只能用到一半容量，Normal 到四分之三，High 用满
+TEST(AdmissionTest, ShedLowestRefusesLowPriorityFirst) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({8, OverflowPolicy::ShedLowest});
+  SimpleScheduler scheduler(pool);
+  BusyWorker busy(*pool);
+
+  int low = 0;
+  while (scheduler.try_schedule(request(Priority::Low))) ++low;
+  EXPECT_EQ(low, 4);
+  EXPECT_FALSE(scheduler.has_capacity(Priority::Low));
+  EXPECT_TRUE(scheduler.has_capacity(Priority::Normal));
+
+  int normal = 0;
+  while (scheduler.try_schedule(request(Priority::Normal))) ++normal;
+  EXPECT_EQ(normal, 2);
+
+  int high = 0;
+  while (scheduler.try_schedule(request(Priority::High))) ++high;
+  EXPECT_EQ(high, 2);
+  EXPECT_EQ(pool->metrics().rejected, 3u);
+}
+
+TEST(AdmissionTest, PrioritySchedulerHonoursExecutorLimit) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({4, OverflowPolicy::ShedLowest});
+  PriorityScheduler scheduler(pool);
+  BusyWorker busy(*pool);
+
+  EXPECT_TRUE(scheduler.try_schedule(request(Priority::Low)));
+  EXPECT_TRUE(scheduler.try_schedule(request(Priority::Low)));
+  EXPECT_FALSE(scheduler.try_schedule(request(Priority::Low)));
+  EXPECT_TRUE(scheduler.try_schedule(request(Priority::High)));
+  EXPECT_EQ(scheduler.metrics().rejected, 1u);
+}
+
+// Block：队列满时 admit() 挂起生产者，腾出空位后再恢复它
+TEST(AdmissionTest, BlockSuspendsProducerUntilThereIsRoom) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({2, OverflowPolicy::Block});
+  auto bounded = std::make_shared<SimpleScheduler>(pool);
+  auto other =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  BusyWorker busy(*pool);
+  pool->execute(noop());
+  pool->execute(noop());
+
+  std::atomic<bool> waiting{false};
+  auto producer = [](AbstractScheduler* scheduler,
+                     std::atomic<bool>& waiting) -> Task<bool> {
+    waiting = true;
+    co_return co_await scheduler->admit();
+  }(bounded.get(), waiting);
+  producer.handle_.promise().set_scheduler(other.get());
+  producer.start();
+
+  while (!waiting.load()) std::this_thread::yield();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_FALSE(producer.is_done());
+  // 被挂起的生产者不占用队列容量，也不计入拒绝次数
+  EXPECT_EQ(pool->metrics().queued, 2u);
+  EXPECT_EQ(pool->metrics().rejected, 0u);
+
+  busy.release();
+  EXPECT_TRUE(producer.handle_.promise().get_result());
+  while (!producer.is_done()) std::this_thread::yield();
+}
+
+TEST(AdmissionTest, AdmitReturnsFalseImmediatelyUnderReject) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({1, OverflowPolicy::Reject});
+  auto bounded = std::make_shared<SimpleScheduler>(pool);
+  auto other =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  BusyWorker busy(*pool);
+  pool->execute(noop());
+
+  auto producer = [](AbstractScheduler* scheduler) -> Task<bool> {
+    co_return co_await scheduler->admit();
+  }(bounded.get());
+  producer.handle_.promise().set_scheduler(other.get());
+  producer.start();
+  EXPECT_FALSE(producer.handle_.promise().get_result());
+  while (!producer.is_done()) std::this_thread::yield();
+}
+
+// 被拒绝的任务没有启动，腾出空位后可以重新启动
+TEST(AdmissionTest, RefusedTaskCanBeStartedLater) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({1, OverflowPolicy::Reject});
+  auto scheduler = std::make_shared<SimpleScheduler>(pool);
+  auto busy = std::make_unique<BusyWorker>(*pool);
+  pool->execute(noop());
+
+  auto task = value(7);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_FALSE(task.try_start());
+  EXPECT_FALSE(task.handle_.promise().is_started());
+
+  busy.reset();
+  while (pool->metrics().queued != 0) std::this_thread::yield();
+  EXPECT_TRUE(task.try_start());
+  EXPECT_EQ(task.handle_.promise().get_result(), 7);
+  while (!task.is_done()) std::this_thread::yield();
+}
+
+// 被拒绝的分离任务仍归调用方所有，腾出空位后可以再次分离启动
+TEST(AdmissionTest, RefusedDetachedTaskKeepsOwnership) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({1, OverflowPolicy::Reject});
+  auto scheduler = std::make_shared<SimpleScheduler>(pool);
+  auto busy = std::make_unique<BusyWorker>(*pool);
+  pool->execute(noop());
+
+  std::atomic<bool> ran{false};
+  auto task = [](std::atomic<bool>& ran) -> Task<void> {
+    ran.store(true);
+    co_return;
+  }(ran);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_FALSE(task.try_start_detached());
+  ASSERT_TRUE(task.handle_);
+  EXPECT_FALSE(task.handle_.promise().is_started());
+
+  busy.reset();
+  while (pool->metrics().queued != 0) std::this_thread::yield();
+  EXPECT_TRUE(task.try_start_detached());
+  EXPECT_FALSE(task.handle_);
+  while (!ran.load()) std::this_thread::yield();
+}
+
+// 关闭执行器时，仍挂起等待空位的生产者会被恢复，不会永远停在 admit() 上
+TEST(AdmissionTest, ShutdownReleasesParkedProducers) {
+  auto pool = std::make_shared<ThreadPoolExecutor>(1, 0);
+  pool->set_queue_limit({1, OverflowPolicy::Block});
+  auto bounded = std::make_shared<SimpleScheduler>(pool);
+  auto other =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  auto busy = std::make_unique<BusyWorker>(*pool);
+  pool->execute(noop());
+
+  std::atomic<bool> waiting{false};
+  auto producer = [](AbstractScheduler* scheduler,
+                     std::atomic<bool>& waiting) -> Task<bool> {
+    waiting = true;
+    co_return co_await scheduler->admit();
+  }(bounded.get(), waiting);
+  producer.handle_.promise().set_scheduler(other.get());
+  producer.start();
+  while (!waiting.load()) std::this_thread::yield();
+  std::this_thread::sleep_for(20ms);
+
+  std::thread stopper([&] { pool->shutdown(); });
+  busy->release();
+  stopper.join();
+  EXPECT_TRUE(producer.is_done());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+
+namespace {
+
+Task<void> record_thread(std::thread::id& out, std::latch& done) {
+  out = std::this_thread::get_id();
+  done.count_down();
+  co_return;
+}
+
+// 每个请求都指定目标 worker，检查实际运行的线程
+void expect_routed(std::shared_ptr<AbstractScheduler> scheduler,
+                   WorkStealingExecutor& executor) {
+  const int rounds = 50;
+  size_t workers = executor.worker_count();
+  std::vector<std::thread::id> ran_on(rounds * workers);
+  std::latch done(static_cast<std::ptrdiff_t>(ran_on.size()));
+  std::vector<Task<void>> tasks;
+
+  for (size_t i = 0; i < ran_on.size(); ++i) {
+    tasks.push_back(record_thread(ran_on[i], done));
+    ScheduleMetadata meta(ScheduleMetadata::Priority::Normal, "pinned");
+    meta.affinity = executor.worker_id(i % workers);
+    scheduler->schedule(ScheduleRequest(tasks.back().handle_, meta), 0);
+  }
+  done.wait();
+  for (auto& task : tasks) test::wait_finished(task);
+  for (size_t i = 0; i < ran_on.size(); ++i) {
+    EXPECT_EQ(ran_on[i], executor.worker_id(i % workers)) << "request " << i;
+  }
+}
+
+}  // namespace
+
+TEST(AffinityTest, SimpleSchedulerRoutesToOwningWorker) {
+  auto executor = std::make_shared<WorkStealingExecutor>(4);
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+  expect_routed(scheduler, *executor);
+}
+
+TEST(AffinityTest, PrioritySchedulerRoutesToOwningWorker) {
+  auto executor = std::make_shared<WorkStealingExecutor>(4);
+  auto scheduler = std::make_shared<PriorityScheduler>(executor);
+  expect_routed(scheduler, *executor);
+}
+
+TEST(AffinityTest, ForeignThreadFallsBackToExecute) {
+  auto executor = std::make_shared<WorkStealingExecutor>(2);
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+
+  std::thread::id ran_on;
+  std::latch done(1);
+  auto task = record_thread(ran_on, done);
+  ScheduleMetadata meta;
+  meta.affinity = std::this_thread::get_id();  // 不属于该执行器
+  EXPECT_FALSE(executor->execute_on(*meta.affinity, task.handle_));
+  scheduler->schedule(ScheduleRequest(task.handle_, meta), 0);
+  done.wait();
+  test::wait_finished(task);
+  EXPECT_TRUE(ran_on == executor->worker_id(0) ||
+              ran_on == executor->worker_id(1));
+}
+
+TEST(AffinityTest, LooperAcceptsOnlyItsLoopThread) {
+  LooperExecutor looper;
+  std::thread::id ran_on;
+  std::latch done(1);
+  auto task = record_thread(ran_on, done);
+  EXPECT_FALSE(looper.execute_on(std::this_thread::get_id(), task.handle_));
+  EXPECT_TRUE(looper.execute_on(looper.get_thread_id(), task.handle_));
+  done.wait();
+  test::wait_finished(task);
+  EXPECT_EQ(ran_on, looper.get_thread_id());
+}
+
+// continuation 默认回到子任务结束时所在的 worker
+TEST(AffinityTest, ContinuationStaysOnCurrentWorker) {
+  auto executor = std::make_shared<WorkStealingExecutor>(4);
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+
+  auto child = []() -> Task<std::thread::id> {
+    co_return std::this_thread::get_id();
+  };
+  // 协程 lambda 必须比协程活得久，不能直接调用临时对象
+  auto parent_body = [&]() -> Task<int> {
+    int mismatches = 0;
+    for (int i = 0; i < 200; ++i) {
+      auto finished_on = co_await child();
+      if (finished_on != std::this_thread::get_id()) ++mismatches;
+    }
+    co_return mismatches;
+  };
+  auto parent = parent_body();
+  parent.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_EQ(Runtime::block_on(std::move(parent)), 0);
+}
+
+TEST(AffinityTest, PinWorkers) {
+  WorkStealingExecutor executor(2);
+  EXPECT_FALSE(executor.pin_worker(5, {0}));
+  EXPECT_FALSE(executor.pin_worker(0, {}));
+  EXPECT_FALSE(executor.pin_worker(0, {-1}));
+
+#ifdef __linux__
+  // 只能使用进程当前被允许的 CPU
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+
+  ASSERT_TRUE(executor.pin_worker(1, {cpu}));
+  std::atomic<int> ran_on_cpu{-1};
+  std::latch done(1);
+  auto body = [&]() -> Task<void> {
+    ran_on_cpu = sched_getcpu();
+    done.count_down();
+    co_return;
+  };
+  auto task = body();
+  ASSERT_TRUE(executor.execute_on(executor.worker_id(1), task.handle_));
+  done.wait();
+  test::wait_finished(task);
+  EXPECT_EQ(ran_on_cpu.load(), cpu);
+#endif
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "koroutine/async_scope.hpp"
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<void> count_after(std::chrono::milliseconds delay,
+                       std::atomic<int>& finished) {
+  co_await sleep_for(delay);
+  finished.fetch_add(1);
+}
+
+Task<void> sleep_forever() {
+  while (true) co_await sleep_for(10ms);
+}
+
+Task<void> fail() {
+  co_await sleep_for(1ms);
+  throw std::runtime_error("child failed");
+}
+
+}  // namespace
+
+TEST(AsyncScopeTest, JoinWaitsForEveryChild) {
+  AsyncScope scope;
+  std::atomic<int> finished{0};
+  for (int i = 0; i < 8; ++i) {
+    scope.spawn(count_after(std::chrono::milliseconds(5 * i), finished));
+  }
+  scope.sync_join();
+  EXPECT_EQ(finished.load(), 8);
+  EXPECT_EQ(scope.active(), 0u);
+}
+
+TEST(AsyncScopeTest, JoinOnEmptyScopeDoesNotSuspend) {
+  AsyncScope scope;
+  bool joined = Runtime::block_on([](AsyncScope& scope) -> Task<bool> {
+    co_await scope.join();
+    co_return true;
+  }(scope));
+  EXPECT_TRUE(joined);
+}
+
+TEST(AsyncScopeTest, CancelPropagatesToEveryChild) {
+  AsyncScope scope;
+  for (int i = 0; i < 4; ++i) scope.spawn(sleep_forever());
+  EXPECT_EQ(scope.active(), 4u);
+  scope.cancel();
+  scope.sync_join();
+  EXPECT_TRUE(scope.is_cancelled());
+  EXPECT_EQ(scope.active(), 0u);
+}
+
+// 取消不可撤销：取消之后 spawn 的子任务在第一个 co_await 处结束
+TEST(AsyncScopeTest, ChildSpawnedAfterCancelStopsAtFirstAwait) {
+  AsyncScope scope;
+  scope.cancel();
+  std::atomic<int> finished{0};
+  scope.spawn(count_after(1ms, finished));
+  scope.sync_join();
+  EXPECT_EQ(finished.load(), 0);
+}
+
+// 子任务的异常被丢弃，不影响其他子任务，也不影响 join
+TEST(AsyncScopeTest, ChildExceptionIsDiscarded) {
+  AsyncScope scope;
+  std::atomic<int> finished{0};
+  scope.spawn(fail());
+  scope.spawn(count_after(5ms, finished));
+  EXPECT_NO_THROW(scope.sync_join());
+  EXPECT_EQ(finished.load(), 1);
+}
+
+// 子任务在 join 挂起之后又 spawn 子任务：join 也等待新加入的子任务
+TEST(AsyncScopeTest, JoinWaitsForChildrenSpawnedWhileWaiting) {
+  AsyncScope scope;
+  std::atomic<int> finished{0};
+  auto parent = [](AsyncScope& scope,
+                   std::atomic<int>& finished) -> Task<void> {
+    co_await sleep_for(5ms);
+    scope.spawn(count_after(10ms, finished));
+    finished.fetch_add(1);
+  };
+  scope.spawn(parent(scope, finished));
+  scope.sync_join();
+  EXPECT_EQ(finished.load(), 2);
+}
+
+// 作用域可以反复使用：每一轮的 join 只恢复一次
+TEST(AsyncScopeTest, RepeatedRoundsResumeJoinOnce) {
+  AsyncScope scope;
+  std::atomic<int> finished{0};
+  std::atomic<int> joins{0};
+  auto round = [](AsyncScope& scope, std::atomic<int>& finished,
+                  std::atomic<int>& joins) -> Task<void> {
+    for (int r = 0; r < 100; ++r) {
+      for (int i = 0; i < 16; ++i) scope.spawn(count_after(0ms, finished));
+      co_await scope.join();
+      joins.fetch_add(1);
+    }
+  };
+  Runtime::block_on(round(scope, finished, joins));
+  EXPECT_EQ(finished.load(), 1600);
+  EXPECT_EQ(joins.load(), 100);
+}
+
+// 析构时还有子任务：先取消再等待，子任务的结束钩子不会访问已销毁的作用域
+TEST(AsyncScopeTest, DestructorCancelsAndJoinsRemainingChildren) {
+  auto scope = std::make_unique<AsyncScope>();
+  for (int i = 0; i < 4; ++i) scope->spawn(sleep_forever());
+  scope.reset();
+  SUCCEED();
+}
+
+// 最后一个子任务的结束钩子以那次递减作为对作用域的最后一次访问：
+// 另一个线程看到 active() 为 0 就可以立即销毁作用域。子任务稍晚结束，
+// 保证结束时 join 已经挂起
+TEST(AsyncScopeTest, ScopeCanBeDestroyedOnceActiveReachesZero) {
+  std::atomic<int> finished{0};
+  for (int i = 0; i < 200; ++i) {
+    auto scope = std::make_unique<AsyncScope>();
+    scope->spawn(count_after(2ms, finished));
+    auto joiner = [](AsyncScope& scope) -> Task<void> {
+      co_await scope.join();
+    }(*scope);
+    joiner.start();
+    while (scope->active() != 0) std::this_thread::yield();
+    scope.reset();
+    while (!joiner.is_done()) std::this_thread::yield();
+  }
+  EXPECT_EQ(finished.load(), 200);
+}
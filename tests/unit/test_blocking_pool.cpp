@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+#include "koroutine/awaiters/future_awaiter.hpp"
+#include "koroutine/executors/blocking_pool.h"
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> blocking_sum(int a, int b) {
+  co_return co_await spawn_blocking([a, b] {
+    std::this_thread::sleep_for(5ms);
+    return a + b;
+  });
+}
+
+Task<void> blocking_throw() {
+  co_await spawn_blocking([] { throw std::runtime_error("blocking failed"); });
+}
+
+Task<int> await_future(std::future<int> future) {
+  co_return co_await FutureAwaiter<int>(std::move(future));
+}
+
+}  // namespace
+
+TEST(BlockingPoolTest, SpawnBlockingReturnsValue) {
+  EXPECT_EQ(Runtime::block_on(blocking_sum(2, 3)), 5);
+}
+
+TEST(BlockingPoolTest, SpawnBlockingPropagatesException) {
+  EXPECT_THROW(Runtime::block_on(blocking_throw()), std::runtime_error);
+}
+
+TEST(BlockingPoolTest, FutureAwaiterRunsOnPool) {
+  std::promise<int> promise;
+  auto future = promise.get_future();
+  std::thread setter([&] {
+    std::this_thread::sleep_for(10ms);
+    promise.set_value(42);
+  });
+  EXPECT_EQ(Runtime::block_on(await_future(std::move(future))), 42);
+  setter.join();
+}
+
+// 空闲线程被复用：顺序提交不会每次都新建线程
+TEST(BlockingPoolTest, ReusesIdleThreads) {
+  BlockingPool pool(8);
+  for (int i = 0; i < 50; ++i) {
+    std::latch done(1);
+    pool.execute([&] { done.count_down(); });
+    done.wait();
+    // 等线程回到空闲状态再提交下一个
+    while (pool.stats().idle == 0) std::this_thread::yield();
+  }
+  EXPECT_EQ(pool.stats().spawned, 1u);
+}
+
+// 线程数不超过上限，多出的工作排队等待
+TEST(BlockingPoolTest, CapsThreadCount) {
+  BlockingPool pool(2);
+  constexpr int kJobs = 8;
+  std::atomic<int> running{0};
+  std::atomic<int> peak{0};
+  std::latch done(kJobs);
+  for (int i = 0; i < kJobs; ++i) {
+    pool.execute([&] {
+      int now = ++running;
+      int expected = peak.load();
+      while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+      }
+      std::this_thread::sleep_for(10ms);
+      --running;
+      done.count_down();
+    });
+  }
+  EXPECT_LE(pool.stats().threads, 2u);
+  done.wait();
+  EXPECT_LE(peak.load(), 2);
+  EXPECT_EQ(pool.stats().spawned, 2u);
+}
+
+// 空闲超过 keep_alive 的线程自行退出
+TEST(BlockingPoolTest, ReapsIdleThreads) {
+  BlockingPool pool(4, 20ms);
+  std::latch done(4);
+  for (int i = 0; i < 4; ++i) {
+    pool.execute([&] {
+      std::this_thread::sleep_for(5ms);
+      done.count_down();
+    });
+  }
+  done.wait();
+  auto deadline = std::chrono::steady_clock::now() + 2s;
+  while (pool.stats().threads > 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(5ms);
+  }
+  EXPECT_EQ(pool.stats().threads, 0u);
+}
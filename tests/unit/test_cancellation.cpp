@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+#include "koroutine/cancellation.hpp"
+#include "koroutine/koroutine.h"
+#include "koroutine/task_manager.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> immediate_value(int v) { co_return v; }
+
+#ifdef __linux__
+std::chrono::nanoseconds thread_cpu_time() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+#endif
+
+Task<void> sleep_forever() {
+  while (true) co_await sleep_for(10ms);
+}
+
+}  // namespace
+
+TEST(CancellationCallbackTest, DeregistersWhenLeavingScope) {
+  CancellationToken token;
+  int called = 0;
+  {
+    CancellationCallback callback(token, [&] { ++called; });
+  }
+  CancellationCallback kept(token, [&] { called += 10; });
+  token.cancel();
+  EXPECT_EQ(called, 10);
+}
+
+TEST(CancellationCallbackTest, RunsImmediatelyWhenAlreadyCancelled) {
+  CancellationTokenSource source;
+  source.cancel();
+  bool called = false;
+  CancellationCallback callback(source.token(), [&] { called = true; });
+  EXPECT_TRUE(called);
+}
+
+TEST(CancellationCallbackTest, RunsInRegistrationOrder) {
+  CancellationToken token;
+  std::vector<int> order;
+  CancellationCallback first(token, [&] { order.push_back(1); });
+  token.on_cancel([&] { order.push_back(2); });
+  CancellationCallback third(token, [&] { order.push_back(3); });
+  token.cancel();
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(CancellationCallbackTest, ResetDropsCallbacks) {
+  CancellationToken token;
+  int called = 0;
+  CancellationCallback callback(token, [&] { ++called; });
+  token.on_cancel([&] { ++called; });
+  token.reset();
+  token.cancel();
+  EXPECT_EQ(called, 0);
+  EXPECT_TRUE(token.is_cancelled());
+}
+
+// 回调正在另一个线程上执行时，析构要等它返回
+TEST(CancellationCallbackTest, DestructorWaitsForRunningCallback) {
+  CancellationToken token;
+  std::latch entered(1);
+  std::atomic<bool> finished{false};
+  auto callback = std::make_unique<CancellationCallback<std::function<void()>>>(
+      token, [&] {
+        entered.count_down();
+        std::this_thread::sleep_for(30ms);
+        finished = true;
+      });
+  std::thread canceller([&] { token.cancel(); });
+  entered.wait();
+  callback.reset();
+  EXPECT_TRUE(finished.load());
+  canceller.join();
+}
+
+#ifdef __linux__
+// 等待期间阻塞在 executing_ 上，不占用 CPU
+TEST(CancellationCallbackTest, WaitingForRunningCallbackDoesNotSpin) {
+  CancellationToken token;
+  std::latch entered(1);
+  auto callback = std::make_unique<CancellationCallback<std::function<void()>>>(
+      token, [&] {
+        entered.count_down();
+        std::this_thread::sleep_for(100ms);
+      });
+  std::thread canceller([&] { token.cancel(); });
+  entered.wait();
+  auto before = thread_cpu_time();
+  callback.reset();
+  EXPECT_LT(thread_cpu_time() - before, 20ms);
+  canceller.join();
+}
+#endif
+
+TEST(CancellationCallbackTest, ConcurrentRegistrationAndCancel) {
+  CancellationToken token;
+  std::atomic<int> registered{0};
+  std::atomic<int> invoked{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      while (!token.is_cancelled()) {
+        CancellationCallback callback(token, [&] { invoked.fetch_add(1); });
+        registered.fetch_add(1);
+      }
+      // 取消之后注册的回调在构造时立即执行
+      CancellationCallback late(token, [&] { invoked.fetch_add(1); });
+      registered.fetch_add(1);
+    });
+  }
+  while (registered.load() < 1000) std::this_thread::yield();
+  token.cancel();
+  for (auto& thread : threads) thread.join();
+  EXPECT_GE(invoked.load(), 4);
+  EXPECT_LE(invoked.load(), registered.load());
+}
+
+// 任务结束时注销自己：之后取消同一个令牌不会碰到已销毁的协程帧
+TEST(CancellationTaskTest, FinishedTasksLeaveNoCallbacksBehind) {
+  CancellationToken token;
+  for (int i = 0; i < 1000; ++i) {
+    auto task = immediate_value(i);
+    task.with_cancellation(token);
+    task.start();
+    EXPECT_EQ(task.handle_.promise().get_result(), i);
+    while (!task.is_done()) std::this_thread::yield();
+  }
+  token.cancel();
+  EXPECT_TRUE(token.is_cancelled());
+}
+
+// 取消先写入结果，任务在下一个 co_await 处停下并正常走到结束
+TEST(CancellationTaskTest, CancelledTaskStopsAtNextAwait) {
+  CancellationTokenSource source;
+  auto task = sleep_forever();
+  task.with_cancellation(source.token());
+  task.start();
+  std::this_thread::sleep_for(30ms);
+  source.cancel();
+  EXPECT_THROW(task.handle_.promise().get_result(),
+               OperationCancelledException);
+  while (!task.is_done()) std::this_thread::yield();
+}
+
+// 取消分组后提交到同名分组的新任务不受影响
+TEST(CancellationTaskTest, TaskManagerCancelDoesNotAffectLaterTasks) {
+  TaskManager manager;
+  manager.submit_to_group("g", std::make_shared<Task<void>>(sleep_forever()));
+  manager.sync_cancel_group("g");
+
+  std::atomic<bool> ran{false};
+  auto later = [](std::atomic<bool>& ran) -> Task<void> {
+    co_await sleep_for(20ms);
+    ran = true;
+  };
+  manager.submit_to_group("g", std::make_shared<Task<void>>(later(ran)));
+  manager.sync_wait_group("g");
+  EXPECT_TRUE(ran.load());
+}
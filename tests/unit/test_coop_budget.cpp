@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <latch>
+#include <string>
+#include <thread>
+
+#include "koroutine/channel.hpp"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+
+namespace {
+
+// 测试期间修改协作预算，结束时恢复默认值
+class CoopBudgetGuard {
+ public:
+  explicit CoopBudgetGuard(uint32_t budget) { set_coop_budget(budget); }
+  ~CoopBudgetGuard() {
+    set_coop_budget(details::CoopBudget::kDefaultBudget);
+  }
+};
+
+std::shared_ptr<AbstractScheduler> single_thread_scheduler() {
+  return std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+}
+
+template <typename R>
+Task<R> on(std::shared_ptr<AbstractScheduler> scheduler, Task<R> task) {
+  task.handle_.promise().set_scheduler(scheduler.get());
+  return task;
+}
+
+Task<void> take_turns(char name, std::string& trace) {
+  for (int i = 0; i < 3; ++i) {
+    trace.push_back(name);
+    co_await yield();
+  }
+}
+
+// 每轮让出一次，统计自己被调度了多少次
+Task<void> ticker(std::atomic<int>& ticks, std::atomic<bool>& stop) {
+  while (!stop.load()) {
+    ++ticks;
+    co_await yield();
+  }
+}
+
+Task<void> fill(Channel<int>& channel, int count) {
+  for (int i = 0; i < count; ++i) co_await channel.write(i);
+}
+
+// 读完缓冲通道里的全部数据，返回读到一半时 ticker 又运行了几次
+Task<int> drain(Channel<int>& channel, int count, std::atomic<int>& ticks,
+                std::atomic<bool>& stop) {
+  int start = ticks.load();
+  int ticks_midway = 0;
+  for (int i = 0; i < count; ++i) {
+    co_await channel.read();
+    if (i == count / 2) ticks_midway = ticks.load() - start;
+  }
+  stop = true;
+  co_return ticks_midway;
+}
+
+Task<int> leaf(int v) { co_return v; }
+
+Task<int> call_leaves(std::shared_ptr<AbstractScheduler> scheduler, int count,
+                      std::atomic<int>& ticks, std::atomic<bool>& stop) {
+  int start = ticks.load();
+  int ticks_midway = 0;
+  for (int i = 0; i < count; ++i) {
+    co_await on(scheduler, leaf(i));
+    if (i == count / 2) ticks_midway = ticks.load() - start;
+  }
+  stop = true;
+  co_return ticks_midway;
+}
+
+// 只做就绪的 await，然后直接结束，不真正挂起
+Task<void> spend(Channel<int>& channel, int count) {
+  for (int i = 0; i < count; ++i) co_await channel.read();
+}
+
+// 返回读取期间 ticker 运行了几次：没有被强制让出时为 0
+Task<int> ticks_during_reads(Channel<int>& channel, int count,
+                             std::atomic<int>& ticks,
+                             std::atomic<bool>& stop) {
+  int start = ticks.load();
+  for (int i = 0; i < count; ++i) co_await channel.read();
+  int ticked = ticks.load() - start;
+  stop = true;
+  co_return ticked;
+}
+
+int starve_with_channel(uint32_t budget) {
+  CoopBudgetGuard guard(budget);
+  auto scheduler = single_thread_scheduler();
+  constexpr int kItems = 4096;
+  Channel<int> channel(kItems);
+  std::atomic<int> ticks{0};
+  std::atomic<bool> stop{false};
+  Runtime::block_on(on(scheduler, fill(channel, kItems)));
+
+  auto tick = on(scheduler, ticker(ticks, stop));
+  auto reader = on(scheduler, drain(channel, kItems, ticks, stop));
+  tick.start();
+  int midway = Runtime::block_on(std::move(reader));
+  test::wait_finished(tick);
+  return midway;
+}
+
+}  // namespace
+
+TEST(CoopBudgetTest, YieldRequeuesBehindOtherTasks) {
+  auto scheduler = single_thread_scheduler();
+  std::string trace;
+  auto a = on(scheduler, take_turns('a', trace));
+  auto b = on(scheduler, take_turns('b', trace));
+  a.start();
+  b.start();
+  test::wait_finished(a);
+  test::wait_finished(b);
+  EXPECT_EQ(trace, "ababab");
+}
+
+// 关闭预算时，读缓冲通道的协程在读完之前不会让出工作线程
+TEST(CoopBudgetTest, WithoutBudgetReadyAwaitsMonopolise) {
+  EXPECT_EQ(starve_with_channel(0), 0);
+}
+
+TEST(CoopBudgetTest, BufferedChannelReaderYields) {
+  // 4096 次就绪读取，每 64 次让出一次：读到一半时 ticker 已运行多次
+  EXPECT_GE(starve_with_channel(64), 4096 / 2 / 64 - 1);
+}
+
+// 同一线程上逐个 co_await 子任务（对称转移）同样消耗预算
+TEST(CoopBudgetTest, ChildTaskLoopYields) {
+  CoopBudgetGuard guard(64);
+  auto scheduler = single_thread_scheduler();
+  std::atomic<int> ticks{0};
+  std::atomic<bool> stop{false};
+  auto tick = on(scheduler, ticker(ticks, stop));
+  auto caller = on(scheduler, call_leaves(scheduler, 4096, ticks, stop));
+  tick.start();
+  EXPECT_GT(Runtime::block_on(std::move(caller)), 0);
+  test::wait_finished(tick);
+}
+
+// 前一个协程几乎用完预算后结束：下一个从队列取出的协程拿到完整的预算
+TEST(CoopBudgetTest, BudgetIsNotChargedToNextTask) {
+  CoopBudgetGuard guard(8);
+  auto executor = std::make_shared<LooperExecutor>();
+  std::shared_ptr<AbstractScheduler> scheduler =
+      std::make_shared<SimpleScheduler>(executor);
+  // 在别的线程上写入，执行线程的预算从零开始
+  Channel<int> channel(64);
+  Runtime::block_on(fill(channel, 14));
+
+  std::atomic<int> ticks{0};
+  std::atomic<bool> stop{false};
+  auto hog = on(scheduler, spend(channel, 7));
+  auto next = on(scheduler, ticks_during_reads(channel, 7, ticks, stop));
+  auto tick = on(scheduler, ticker(ticks, stop));
+  // 先挡住执行线程，保证三个任务按顺序排在同一个队列里
+  std::latch gate(1);
+  executor->execute([&] { gate.wait(); });
+  hog.start();
+  next.start();
+  tick.start();
+  gate.count_down();
+  test::wait_finished(hog);
+  test::wait_finished(next);
+  test::wait_finished(tick);
+  EXPECT_EQ(next.handle_.promise().get_result(), 0);
+}
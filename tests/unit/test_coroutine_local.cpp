@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "koroutine/coroutine_local.hpp"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+const CoroutineLocal<std::string> trace_id;
+const CoroutineLocal<int> tenant;
+
+Task<std::string> read_trace_id() {
+  const std::string* id = co_await trace_id.get();
+  co_return id ? *id : "<unset>";
+}
+
+Task<std::string> overwrite_trace_id(std::string value) {
+  co_await trace_id.set(std::move(value));
+  co_return co_await read_trace_id();
+}
+
+}  // namespace
+
+TEST(CoroutineLocalTest, KeysGetDistinctSlots) {
+  EXPECT_NE(trace_id.index(), tenant.index());
+}
+
+TEST(CoroutineLocalTest, UnsetValueIsNull) {
+  EXPECT_EQ(Runtime::block_on(read_trace_id()), "<unset>");
+}
+
+// 值跟随逻辑任务：多线程线程池上跨越 co_await 换了线程也能读到
+TEST(CoroutineLocalTest, ValueSurvivesThreadHops) {
+  auto scheduler = std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(4));
+  auto task = []() -> Task<int> {
+    co_await tenant.set(7);
+    int sum = 0;
+    for (int i = 0; i < 20; ++i) {
+      co_await sleep_for(1ms);
+      sum += *co_await tenant.get();
+    }
+    co_return sum;
+  }();
+  task.handle_.promise().set_scheduler(scheduler.get());
+  task.start();
+  EXPECT_EQ(task.handle_.promise().get_result(), 140);
+  while (!task.is_done()) std::this_thread::yield();
+}
+
+TEST(CoroutineLocalTest, AwaitedChildInheritsContext) {
+  auto parent = []() -> Task<std::string> {
+    co_await trace_id.set("req-42");
+    co_return co_await read_trace_id();
+  };
+  EXPECT_EQ(Runtime::block_on(parent()), "req-42");
+}
+
+// 子任务写入的值不会回流到父任务
+TEST(CoroutineLocalTest, ChildWritesDoNotLeakToParent) {
+  auto parent = []() -> Task<std::string> {
+    co_await trace_id.set("parent");
+    std::string child = co_await overwrite_trace_id("child");
+    EXPECT_EQ(child, "child");
+    co_return co_await read_trace_id();
+  };
+  EXPECT_EQ(Runtime::block_on(parent()), "parent");
+}
+
+TEST(CoroutineLocalTest, ResetClearsValue) {
+  auto task = []() -> Task<std::string> {
+    co_await trace_id.set("req");
+    co_await trace_id.reset();
+    co_return co_await read_trace_id();
+  };
+  EXPECT_EQ(Runtime::block_on(task()), "<unset>");
+}
+
+TEST(CoroutineLocalTest, WhenAllChildrenInheritContext) {
+  auto task = []() -> Task<std::string> {
+    co_await trace_id.set("fan-out");
+    auto [a, b] = co_await when_all(read_trace_id(), read_trace_id());
+    co_return a + "/" + b;
+  };
+  EXPECT_EQ(Runtime::block_on(task()), "fan-out/fan-out");
+}
+
+// 互不相关的任务各自一份，不会互相看到
+TEST(CoroutineLocalTest, IndependentTasksDoNotShareValues) {
+  auto writer = []() -> Task<void> { co_await tenant.set(1); };
+  Runtime::block_on(writer());
+  auto reader = []() -> Task<bool> {
+    co_return co_await tenant.get() == nullptr;
+  };
+  EXPECT_TRUE(Runtime::block_on(reader()));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+
+namespace {
+
+Task<std::thread::id> child_thread() { co_return std::this_thread::get_id(); }
+
+// 依次经过子任务、定时器、yield 和阻塞线程池，记录每一步所在的线程
+Task<std::vector<std::thread::id>> visit_threads() {
+  std::vector<std::thread::id> seen;
+  seen.push_back(std::this_thread::get_id());
+  seen.push_back(co_await child_thread());
+  co_await sleep_for(std::chrono::milliseconds(1));
+  seen.push_back(std::this_thread::get_id());
+  co_await yield();
+  seen.push_back(std::this_thread::get_id());
+  auto blocking_thread =
+      co_await spawn_blocking([] { return std::this_thread::get_id(); });
+  EXPECT_NE(blocking_thread, std::this_thread::get_id());
+  seen.push_back(std::this_thread::get_id());
+  co_return seen;
+}
+
+Task<int> answer() { co_return 42; }
+
+Task<int> fail() {
+  co_await yield();
+  throw std::runtime_error("boom");
+}
+
+Task<void> set_after_sleep(bool& flag, std::thread::id& where) {
+  co_await sleep_for(std::chrono::milliseconds(2));
+  where = std::this_thread::get_id();
+  flag = true;
+}
+
+Task<void> wait_for_flag(const bool& flag) {
+  while (!flag) co_await yield();
+}
+
+#ifdef __linux__
+int thread_count() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("Threads:", 0) == 0) return std::stoi(line.substr(8));
+  }
+  return -1;
+}
+
+Task<int> nested_work(int depth) {
+  if (depth == 0) co_return 0;
+  co_await yield();
+  co_return 1 + co_await nested_work(depth - 1);
+}
+#endif
+
+}  // namespace
+
+TEST(CurrentThreadRuntimeTest, RunsEverythingOnCallingThread) {
+  auto caller = std::this_thread::get_id();
+  auto seen = Runtime::block_on_current_thread(visit_threads());
+  ASSERT_EQ(seen.size(), 5u);
+  for (auto id : seen) EXPECT_EQ(id, caller);
+}
+
+TEST(CurrentThreadRuntimeTest, ReturnsValueAndRethrows) {
+  CurrentThreadRuntime runtime;
+  EXPECT_EQ(runtime.block_on(answer()), 42);
+  EXPECT_THROW(runtime.block_on(fail()), std::runtime_error);
+  // 运行时可以重复使用
+  EXPECT_EQ(runtime.block_on(answer()), 42);
+}
+
+// spawn 出的任务同样在 block_on 的调用线程上运行
+TEST(CurrentThreadRuntimeTest, SpawnedTasksRunDuringBlockOn) {
+  CurrentThreadRuntime runtime;
+  bool flag = false;
+  std::thread::id where;
+  runtime.spawn(set_after_sleep(flag, where));
+  runtime.block_on(wait_for_flag(flag));
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(where, std::this_thread::get_id());
+}
+
+TEST(CurrentThreadRuntimeTest, RestoresThreadDefaultScheduler) {
+  EXPECT_EQ(SchedulerManager::get_thread_default_scheduler(), nullptr);
+  {
+    CurrentThreadRuntime runtime;
+    EXPECT_EQ(SchedulerManager::get_thread_default_scheduler(),
+              runtime.scheduler());
+  }
+  EXPECT_EQ(SchedulerManager::get_thread_default_scheduler(), nullptr);
+}
+
+#ifdef __linux__
+// 不触碰全局默认调度器时，不会启动任何线程池线程
+TEST(CurrentThreadRuntimeTest, StartsNoPoolThreads) {
+  int before = thread_count();
+  CurrentThreadRuntime runtime;
+  EXPECT_EQ(runtime.block_on(nested_work(100)), 100);
+  EXPECT_EQ(thread_count(), before);
+}
+#endif
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/DeadlineScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 带截止时间（或不带）启动任务
+class DeadlineLooper : public test::GatedLooper<DeadlineScheduler> {
+ public:
+  void submit(std::optional<Clock::time_point> deadline, int id) {
+    auto& task = add(id);
+    if (deadline) task.with_deadline(*deadline);
+    task.handle_.promise().set_scheduler(&scheduler());
+    task.start();
+  }
+};
+
+Task<void> sleep_forever() {
+  while (true) co_await sleep_for(5ms);
+}
+
+}  // namespace
+
+TEST(DeadlineSchedulerTest, EarliestDeadlineRunsFirst) {
+  DeadlineLooper looper;
+  auto base = Clock::now() + 1h;
+  looper.submit(std::nullopt, 100);
+  looper.submit(base + 3s, 3);
+  looper.submit(std::nullopt, 101);
+  looper.submit(base + 1s, 1);
+  looper.submit(base + 2s, 2);
+  EXPECT_EQ(looper.scheduler().pending(), 5u);
+
+  auto order = looper.release();
+  // 没有截止时间的排在最后，彼此之间保持 FIFO
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 100, 101}));
+  EXPECT_EQ(looper.scheduler().metrics().expired, 0u);
+}
+
+// 排队期间已过截止时间的任务不执行函数体，以 OperationCancelledException 结束
+TEST(DeadlineSchedulerTest, TaskStartedAfterDeadlineSkipsBody) {
+  DeadlineLooper looper;
+  looper.submit(Clock::now() + 1ms, 0);
+  looper.submit(std::nullopt, 1);
+  std::this_thread::sleep_for(5ms);
+
+  auto order = looper.release();
+  EXPECT_EQ(order, (std::vector<int>{1}));
+  EXPECT_EQ(looper.scheduler().metrics().expired, 1u);
+  EXPECT_THROW(looper.task(0).handle_.promise().get_result(),
+               OperationCancelledException);
+}
+
+// 运行中的任务过了截止时间，在下一个 co_await 处结束
+TEST(DeadlineSchedulerTest, ExpiredTaskStopsAtNextAwait) {
+  auto scheduler = std::make_shared<DeadlineScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  std::atomic<int> rounds{0};
+  auto task = [](std::atomic<int>& rounds) -> Task<void> {
+    while (true) {
+      co_await sleep_for(5ms);
+      rounds.fetch_add(1);
+    }
+  }(rounds);
+  task.with_deadline(Clock::now() + 30ms);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_THROW(Runtime::block_on(std::move(task)),
+               OperationCancelledException);
+  EXPECT_GT(rounds.load(), 0);
+}
+
+// 被 co_await 的子任务继承截止时间；子任务自己的截止时间不能把它推迟
+TEST(DeadlineSchedulerTest, DeadlineFlowsToAwaitedChildren) {
+  auto scheduler = std::make_shared<DeadlineScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  auto parent = []() -> Task<bool> {
+    auto child = sleep_forever();
+    child.with_deadline(Clock::now() + 1h);
+    try {
+      co_await std::move(child);
+    } catch (const OperationCancelledException&) {
+      co_return true;
+    }
+    co_return false;
+  }();
+  parent.with_deadline(Clock::now() + 30ms);
+  parent.handle_.promise().set_scheduler(scheduler.get());
+  auto start = Clock::now();
+  EXPECT_TRUE(Runtime::block_on(std::move(parent)));
+  EXPECT_LT(Clock::now() - start, 1s);
+}
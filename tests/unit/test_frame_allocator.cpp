@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "koroutine/details/frame_allocator.hpp"
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using details::FrameAllocator;
+
+TEST(FrameAllocatorTest, ReusesBlocksOfTheSameSizeClass) {
+  FrameAllocator::release_cached();
+  void* first = FrameAllocator::allocate(200);
+  FrameAllocator::deallocate(first, 200);
+  EXPECT_EQ(FrameAllocator::cached(), 1u);
+  // 同一个 64 字节档位内的请求复用刚释放的块
+  void* second = FrameAllocator::allocate(250);
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(FrameAllocator::cached(), 0u);
+  FrameAllocator::deallocate(second, 250);
+
+  // 超过最大档位的帧直接走全局分配器
+  void* large = FrameAllocator::allocate(FrameAllocator::kMaxSize + 1);
+  FrameAllocator::deallocate(large, FrameAllocator::kMaxSize + 1);
+  EXPECT_EQ(FrameAllocator::cached(), 1u);
+  FrameAllocator::release_cached();
+  EXPECT_EQ(FrameAllocator::cached(), 0u);
+}
+
+// 在别的线程释放的块进入释放线程的缓存，且缓存有上限
+TEST(FrameAllocatorTest, CrossThreadFreeIsBounded) {
+  constexpr size_t kBlocks = FrameAllocator::kMaxCached * 2;
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kBlocks; ++i) {
+    blocks.push_back(FrameAllocator::allocate(128));
+  }
+  std::thread([&] {
+    for (void* block : blocks) FrameAllocator::deallocate(block, 128);
+    EXPECT_EQ(FrameAllocator::cached(), FrameAllocator::kMaxCached);
+  }).join();
+}
+
+// 线程退出、缓存已回收之后分配的块仍按整个档位分配：它可能被别的
+// 线程的缓存收下，再作为完整档位的块分配出去
+TEST(FrameAllocatorTest, BlocksAllocatedAfterThreadExitFillTheirClass) {
+  struct LateAllocation {
+    void*& block;
+    ~LateAllocation() { block = FrameAllocator::allocate(100); }
+  };
+
+  FrameAllocator::release_cached();
+  void* block = nullptr;
+  std::thread([&] {
+    // 先于缓存的清理对象构造，因此在它之后析构
+    thread_local LateAllocation late{block};
+    FrameAllocator::deallocate(FrameAllocator::allocate(64), 64);
+  }).join();
+  ASSERT_NE(block, nullptr);
+
+  FrameAllocator::deallocate(block, 100);
+  void* reused = FrameAllocator::allocate(FrameAllocator::kGranularity * 2);
+  EXPECT_EQ(reused, block);
+  std::memset(reused, 0, FrameAllocator::kGranularity * 2);
+  FrameAllocator::deallocate(reused, FrameAllocator::kGranularity * 2);
+  FrameAllocator::release_cached();
+}
+
+namespace {
+
+Task<int> leaf(int v) { co_return v; }
+
+Task<long long> fan_out(int n) {
+  long long sum = 0;
+  for (int i = 0; i < n; ++i) sum += co_await leaf(i);
+  co_return sum;
+}
+
+}  // namespace
+
+TEST(FrameAllocatorTest, TasksRoundTripThroughThePool) {
+  constexpr int kTasks = 10000;
+  auto sum = Runtime::block_on(fan_out(kTasks));
+  EXPECT_EQ(sum, static_cast<long long>(kTasks) * (kTasks - 1) / 2);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include "koroutine/details/mpsc_queue.hpp"
+#include "koroutine/executors/looper_executor.h"
+
+using namespace koroutine;
+
+TEST(MpscQueueTest, SingleThreadFifo) {
+  details::MpscQueue<int> queue(4);
+  EXPECT_TRUE(queue.empty());
+  // 超过环形缓冲区容量的部分进入溢出队列，顺序保持不变
+  for (int i = 0; i < 10; ++i) queue.push(int(i));
+  EXPECT_FALSE(queue.empty());
+  int value = -1;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+// 多个生产者并发写入：每个生产者自身的顺序不变，元素不丢失
+TEST(MpscQueueTest, PerProducerOrderUnderContention) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 50000;
+  details::MpscQueue<int> queue(64);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        queue.push(p * kPerProducer + i);
+      }
+    });
+  }
+
+  std::vector<int> next(kProducers, 0);
+  int received = 0;
+  int value = 0;
+  while (received < kProducers * kPerProducer) {
+    if (!queue.try_pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    int p = value / kPerProducer;
+    ASSERT_EQ(value % kPerProducer, next[p]);
+    ++next[p];
+    ++received;
+  }
+  for (auto& t : producers) t.join();
+  EXPECT_TRUE(queue.empty());
+}
+
+// LooperExecutor 按提交顺序执行，空闲挂起后能被外部提交唤醒
+TEST(MpscQueueTest, LooperRunsInOrderAndWakesFromPark) {
+  LooperExecutor executor;
+  std::vector<int> order;
+  for (int round = 0; round < 3; ++round) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));  // 让循环挂起
+    std::latch done(1);
+    for (int i = 0; i < 1000; ++i) {
+      executor.execute([&order, i] { order.push_back(i); });
+    }
+    executor.execute([&done] { done.count_down(); });
+    done.wait();
+  }
+  ASSERT_EQ(order.size(), 3000u);
+  for (size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(order[i], static_cast<int>(i % 1000));
+  }
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <string>
 #include <thread>
+#include <type_traits>
 
 #include "koroutine/cancellation.hpp"
 #include "koroutine/runtime.hpp"
@@ -28,6 +30,21 @@ TEST(ScheduleRequestTest, BasicConstruction) {
   EXPECT_EQ(req.metadata().debug_name, "test_task");
 }
 
+// debug_name 只保存视图：运行时构造的字符串无法传入，避免悬空视图
+TEST(ScheduleRequestTest, DebugNameAcceptsOnlyLiterals) {
+  static_assert(std::is_constructible_v<ScheduleMetadata,
+                                        ScheduleMetadata::Priority,
+                                        const char (&)[5]>);
+  static_assert(!std::is_constructible_v<ScheduleMetadata,
+                                         ScheduleMetadata::Priority,
+                                         std::string>);
+  static_assert(!std::is_constructible_v<ScheduleMetadata,
+                                         ScheduleMetadata::Priority,
+                                         const char*>);
+  ScheduleMetadata meta(ScheduleMetadata::Priority::Low, "literal");
+  EXPECT_EQ(meta.debug_name.view(), "literal");
+}
+
 TEST(ScheduleRequestTest, DefaultMetadata) {
   auto coro = []() -> Task<void> { co_return; }();
   auto handle = coro.handle_;
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+using Priority = ScheduleMetadata::Priority;
+
+namespace {
+
+// 按给定优先级提交恢复请求
+class PriorityLooper : public test::GatedLooper<PriorityScheduler> {
+ public:
+  void submit(Priority priority, int id) {
+    scheduler().schedule(
+        ScheduleRequest(add(id).handle_, ScheduleMetadata(priority)), 0);
+  }
+};
+
+}  // namespace
+
+TEST(PrioritySchedulerTest, HigherPriorityOvertakesBacklog) {
+  PriorityLooper looper;
+  for (int i = 0; i < 10; ++i) looper.submit(Priority::Low, 100 + i);
+  looper.submit(Priority::Normal, 1);
+  looper.submit(Priority::High, 0);
+  EXPECT_EQ(looper.scheduler().pending(Priority::Low), 10u);
+
+  auto order = looper.release();
+  ASSERT_EQ(order.size(), 12u);
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[1], 1);
+  // 同一优先级内保持 FIFO
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(order[2 + i], 100 + i);
+}
+
+TEST(PrioritySchedulerTest, LowPriorityIsNotStarved) {
+  PriorityLooper looper;
+  for (int i = 0; i < 170; ++i) looper.submit(Priority::High, i);
+  for (int i = 0; i < 20; ++i) looper.submit(Priority::Low, 1000 + i);
+
+  auto order = looper.release();
+  ASSERT_EQ(order.size(), 190u);
+  // 默认权重 16:1，高优先级持续积压时，每 17 次恢复中低优先级至少得到一次
+  int low_seen = 0;
+  for (size_t i = 0; i < 170; ++i) {
+    if (order[i] >= 1000) ++low_seen;
+    if ((i + 1) % 17 == 0) {
+      EXPECT_GE(low_seen, static_cast<int>((i + 1) / 17)) << "at " << i;
+    }
+  }
+}
+
+TEST(PrioritySchedulerTest, DispatchAndSleepWithPriority) {
+  auto scheduler = std::make_shared<PriorityScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  auto task = [](std::shared_ptr<PriorityScheduler> scheduler) -> Task<int> {
+    int hops = 0;
+    for (int i = 0; i < 50; ++i) {
+      co_await scheduler->dispatch_to(i % 2 ? Priority::Low : Priority::High);
+      ++hops;
+    }
+    co_await scheduler->schedule(5);
+    co_return hops;
+  }(scheduler);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_EQ(Runtime::block_on(std::move(task)), 50);
+}
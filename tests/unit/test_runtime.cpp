@@ -27,13 +27,15 @@ TEST(RuntimeTest, SpawnStartsAndDetachesTask) {
 // 测试 Runtime::spawn 和 channel 结合使用(producer first)
 TEST(RuntimeTest, SpawnWithChannelProducerFirst) {
   koroutine::Channel<int> chan(1);
+  std::atomic<bool> spawned_done = false;
 
   // Producer task
-  auto producer = [&chan]() -> Task<void> {
+  auto producer = [&chan, &spawned_done]() -> Task<void> {
     for (int i = 0; i < 5; ++i) {
       co_await chan.write(i);
     }
     co_await chan.close_when_empty();
+    spawned_done.store(true);
     co_return;
   };
 
@@ -57,11 +59,14 @@ TEST(RuntimeTest, SpawnWithChannelProducerFirst) {
 
   Runtime::spawn(producer());
   Runtime::block_on(consumer());
+  // 分离的任务引用了栈上的 chan，必须等它结束
+  while (!spawned_done.load()) std::this_thread::yield();
 }
 // 测试 Runtime::spawn 和 channel 结合使用(consumer first)
 TEST(RuntimeTest, SpawnWithChannelConsumerFirst) {
   koroutine::Channel<int> chan(1);
   std::atomic<bool> producer_done = false;
+  std::atomic<bool> spawned_done = false;
   // Producer task
   auto producer = [&chan, &producer_done]() -> Task<void> {
     for (int i = 0; i < 5; ++i) {
@@ -72,7 +77,7 @@ TEST(RuntimeTest, SpawnWithChannelConsumerFirst) {
     co_return;
   };
   // Consumer task
-  auto consumer = [&chan, &producer_done]() -> Task<void> {
+  auto consumer = [&chan, &producer_done, &spawned_done]() -> Task<void> {
     int sum = 0;
     while (true) {
       if (!chan.is_active()) {
@@ -87,8 +92,10 @@ TEST(RuntimeTest, SpawnWithChannelConsumerFirst) {
     }
     EXPECT_EQ(sum, 0 + 1 + 2 + 3 + 4);
     EXPECT_TRUE(producer_done.load());
+    spawned_done.store(true);
     co_return;
   };
   Runtime::spawn(consumer());
   Runtime::block_on(producer());
+  while (!spawned_done.load()) std::this_thread::yield();
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <memory>
+#include <thread>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 逐个提交任务并等待其完成
+void hand_off(AbstractExecutor& executor, int count) {
+  for (int i = 0; i < count; ++i) {
+    std::latch done(1);
+    executor.execute([&done] { done.count_down(); });
+    done.wait();
+  }
+}
+
+}  // namespace
+
+TEST(RuntimeMetricsTest, HistogramBucketsAndPercentiles) {
+  EXPECT_EQ(LatencyHistogram::bucket_for(0), 0u);
+  EXPECT_EQ(LatencyHistogram::bucket_for(1), 0u);
+  EXPECT_EQ(LatencyHistogram::bucket_for(1023), 9u);
+  EXPECT_EQ(LatencyHistogram::bucket_for(1024), 10u);
+  EXPECT_EQ(LatencyHistogram::bucket_for(~uint64_t{0}),
+            LatencyHistogram::kBuckets - 1);
+
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentile(0.5), 0ns);
+  // 90 个约 1us 的样本，10 个约 1ms 的样本
+  histogram.buckets[LatencyHistogram::bucket_for(1'000)] = 90;
+  histogram.buckets[LatencyHistogram::bucket_for(1'000'000)] = 10;
+  histogram.count = 100;
+  histogram.sum_ns = 90 * 1'000 + 10 * 1'000'000;
+  EXPECT_EQ(histogram.percentile(0.5), 1024ns);
+  EXPECT_EQ(histogram.percentile(0.99), 1048576ns);
+  EXPECT_EQ(histogram.mean(), 100'900ns);
+
+  LatencyHistogram sum;
+  sum += histogram;
+  sum += histogram;
+  EXPECT_EQ(sum.count, 200u);
+  EXPECT_EQ(sum.percentile(0.5), 1024ns);
+}
+
+TEST(RuntimeMetricsTest, ThreadPoolCountsWorkAndSamplesLatency) {
+  ThreadPoolExecutor pool(2, 0);
+  hand_off(pool, 320);
+  auto metrics = pool.metrics();
+  EXPECT_EQ(metrics.workers, 2u);
+  EXPECT_EQ(metrics.queued, 0u);
+  EXPECT_GE(metrics.executed, 320u);
+  // 每 kLatencySampleInterval 次提交采样一次
+  EXPECT_GE(metrics.schedule_latency.count, 9u);
+  EXPECT_LE(metrics.schedule_latency.count, 10u);
+  EXPECT_GT(metrics.schedule_latency.percentile(0.5), 0ns);
+
+  pool.shutdown();
+  metrics = pool.metrics();
+  EXPECT_EQ(metrics.workers, 0u);
+  EXPECT_GE(metrics.executed, 320u);
+}
+
+TEST(RuntimeMetricsTest, LooperReportsQueueDepth) {
+  auto looper = std::make_shared<LooperExecutor>();
+  std::latch release(1);
+  std::latch started(1);
+  looper->execute([&] {
+    started.count_down();
+    release.wait();
+  });
+  started.wait();
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 10; ++i) looper->execute([&ran] { ++ran; });
+  EXPECT_EQ(looper->metrics().queued, 10u);
+  EXPECT_EQ(looper->metrics().workers, 1u);
+
+  release.count_down();
+  while (ran.load() < 10) std::this_thread::yield();
+  EXPECT_EQ(looper->metrics().queued, 0u);
+  EXPECT_GE(looper->metrics().executed, 11u);
+}
+
+TEST(RuntimeMetricsTest, DelayedCountsPendingTimers) {
+  ThreadPoolExecutor pool(1, 0);
+  std::atomic<bool> fired{false};
+  pool.execute_delayed([&fired] { fired = true; }, 20ms);
+  pool.execute_delayed([] {}, 20ms);
+  EXPECT_EQ(pool.metrics().delayed, 2u);
+  while (!fired.load()) std::this_thread::sleep_for(1ms);
+  auto deadline = std::chrono::steady_clock::now() + 1s;
+  while (pool.metrics().delayed != 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_EQ(pool.metrics().delayed, 0u);
+}
+
+TEST(RuntimeMetricsTest, IdleWorkersAccumulateIdleTime) {
+  ThreadPoolExecutor pool(1, 0);
+  hand_off(pool, 1);
+  std::this_thread::sleep_for(30ms);
+  auto metrics = pool.metrics();
+  EXPECT_GE(metrics.idle, 20ms);
+  EXPECT_LT(metrics.utilization(), 0.5);
+
+  // 忙碌的任务计入 busy
+  std::latch done(1);
+  pool.execute([&done] {
+    std::this_thread::sleep_for(30ms);
+    done.count_down();
+  });
+  done.wait();
+  EXPECT_GE(pool.metrics().busy, 20ms);
+}
+
+TEST(RuntimeMetricsTest, WorkStealingCountsWorkers) {
+  WorkStealingExecutor executor(3);
+  hand_off(executor, 100);
+  auto metrics = executor.metrics();
+  EXPECT_EQ(metrics.workers, 3u);
+  EXPECT_GE(metrics.executed, 100u);
+  EXPECT_EQ(metrics.queued, 0u);
+}
+
+TEST(RuntimeMetricsTest, SchedulersForwardExecutorMetrics) {
+  auto simple =
+      std::make_shared<SimpleScheduler>(std::make_shared<ThreadPoolExecutor>(2));
+  EXPECT_EQ(simple->metrics().workers, 2u);
+
+  auto priority = std::make_shared<PriorityScheduler>(
+      std::make_shared<ThreadPoolExecutor>(3));
+  EXPECT_EQ(priority->metrics().workers, 3u);
+}
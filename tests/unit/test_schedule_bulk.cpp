@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <latch>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "koroutine/executors/current_thread_executor.h"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/DeadlineScheduler.h"
+#include "koroutine/schedulers/PriorityScheduler.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/task_manager.h"
+#include "test_support.h"
+
+using namespace koroutine;
+
+namespace {
+
+// 记录 schedule_bulk 的调用次数和批次大小
+class CountingScheduler : public SimpleScheduler {
+ public:
+  using SimpleScheduler::SimpleScheduler;
+  using SimpleScheduler::schedule;
+
+  void schedule_bulk(std::span<ScheduleRequest> requests) override {
+    bulk_calls.fetch_add(1);
+    bulk_size.fetch_add(requests.size());
+    SimpleScheduler::schedule_bulk(requests);
+  }
+
+  std::atomic<size_t> bulk_calls{0};
+  std::atomic<size_t> bulk_size{0};
+};
+
+// 记录调度器向执行器投递取任务回调的方式：逐个投递还是整批投递
+class CountingExecutor : public ThreadPoolExecutor {
+ public:
+  using ThreadPoolExecutor::execute;
+  using ThreadPoolExecutor::execute_bulk;
+  using ThreadPoolExecutor::ThreadPoolExecutor;
+
+  void execute(std::function<void()>&& func) override {
+    single_calls.fetch_add(1);
+    ThreadPoolExecutor::execute(std::move(func));
+  }
+
+  void execute_bulk(const std::function<void()>& func,
+                    size_t count) override {
+    bulk_calls.fetch_add(1);
+    bulk_size.fetch_add(count);
+    ThreadPoolExecutor::execute_bulk(func, count);
+  }
+
+  std::atomic<size_t> single_calls{0};
+  std::atomic<size_t> bulk_calls{0};
+  std::atomic<size_t> bulk_size{0};
+};
+
+Task<void> count_down(std::latch& done, std::atomic<int>& ran) {
+  ran.fetch_add(1);
+  done.count_down();
+  co_return;
+}
+
+Task<int> square(int x) { co_return x * x; }
+
+Task<std::vector<int>> fan_out(int n) {
+  std::vector<Task<int>> tasks;
+  for (int i = 0; i < n; ++i) tasks.push_back(square(i));
+  co_return co_await when_all(std::move(tasks));
+}
+
+// 自带运行队列的调度器：一批协程只向执行器投递一次取任务回调
+template <typename QueuedScheduler>
+void pumps_in_one_batch(int n) {
+  auto executor = std::make_shared<CountingExecutor>(2);
+  auto scheduler = std::make_shared<QueuedScheduler>(executor);
+  std::latch done(n);
+  std::atomic<int> ran{0};
+  std::vector<Task<void>> tasks;
+  {
+    test::ThreadDefault scope(scheduler);
+    for (int i = 0; i < n; ++i) tasks.push_back(count_down(done, ran));
+  }
+  Task<void>::start_all(tasks);
+  done.wait();
+  EXPECT_EQ(ran.load(), n);
+  EXPECT_EQ(executor->single_calls.load(), 0u);
+  EXPECT_EQ(executor->bulk_calls.load(), 1u);
+  EXPECT_EQ(executor->bulk_size.load(), static_cast<size_t>(n));
+  for (auto& task : tasks) {
+    while (!task.is_done()) std::this_thread::yield();
+  }
+}
+
+// 用 executor 批量启动 n 个协程并等待它们全部运行
+void run_batch(std::shared_ptr<AbstractExecutor> executor, int n) {
+  auto scheduler = std::make_shared<CountingScheduler>(executor);
+  std::latch done(n);
+  std::atomic<int> ran{0};
+  std::vector<Task<void>> tasks;
+  {
+    test::ThreadDefault scope(scheduler);
+    for (int i = 0; i < n; ++i) tasks.push_back(count_down(done, ran));
+  }
+  Task<void>::start_all(tasks);
+  done.wait();
+  EXPECT_EQ(ran.load(), n);
+  EXPECT_EQ(scheduler->bulk_calls.load(), 1u);
+  EXPECT_EQ(scheduler->bulk_size.load(), static_cast<size_t>(n));
+  for (auto& task : tasks) {
+    while (!task.is_done()) std::this_thread::yield();
+  }
+}
+
+}  // namespace
+
+TEST(ScheduleBulkTest, ThreadPoolRunsWholeBatch) {
+  run_batch(std::make_shared<ThreadPoolExecutor>(4), 1000);
+}
+
+TEST(ScheduleBulkTest, LooperRunsWholeBatch) {
+  run_batch(std::make_shared<LooperExecutor>(), 1000);
+}
+
+TEST(ScheduleBulkTest, WorkStealingRunsWholeBatch) {
+  run_batch(std::make_shared<WorkStealingExecutor>(4), 1000);
+}
+
+TEST(ScheduleBulkTest, StartAllSkipsStartedTasksAndGroupsBySchedulers) {
+  auto first = std::make_shared<CountingScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  auto second = std::make_shared<CountingScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  std::latch done(6);
+  std::atomic<int> ran{0};
+  std::vector<std::shared_ptr<Task<void>>> tasks;
+  {
+    test::ThreadDefault scope(first);
+    for (int i = 0; i < 3; ++i) {
+      tasks.push_back(std::make_shared<Task<void>>(count_down(done, ran)));
+    }
+  }
+  {
+    test::ThreadDefault scope(second);
+    for (int i = 0; i < 3; ++i) {
+      tasks.push_back(std::make_shared<Task<void>>(count_down(done, ran)));
+    }
+  }
+  tasks[0]->start();
+
+  Task<void>::start_all(tasks);
+  done.wait();
+  EXPECT_EQ(ran.load(), 6);
+  EXPECT_EQ(first->bulk_calls.load(), 1u);
+  EXPECT_EQ(first->bulk_size.load(), 2u);
+  EXPECT_EQ(second->bulk_calls.load(), 1u);
+  EXPECT_EQ(second->bulk_size.load(), 3u);
+  for (auto& task : tasks) {
+    while (!task->is_done()) std::this_thread::yield();
+  }
+}
+
+TEST(ScheduleBulkTest, WhenAllStartsChildrenInOneBatch) {
+  // when_all 在工作线程上创建包装协程，因此替换全局默认调度器
+  auto previous = SchedulerManager::get_default_scheduler();
+  auto scheduler = std::make_shared<CountingScheduler>(
+      std::make_shared<ThreadPoolExecutor>(4));
+  SchedulerManager::set_default_scheduler(scheduler);
+  auto results = Runtime::block_on(fan_out(500));
+  SchedulerManager::set_default_scheduler(previous);
+  ASSERT_EQ(results.size(), 500u);
+  for (int i = 0; i < 500; ++i) EXPECT_EQ(results[i], i * i);
+  EXPECT_EQ(scheduler->bulk_calls.load(), 1u);
+  EXPECT_EQ(scheduler->bulk_size.load(), 500u);
+}
+
+TEST(ScheduleBulkTest, JoinAllVectorRunsEveryTask) {
+  std::atomic<int> ran{0};
+  std::latch done(200);
+  std::vector<Task<void>> tasks;
+  for (int i = 0; i < 200; ++i) tasks.push_back(count_down(done, ran));
+  Runtime::join_all(std::move(tasks));
+  EXPECT_EQ(ran.load(), 200);
+}
+
+TEST(ScheduleBulkTest, PrioritySchedulerAcceptsBatch) {
+  auto scheduler = std::make_shared<PriorityScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  std::latch done(100);
+  std::atomic<int> ran{0};
+  std::vector<Task<void>> tasks;
+  {
+    test::ThreadDefault scope(scheduler);
+    for (int i = 0; i < 100; ++i) tasks.push_back(count_down(done, ran));
+  }
+  Task<void>::start_all(tasks);
+  done.wait();
+  EXPECT_EQ(ran.load(), 100);
+  for (auto& task : tasks) {
+    while (!task.is_done()) std::this_thread::yield();
+  }
+}
+
+TEST(ScheduleBulkTest, PrioritySchedulerPostsPumpsInOneBatch) {
+  pumps_in_one_batch<PriorityScheduler>(100);
+}
+
+TEST(ScheduleBulkTest, DeadlineSchedulerPostsPumpsInOneBatch) {
+  pumps_in_one_batch<DeadlineScheduler>(100);
+}
+
+TEST(ScheduleBulkTest, TaskManagerSubmitsBatchToGroup) {
+  TaskManager manager;
+  std::latch done(50);
+  std::atomic<int> ran{0};
+  std::vector<std::shared_ptr<Task<void>>> tasks;
+  for (int i = 0; i < 50; ++i) {
+    tasks.push_back(std::make_shared<Task<void>>(count_down(done, ran)));
+  }
+  manager.submit_all_to_group("batch", tasks);
+  manager.sync_wait_group("batch");
+  EXPECT_EQ(ran.load(), 50);
+  for (auto& task : tasks) EXPECT_TRUE(task->is_done());
+}
+
+TEST(ScheduleBulkTest, CurrentThreadExecutorRunsBatchOnDriver) {
+  auto executor = std::make_shared<CurrentThreadExecutor>();
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+  std::latch done(10);
+  std::atomic<int> ran{0};
+  std::vector<Task<void>> tasks;
+  {
+    test::ThreadDefault scope(scheduler);
+    for (int i = 0; i < 10; ++i) tasks.push_back(count_down(done, ran));
+  }
+  Task<void>::start_all(tasks);
+  executor->execute([&executor] { executor->stop(); });
+  executor->run();
+  EXPECT_EQ(ran.load(), 10);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> child(int x) { co_return x + 1; }
+
+// 反复经过子任务、调度器切换和睡眠，覆盖各条恢复路径
+Task<long> hop(std::shared_ptr<AbstractScheduler> scheduler, int rounds,
+               std::atomic<long>& during_sleep) {
+  long sum = 0;
+  for (int i = 0; i < rounds; ++i) {
+    sum += co_await child(i);
+    co_await scheduler->dispatch_to();
+  }
+  during_sleep = -1;
+  auto sleeper = [](std::atomic<long>& observed) -> Task<void> {
+    co_await 20ms;
+    observed.fetch_add(1);
+  };
+  co_await sleeper(during_sleep);
+  co_return sum;
+}
+
+// 绑定只接受裸指针：shared_ptr（尤其是临时对象）不能直接传入
+template <typename Target>
+concept AcceptsSharedScheduler =
+    requires(Target& target, std::shared_ptr<AbstractScheduler> scheduler) {
+      target.set_scheduler(scheduler);
+    };
+static_assert(!AcceptsSharedScheduler<TaskPromise<int>>);
+static_assert(!AcceptsSharedScheduler<TaskPromise<void>>);
+
+}  // namespace
+
+TEST(SchedulerBindingTest, NewTasksBindCurrentSchedulerWithoutOwningIt) {
+  auto scheduler =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  auto baseline = scheduler.use_count();
+  std::vector<Task<int>> tasks;
+  {
+    test::ThreadDefault scope(scheduler);
+    EXPECT_EQ(SchedulerManager::current_scheduler(), scheduler.get());
+    for (int i = 0; i < 100; ++i) tasks.push_back(child(i));
+  }
+  EXPECT_NE(SchedulerManager::current_scheduler(), scheduler.get());
+  // 绑定只记录裸指针，不增加引用计数
+  EXPECT_EQ(scheduler.use_count(), baseline);
+  for (auto& task : tasks) {
+    EXPECT_EQ(task.handle_.promise().get_scheduler(), scheduler.get());
+  }
+  Task<int>::start_all(tasks);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(tasks[i].handle_.promise().get_result(), i + 1);
+  }
+}
+
+TEST(SchedulerBindingTest, ResumePathDoesNotCopySchedulerOwnership) {
+  auto scheduler = std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  std::atomic<long> during_sleep{0};
+  auto task = hop(scheduler, 200, during_sleep);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  // hop 的参数持有一份
+  auto baseline = scheduler.use_count();
+
+  task.start();
+  // 挂起在睡眠上时，awaiter 与 promise 都不持有调度器
+  while (during_sleep.load() != -1) std::this_thread::yield();
+  std::this_thread::sleep_for(5ms);
+  EXPECT_EQ(scheduler.use_count(), baseline);
+
+  long expected = 0;
+  for (int i = 0; i < 200; ++i) expected += i + 1;
+  EXPECT_EQ(task.handle_.promise().get_result(), expected);
+  EXPECT_EQ(during_sleep.load(), 0);
+}
+
+TEST(SchedulerBindingTest, ReplacedDefaultSchedulerOutlivesBoundTasks) {
+  auto previous = SchedulerManager::get_default_scheduler();
+  auto replaced =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  std::weak_ptr<AbstractScheduler> observer = replaced;
+  SchedulerManager::set_default_scheduler(std::move(replaced));
+  auto task = child(41);
+  EXPECT_EQ(task.handle_.promise().get_scheduler(), observer.lock().get());
+
+  // 被替换下来的默认调度器由 SchedulerManager 保留，已绑定的任务仍可运行
+  SchedulerManager::set_default_scheduler(previous);
+  EXPECT_FALSE(observer.expired());
+  EXPECT_EQ(Runtime::block_on(std::move(task)), 42);
+}
+
+TEST(SchedulerBindingTest, RetiredDefaultSchedulerIsReleasedAfterLastTask) {
+  auto previous = SchedulerManager::get_default_scheduler();
+  std::weak_ptr<AbstractScheduler> observer;
+  {
+    auto replaced = std::make_shared<SimpleScheduler>(
+        std::make_shared<ThreadPoolExecutor>(1));
+    observer = replaced;
+    SchedulerManager::set_default_scheduler(std::move(replaced));
+  }
+  {
+    auto task = child(1);
+    SchedulerManager::set_default_scheduler(previous);
+    // 仍有协程绑定：之后的替换不会回收它
+    SchedulerManager::set_default_scheduler(previous);
+    EXPECT_FALSE(observer.expired());
+    EXPECT_EQ(Runtime::block_on(std::move(task)), 2);
+  }
+  // 最后一个绑定随协程帧注销，下一次替换时回收
+  SchedulerManager::set_default_scheduler(previous);
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(SchedulerBindingTest, RestoringDefaultDoesNotAccumulateRetired) {
+  auto previous = SchedulerManager::get_default_scheduler();
+  auto other =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  for (int i = 0; i < 10; ++i) {
+    SchedulerManager::set_default_scheduler(other);
+    SchedulerManager::set_default_scheduler(previous);
+  }
+  // 没有协程绑定过 other，SchedulerManager 不再持有它
+  EXPECT_EQ(other.use_count(), 1);
+}
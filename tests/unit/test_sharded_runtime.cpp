@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "koroutine/async_io/async_io.hpp"
+#include "koroutine/async_io/sharded_runtime.h"
+#include "koroutine/koroutine.h"
+
+using namespace koroutine;
+using namespace koroutine::async_io;
+
+namespace {
+
+Task<std::thread::id> current_thread() {
+  co_return std::this_thread::get_id();
+}
+
+// 只实现了 run() 的引擎
+class RunOnlyEngine : public IOEngine {
+ public:
+  void submit(std::shared_ptr<AsyncIOOp>) override {}
+  void run() override {}
+  void stop() override {}
+  bool is_running() override { return false; }
+};
+
+}  // namespace
+
+// 不支持 poll() 的引擎在构造时就被拒绝，而不是让分片线程抛异常终止进程
+TEST(ShardedRuntimeTest, RejectsEngineWithoutPoll) {
+  EXPECT_THROW(IoShardExecutor(std::make_shared<RunOnlyEngine>()),
+               std::invalid_argument);
+}
+
+// 分片上的任务及其子任务都在分片线程上运行
+TEST(ShardedRuntimeTest, TasksStayOnShard) {
+  ShardedRuntime runtime(2);
+  for (size_t shard = 0; shard < runtime.size(); ++shard) {
+    auto expected = runtime.executor(shard)->thread_id();
+    auto task = [](std::thread::id expected) -> Task<bool> {
+      bool same = std::this_thread::get_id() == expected;
+      for (int i = 0; i < 10; ++i) {
+        same &= co_await current_thread() == expected;
+      }
+      co_await sleep_for(1);
+      same &= std::this_thread::get_id() == expected;
+      co_return same;
+    };
+    EXPECT_TRUE(runtime.block_on(shard, task(expected)));
+  }
+}
+
+// 回环回显：accept/connect/read/write 都在同一个分片线程上提交并恢复
+TEST(ShardedRuntimeTest, EchoStaysOnShard) {
+  ShardedRuntime runtime(1);
+  auto shard_thread = runtime.executor(0)->thread_id();
+
+  auto echo = [](std::thread::id shard_thread) -> Task<int> {
+    std::atomic<int> off_shard{0};
+    auto check = [&] {
+      if (std::this_thread::get_id() != shard_thread) ++off_shard;
+    };
+
+    auto server = co_await AsyncServerSocket::bind(0);
+    check();
+    uint16_t port = server->local_endpoint().port();
+
+    auto serve = [&](std::shared_ptr<AsyncServerSocket> server) -> Task<int> {
+      auto conn = co_await server->accept();
+      check();
+      char buf[64];
+      for (int i = 0; i < 100; ++i) {
+        size_t n = co_await conn->read(buf, sizeof(buf));
+        check();
+        co_await conn->write(buf, n);
+        check();
+      }
+      co_return 0;
+    };
+    auto client = [&]() -> Task<int> {
+      auto socket = co_await AsyncSocket::connect("127.0.0.1", port);
+      check();
+      int echoed = 0;
+      char buf[64];
+      for (int i = 0; i < 100; ++i) {
+        auto msg = std::to_string(i);
+        co_await socket->write(msg.data(), msg.size());
+        check();
+        size_t n = co_await socket->read(buf, sizeof(buf));
+        check();
+        if (std::string(buf, n) == msg) ++echoed;
+      }
+      co_return echoed;
+    };
+
+    auto [served, echoed] = co_await when_all(serve(server), client());
+    (void)served;
+    co_return off_shard.load() == 0 ? echoed : -1;
+  };
+
+  EXPECT_EQ(runtime.block_on(0, echo(shard_thread)), 100);
+}
+
+// 外部线程提交的工作能唤醒阻塞在 poll 中的分片
+TEST(ShardedRuntimeTest, ExternalSubmitWakesParkedShard) {
+  ShardedRuntime runtime(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));  // 让分片进入 poll
+
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 100; ++i) {
+    runtime.executor(0)->execute([&ran] { ++ran; });
+  }
+  auto count = [](std::atomic<int>& ran) -> Task<int> { co_return ran.load(); };
+  EXPECT_EQ(runtime.block_on(0, count(ran)), 100);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "koroutine/koroutine.h"
+#include "test_support.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> delayed_value(int v) {
+  co_await sleep_for(20ms);
+  co_return v;
+}
+
+Task<int> immediate_value(int v) { co_return v; }
+
+Task<int> failing() {
+  co_await sleep_for(5ms);
+  throw std::runtime_error("boom");
+}
+
+}  // namespace
+
+// promise 不再内嵌 mutex 与 condition_variable
+TEST(SlimPromiseTest, PromiseHasNoBlockingPrimitives) {
+  EXPECT_LT(sizeof(TaskPromise<void>),
+            sizeof(std::mutex) + sizeof(std::condition_variable));
+}
+
+// 从普通线程阻塞等待一个尚未完成的任务
+TEST(SlimPromiseTest, GetResultBlocksUntilCompletion) {
+  auto task = delayed_value(42);
+  task.start();
+  EXPECT_EQ(task.handle_.promise().get_result(), 42);
+  test::wait_finished(task);
+}
+
+TEST(SlimPromiseTest, ExceptionReachesBlockedWaiter) {
+  auto task = failing();
+  task.start();
+  EXPECT_THROW(task.handle_.promise().get_result(), std::runtime_error);
+  test::wait_finished(task);
+}
+
+// 任务先完成时，之后的取消不会覆盖已有结果
+TEST(SlimPromiseTest, CancelAfterCompletionKeepsResult) {
+  CancellationToken token;
+  auto task = immediate_value(8);
+  task.with_cancellation(token);
+  task.start();
+  test::wait_finished(task);
+  token.cancel();
+  EXPECT_EQ(task.handle_.promise().get_result(), 8);
+}
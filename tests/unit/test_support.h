@@ -0,0 +1,85 @@
+#pragma once
+
+// 多个单元测试共用的夹具
+
+#include <atomic>
+#include <coroutine>
+#include <latch>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+
+namespace koroutine::test {
+
+// 统计被提交到执行器的协程句柄数量
+class CountingLooper : public LooperExecutor {
+ public:
+  using LooperExecutor::execute;
+
+  void execute(std::coroutine_handle<> handle) override {
+    ++submitted;
+    LooperExecutor::execute(handle);
+  }
+
+  std::atomic<int> submitted{0};
+};
+
+// 在本作用域内新建的协程默认属于 scheduler
+class ThreadDefault {
+ public:
+  explicit ThreadDefault(std::shared_ptr<AbstractScheduler> scheduler) {
+    SchedulerManager::set_thread_default_scheduler(std::move(scheduler));
+  }
+  ~ThreadDefault() { SchedulerManager::set_thread_default_scheduler(nullptr); }
+};
+
+// 等已经启动的任务真正结束后再销毁它。结果在 final_suspend 之前写入，
+// get_result() 或 latch 返回时协程可能还在执行器线程上收尾
+template <typename R>
+void wait_finished(const Task<R>& task) {
+  while (!task.is_done()) std::this_thread::yield();
+}
+
+// 单线程执行器被 gate 阻塞期间交给调度器的任务，放开后记录实际执行顺序。
+// 如何把 add() 返回的任务交给调度器由各测试决定
+template <typename Scheduler>
+class GatedLooper {
+ public:
+  GatedLooper()
+      : executor_(std::make_shared<LooperExecutor>()),
+        scheduler_(std::make_shared<Scheduler>(executor_)) {
+    executor_->execute([this] { gate_.wait(); });
+  }
+
+  // 新建一个运行时记下 id 的任务，尚未启动
+  Task<void>& add(int id) {
+    tasks_.push_back([](std::vector<int>& order, int id) -> Task<void> {
+      order.push_back(id);
+      co_return;
+    }(order_, id));
+    return tasks_.back();
+  }
+
+  std::vector<int> release() {
+    std::latch done(1);
+    executor_->execute([&] { done.count_down(); });
+    gate_.count_down();
+    done.wait();
+    return order_;
+  }
+
+  Scheduler& scheduler() { return *scheduler_; }
+  Task<void>& task(size_t i) { return tasks_[i]; }
+
+ private:
+  std::shared_ptr<LooperExecutor> executor_;
+  std::shared_ptr<Scheduler> scheduler_;
+  std::latch gate_{1};
+  std::vector<Task<void>> tasks_;
+  std::vector<int> order_;
+};
+
+}  // namespace koroutine::test
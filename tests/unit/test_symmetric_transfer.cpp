@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "test_support.h"
+
+using namespace koroutine;
+
+namespace {
+
+// 测试期间替换默认调度器，子任务默认使用它
+class DefaultSchedulerGuard {
+ public:
+  explicit DefaultSchedulerGuard(std::shared_ptr<AbstractScheduler> scheduler)
+      : previous_(SchedulerManager::get_default_scheduler()) {
+    SchedulerManager::set_default_scheduler(std::move(scheduler));
+  }
+  ~DefaultSchedulerGuard() {
+    SchedulerManager::set_default_scheduler(previous_);
+  }
+
+ private:
+  std::shared_ptr<AbstractScheduler> previous_;
+};
+
+Task<int> depth(int n) {
+  if (n == 0) co_return 0;
+  co_return 1 + co_await depth(n - 1);
+}
+
+}  // namespace
+
+TEST(SymmetricTransferTest, NestedChainDoesNotQueue) {
+  auto executor = std::make_shared<test::CountingLooper>();
+  DefaultSchedulerGuard guard(std::make_shared<SimpleScheduler>(executor));
+
+  EXPECT_EQ(Runtime::block_on(depth(1000)), 1000);
+  // 只有 block_on 包装协程和根任务各入队一次，中间 1000 层逐层进入和
+  // 逐层返回时仅在协作预算用完时排队
+  EXPECT_LE(
+      executor->submitted.load(),
+      4 + 2 * 1000 / static_cast<int>(details::CoopBudget::kDefaultBudget));
+}
+
+TEST(SymmetricTransferTest, DeepChainDoesNotGrowStack) {
+  auto executor = std::make_shared<LooperExecutor>();
+  DefaultSchedulerGuard guard(std::make_shared<SimpleScheduler>(executor));
+
+  // 不依赖编译器生成尾调用：对称转移受协作预算限制，预算每用完一次就
+  // 入队并回到执行器，十万层嵌套不会耗尽线程栈
+  EXPECT_EQ(Runtime::block_on(depth(100000)), 100000);
+}
+
+TEST(SymmetricTransferTest, ForeignSchedulerStillQueues) {
+  auto executor = std::make_shared<test::CountingLooper>();
+  auto other =
+      std::make_shared<SimpleScheduler>(std::make_shared<LooperExecutor>());
+  DefaultSchedulerGuard guard(std::make_shared<SimpleScheduler>(executor));
+
+  auto child = []() -> Task<std::thread::id> {
+    co_return std::this_thread::get_id();
+  };
+  auto parent = [&]() -> Task<bool> {
+    auto caller_thread = std::this_thread::get_id();
+    auto task = child();
+    task.handle_.promise().set_scheduler(other.get());
+    auto child_thread = co_await std::move(task);
+    co_return child_thread != caller_thread;
+  };
+  // 子任务属于另一个调度器，必须经由它的执行器启动，不能在当前线程上直接转移
+  EXPECT_TRUE(Runtime::block_on(parent()));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "koroutine/channel.hpp"
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/sync/async_mutex.h"
+#include "koroutine/when_all.hpp"
+#include "test_support.h"
+
+using namespace koroutine;
+
+namespace {
+
+template <typename R>
+R run_counted(Task<R> task, int& submitted) {
+  auto executor = std::make_shared<test::CountingLooper>();
+  // 协程只以裸指针绑定调度器，调度器必须活到任务结束
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  R result = Runtime::block_on(std::move(task));
+  submitted = executor->submitted.load();
+  return result;
+}
+
+}  // namespace
+
+TEST(SyncFastPathTest, UncontendedLockDoesNotSuspend) {
+  AsyncMutex mutex;
+  int submitted = 0;
+  int locked = run_counted(
+      [](AsyncMutex& mutex) -> Task<int> {
+        int count = 0;
+        for (int i = 0; i < 1000; ++i) {
+          co_await mutex.lock();
+          ++count;
+          mutex.unlock();
+        }
+        co_return count;
+      }(mutex),
+      submitted);
+  EXPECT_EQ(locked, 1000);
+  // 只有任务启动时入队一次，每次加锁都在原地完成；
+  // 协作预算每用完一次才额外入队一次
+  EXPECT_LE(submitted,
+            1 + 1000 / static_cast<int>(details::CoopBudget::kDefaultBudget));
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SyncFastPathTest, BufferedChannelDoesNotSuspend) {
+  Channel<int> channel(4);
+  int submitted = 0;
+  auto values = run_counted(
+      [](Channel<int>& channel) -> Task<std::vector<int>> {
+        std::vector<int> values;
+        for (int i = 0; i < 1000; ++i) {
+          co_await channel.write(i);
+          co_await channel.write(i + 1);
+          values.push_back(co_await channel.read());
+          values.push_back(co_await channel.read());
+        }
+        co_return values;
+      }(channel),
+      submitted);
+  ASSERT_EQ(values.size(), 2000u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(values[2 * i], i);
+    EXPECT_EQ(values[2 * i + 1], i + 1);
+  }
+  EXPECT_LE(submitted,
+            1 + 4000 / static_cast<int>(details::CoopBudget::kDefaultBudget));
+}
+
+// 无缓冲通道：读者在原地拿走挂起写者的值，写者照常被唤醒
+TEST(SyncFastPathTest, ReaderTakesValueFromWaitingWriter) {
+  Channel<int> channel;
+  auto writer = [](Channel<int>& channel) -> Task<int> {
+    for (int i = 0; i < 100; ++i) co_await channel.write(i);
+    co_return 100;
+  };
+  auto reader = [](Channel<int>& channel) -> Task<int> {
+    int sum = 0;
+    for (int i = 0; i < 100; ++i) {
+      co_await sleep_for(1);  // 让写者先挂起
+      sum += co_await channel.read();
+    }
+    co_return sum;
+  };
+
+  auto [written, sum] =
+      Runtime::block_on(when_all(writer(channel), reader(channel)));
+  EXPECT_EQ(written, 100);
+  EXPECT_EQ(sum, 4950);
+}
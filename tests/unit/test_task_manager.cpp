@@ -1,5 +1,10 @@
+#include <atomic>
+#include <thread>
+
 #include "gtest/gtest.h"
+#include "koroutine/executors/thread_pool_executor.h"
 #include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
 #include "koroutine/task_manager.h"
 
 using namespace koroutine;
@@ -136,3 +141,100 @@ TEST(TaskManagerTest, CancelEmptyGroupCancelsAll) {
   EXPECT_TRUE(t1->is_done());
   EXPECT_TRUE(t2->is_done());
 }
+
+// 最后一个任务结束时 join 立即被唤醒，不再有 20ms 的轮询间隔
+TEST(TaskManagerTest, JoinWakesWhenLastTaskFinishes) {
+  TaskManager manager;
+  constexpr int kRounds = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    manager.submit_to_group("quick",
+                            std::make_shared<Task<void>>(short_sleep(1)));
+    manager.sync_wait_group("quick");
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // 轮询实现至少需要 kRounds * 20ms
+  EXPECT_LT(elapsed, std::chrono::milliseconds(kRounds * 10));
+}
+
+// 任务结束后管理器立即释放引用，分组随之消失
+TEST(TaskManagerTest, FinishedTasksAreReleased) {
+  TaskManager manager;
+  auto t1 = std::make_shared<Task<void>>(short_sleep(10));
+  std::weak_ptr<Task<void>> weak = t1;
+  manager.submit_to_group("g", std::move(t1));
+  manager.sync_wait_group("g");
+
+  EXPECT_TRUE(weak.expired());
+  EXPECT_TRUE(manager.list_groups().empty());
+}
+
+TEST(TaskManagerTest, JoinUnknownGroupReturnsImmediately) {
+  TaskManager manager;
+  auto t1 = std::make_shared<Task<void>>(long_running_forever());
+  manager.submit_to_group("busy", t1);
+
+  manager.sync_wait_group("missing");
+  EXPECT_FALSE(t1->is_done());
+  manager.sync_cancel_group("busy");
+}
+
+// 多个 join 同时等待同一分组，全部在最后一个任务结束时被唤醒
+TEST(TaskManagerTest, ConcurrentJoinsAllWake) {
+  TaskManager manager;
+  auto t1 = std::make_shared<Task<void>>(short_sleep(30));
+  auto t2 = std::make_shared<Task<void>>(short_sleep(60));
+  manager.submit_to_group("g", t1);
+  manager.submit_to_group("g", t2);
+
+  auto j1 = manager.join_group("g");
+  auto j2 = manager.join_group("g");
+  auto j3 = manager.join_group("");
+  j1.start();
+  j2.start();
+  j3.start();
+  while (!j1.is_done() || !j2.is_done() || !j3.is_done()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(t1->is_done());
+  EXPECT_TRUE(t2->is_done());
+}
+
+namespace {
+
+struct CountingHook : FinishHook {
+  std::atomic<int> calls{0};
+
+  CountingHook() {
+    on_finished = [](FinishHook* self) {
+      static_cast<CountingHook*>(self)->calls.fetch_add(1);
+    };
+  }
+};
+
+}  // namespace
+
+// 子任务在另一个调度器的线程上结束并对称转移回父任务，父任务结束时把
+// continuation 交给自己的调度器：continuation 可能抢先结束并销毁父任务的
+// 协程帧，结束钩子不能再从帧里读取
+TEST(TaskManagerTest, FinishHookSurvivesContinuationOnOtherScheduler) {
+  auto parent_scheduler = std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  auto child_scheduler = std::make_shared<SimpleScheduler>(
+      std::make_shared<ThreadPoolExecutor>(2));
+  CountingHook hook;
+  constexpr int kRounds = 500;
+  for (int i = 0; i < kRounds; ++i) {
+    auto parent =
+        [](std::shared_ptr<AbstractScheduler> child_scheduler) -> Task<int> {
+      auto child = []() -> Task<int> { co_return 1; }();
+      child.handle_.promise().set_scheduler(child_scheduler.get());
+      co_return co_await std::move(child);
+    }(child_scheduler);
+    parent.handle_.promise().set_scheduler(parent_scheduler.get());
+    parent.on_finished(&hook);
+    EXPECT_EQ(Runtime::block_on(std::move(parent)), 1);
+  }
+  while (hook.calls.load() < kRounds) std::this_thread::yield();
+  EXPECT_EQ(hook.calls.load(), kRounds);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include "koroutine/executors/thread_pool_executor.h"
+
+using namespace koroutine;
+
+namespace {
+
+// 逐个提交任务并等待其完成，模拟请求/响应式的突发流量
+void hand_off(ThreadPoolExecutor& pool, int count) {
+  for (int i = 0; i < count; ++i) {
+    std::latch done(1);
+    pool.execute([&done] { done.count_down(); });
+    done.wait();
+  }
+}
+
+}  // namespace
+
+TEST(ThreadPoolSpinTest, ZeroBudgetAlwaysParks) {
+  ThreadPoolExecutor pool(2, 0);
+  hand_off(pool, 200);
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.spin_hits, 0u);
+  EXPECT_GT(stats.parks, 0u);
+}
+
+TEST(ThreadPoolSpinTest, SpinningWorkersRunEveryHandOff) {
+  ThreadPoolExecutor pool(2, 1u << 16);
+  hand_off(pool, 2000);
+  auto stats = pool.stats();
+  // 每个空闲阶段要么在自旋中拿到任务，要么挂起
+  EXPECT_GT(stats.spin_hits + stats.parks, 0u);
+}
+
+// 多个生产者在工作线程自旋/挂起切换期间提交，任务不丢失
+TEST(ThreadPoolSpinTest, NoLostWakeupsUnderBursts) {
+  ThreadPoolExecutor pool(4, 256);
+  constexpr int kProducers = 4;
+  constexpr int kBursts = 200;
+  constexpr int kPerBurst = 25;
+  std::atomic<int> ran{0};
+  std::latch done(kProducers * kBursts * kPerBurst);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&] {
+      for (int b = 0; b < kBursts; ++b) {
+        for (int i = 0; i < kPerBurst; ++i) {
+          pool.execute([&] {
+            ++ran;
+            done.count_down();
+          });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    });
+  }
+  for (auto& t : producers) t.join();
+  done.wait();
+  EXPECT_EQ(ran.load(), kProducers * kBursts * kPerBurst);
+}
+
+// 自旋中的工作线程取走长任务后不再算作自旋者：紧随其后提交的任务唤醒
+// 挂起的另一个工作线程，而不是排在长任务后面
+TEST(ThreadPoolSpinTest, BurstIsNotSerialisedBehindSpinner) {
+  using Clock = std::chrono::steady_clock;
+  ThreadPoolExecutor pool(2, 1u << 30);
+  // 等两个工作线程进入空闲：一个自旋，另一个挂起
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::latch done(2);
+  auto posted = Clock::now();
+  std::atomic<int64_t> delay_ms{-1};
+  pool.execute([&done] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    done.count_down();
+  });
+  pool.execute([&] {
+    delay_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   Clock::now() - posted)
+                   .count();
+    done.count_down();
+  });
+  done.wait();
+  EXPECT_LT(delay_ms.load(), 150);
+}
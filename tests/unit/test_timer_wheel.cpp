@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <random>
+#include <vector>
+
+#include "koroutine/details/timer_wheel.hpp"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/executors/timer_service.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+#include "koroutine/schedulers/timer_scheduler.hpp"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+namespace {
+
+int g_fired_id = -1;
+
+Runnable record(int id) {
+  return [id] { g_fired_id = id; };
+}
+
+// 推进时间轮并按触发顺序返回到期回调的编号
+std::vector<int> run(details::TimerWheel& wheel, uint64_t tick) {
+  std::vector<Runnable> expired;
+  wheel.advance(tick, expired);
+  std::vector<int> ids;
+  for (auto& callback : expired) {
+    callback();
+    ids.push_back(g_fired_id);
+  }
+  return ids;
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, FiresInExpiryOrderAcrossLevels) {
+  details::TimerWheel wheel;
+  // 覆盖第 0 层到第 3 层
+  wheel.add(300000, record(4));
+  wheel.add(5, record(1));
+  wheel.add(4100, record(3));
+  wheel.add(70, record(2));
+  EXPECT_EQ(wheel.size(), 4u);
+
+  EXPECT_TRUE(run(wheel, 4).empty());
+  EXPECT_EQ(run(wheel, 5), std::vector<int>{1});
+  EXPECT_EQ(run(wheel, 69), std::vector<int>{});
+  EXPECT_EQ(run(wheel, 4099), std::vector<int>{2});
+  EXPECT_EQ(run(wheel, 1'000'000), (std::vector<int>{3, 4}));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.next_expiry().has_value());
+}
+
+TEST(TimerWheelTest, NextExpiryNeverLate) {
+  details::TimerWheel wheel(12345);
+  wheel.add(12345 + 200000, record(1));
+  // 反复跳到 next_expiry，直到触发；每一步都不能越过真正的到期时间
+  uint64_t steps = 0;
+  std::vector<int> fired;
+  while (fired.empty()) {
+    auto next = wheel.next_expiry();
+    ASSERT_TRUE(next.has_value());
+    ASSERT_LE(*next, 12345u + 200000u);
+    fired = run(wheel, *next);
+    ASSERT_LT(++steps, 10u);
+  }
+  EXPECT_EQ(wheel.now(), 12345u + 200000u);
+}
+
+TEST(TimerWheelTest, CancelIsExactAndStaleIdsAreInert) {
+  details::TimerWheel wheel;
+  auto a = wheel.add(10, record(1));
+  auto b = wheel.add(10, record(2));
+  auto c = wheel.add(5000, record(3));
+
+  EXPECT_TRUE(wheel.cancel(a));
+  EXPECT_FALSE(wheel.cancel(a));
+  EXPECT_TRUE(wheel.cancel(c));
+  EXPECT_EQ(run(wheel, 10), std::vector<int>{2});
+  EXPECT_FALSE(wheel.cancel(b));  // already fired
+
+  // 复用节点后旧 id 不能取消新定时器
+  auto d = wheel.add(20, record(4));
+  EXPECT_EQ(d.index, b.index);
+  EXPECT_FALSE(wheel.cancel(b));
+  EXPECT_EQ(run(wheel, 20), std::vector<int>{4});
+}
+
+TEST(TimerWheelTest, RandomisedAgainstSortedReference) {
+  details::TimerWheel wheel;
+  std::mt19937_64 rng(42);
+  std::vector<std::pair<uint64_t, int>> reference;
+  std::vector<details::TimerWheel::TimerId> ids;
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t delay = 1 + rng() % (i % 3 == 0 ? 5'000'000 : 5000);
+    ids.push_back(wheel.add(delay, record(i)));
+    reference.emplace_back(delay, i);
+  }
+  // 取消三分之一
+  std::vector<bool> cancelled(ids.size());
+  for (size_t i = 0; i < ids.size(); i += 3) {
+    EXPECT_TRUE(wheel.cancel(ids[i]));
+    cancelled[i] = true;
+  }
+
+  // 每个定时器必须在第一次满足 now >= delay 的推进中触发
+  uint64_t now = 0;
+  std::vector<std::pair<uint64_t, uint64_t>> fired_in(ids.size(), {0, 0});
+  std::vector<bool> fired(ids.size());
+  while (!wheel.empty()) {
+    uint64_t prev = now;
+    now += 1 + rng() % 20000;
+    for (int id : run(wheel, now)) {
+      ASSERT_FALSE(fired[id]);
+      fired[id] = true;
+      fired_in[id] = {prev, now};
+    }
+  }
+  for (auto [delay, id] : reference) {
+    EXPECT_EQ(fired[id], !cancelled[id]);
+    if (fired[id]) {
+      EXPECT_LT(fired_in[id].first, delay);
+      EXPECT_GE(fired_in[id].second, delay);
+    }
+  }
+}
+
+TEST(TimerServiceTest, FiresAndCancels) {
+  TimerService service;
+  std::atomic<int> fired{0};
+  std::latch done(1);
+
+  auto cancelled = service.schedule_after(30, [&] { fired += 100; });
+  auto start = std::chrono::steady_clock::now();
+  service.schedule_after(20, [&] {
+    fired += 1;
+    done.count_down();
+  });
+  EXPECT_TRUE(service.cancel(cancelled));
+
+  done.wait();
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+  std::this_thread::sleep_for(30ms);
+  EXPECT_EQ(fired.load(), 1);
+  EXPECT_FALSE(service.cancel(cancelled));
+}
+
+TEST(TimerServiceTest, TimerSchedulerDrainsOnShutdown) {
+  std::atomic<int> fired{0};
+  {
+    TimerScheduler scheduler;
+    for (int i = 0; i < 100; ++i) {
+      scheduler.schedule([&] { fired++; }, i % 10);
+    }
+    scheduler.shutdown(true);
+    scheduler.join();
+  }
+  EXPECT_EQ(fired.load(), 100);
+}
+
+// 执行器销毁后仍在等待的延迟任务应被丢弃，而不是访问已销毁的执行器
+TEST(TimerServiceTest, DelayedTasksDroppedAfterExecutorDies) {
+  std::atomic<int> fired{0};
+  {
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    executor->execute_delayed([&] { fired++; }, 20);
+  }
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(TimerServiceTest, SleepResumesCoroutine) {
+  auto sleeper = []() -> Task<long long> {
+    auto start = std::chrono::steady_clock::now();
+    co_await sleep_for(15);
+    co_return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start)
+        .count();
+  };
+  EXPECT_GE(Runtime::block_on(sleeper()), 15);
+}
+
+// 不足 1 毫秒的睡眠不再被截断为 0
+TEST(TimerServiceTest, SubMillisecondSleep) {
+  auto sleeper = []() -> Task<std::vector<long long>> {
+    std::vector<long long> elapsed;
+    for (int i = 0; i < 21; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      co_await sleep_for(200us);
+      elapsed.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+    }
+    co_return elapsed;
+  };
+  auto elapsed = Runtime::block_on(sleeper());
+  for (auto us : elapsed) EXPECT_GE(us, 200);
+  std::sort(elapsed.begin(), elapsed.end());
+  // 中位数应远小于旧实现的 1 毫秒粒度
+  EXPECT_LT(elapsed[elapsed.size() / 2], 1000);
+}
+
+TEST(TimerServiceTest, SleepUntilDeadline) {
+  auto sleeper = []() -> Task<bool> {
+    auto deadline = std::chrono::steady_clock::now() + 1500us;
+    co_await sleep_until(deadline);
+    co_return std::chrono::steady_clock::now() >= deadline;
+  };
+  EXPECT_TRUE(Runtime::block_on(sleeper()));
+}
+
+TEST(TimerServiceTest, ChronoDelaysEndToEnd) {
+  auto executor = std::make_shared<ThreadPoolExecutor>(1);
+  auto scheduler = std::make_shared<SimpleScheduler>(executor);
+
+  std::latch fired(1);
+  auto start = std::chrono::steady_clock::now();
+  executor->execute_delayed([&] { fired.count_down(); }, 300us);
+  fired.wait();
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 300us);
+
+  auto task = [](std::shared_ptr<AbstractScheduler> scheduler) -> Task<bool> {
+    auto start = std::chrono::steady_clock::now();
+    co_await scheduler->schedule(400us);
+    co_return std::chrono::steady_clock::now() - start >= 400us;
+  };
+  EXPECT_TRUE(Runtime::block_on(task(scheduler)));
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+using namespace koroutine;
+using namespace std::chrono_literals;
+
+TEST(WorkStealingExecutorTest, ExecutesExternalSubmissions) {
+  WorkStealingExecutor executor(4);
+  const int count = 10000;
+  std::atomic<int> done{0};
+  std::latch finished(count);
+
+  for (int i = 0; i < count; ++i) {
+    executor.execute([&] {
+      done.fetch_add(1);
+      finished.count_down();
+    });
+  }
+
+  finished.wait();
+  EXPECT_EQ(done.load(), count);
+}
+
+// 从 worker 内部提交的任务进入本地队列，空闲 worker 应当能把它们偷走
+TEST(WorkStealingExecutorTest, NestedSubmissionsAreStolen) {
+  WorkStealingExecutor executor(4);
+  const int count = 2000;
+  std::latch finished(count);
+  std::mutex mtx;
+  std::set<std::thread::id> threads;
+
+  executor.execute([&] {
+    EXPECT_TRUE(executor.is_worker_thread());
+    for (int i = 0; i < count; ++i) {
+      executor.execute([&] {
+        std::this_thread::sleep_for(50us);
+        {
+          std::lock_guard lock(mtx);
+          threads.insert(std::this_thread::get_id());
+        }
+        finished.count_down();
+      });
+    }
+  });
+
+  finished.wait();
+  EXPECT_FALSE(executor.is_worker_thread());
+  if (std::thread::hardware_concurrency() > 1) {
+    EXPECT_GT(threads.size(), 1u);
+  }
+}
+
+TEST(WorkStealingExecutorTest, DelayedExecution) {
+  WorkStealingExecutor executor(2);
+  std::latch finished(1);
+  auto start = std::chrono::steady_clock::now();
+
+  executor.execute_delayed([&] { finished.count_down(); }, 50);
+  finished.wait();
+
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+}
+
+TEST(WorkStealingExecutorTest, BacksSimpleScheduler) {
+  auto scheduler = std::make_shared<SimpleScheduler>(
+      std::make_shared<WorkStealingExecutor>(2));
+
+  auto child = []() -> Task<int> { co_return 21; };
+  auto parent = [&]() -> Task<int> {
+    int a = co_await child();
+    co_await scheduler->dispatch_to();
+    int b = co_await child();
+    co_return a + b;
+  };
+
+  auto task = parent();
+  task.handle_.promise().set_scheduler(scheduler.get());
+  EXPECT_EQ(Runtime::block_on(std::move(task)), 42);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "koroutine/executors/looper_executor.h"
+#include "koroutine/executors/runnable.h"
+#include "koroutine/executors/thread_pool_executor.h"
+#include "koroutine/executors/work_stealing_executor.h"
+#include "koroutine/koroutine.h"
+#include "koroutine/schedulers/SimpleScheduler.h"
+
+// 统计全局 operator new 调用次数（本测试可执行文件独占）。替换整组普通
+// 与数组形式；noinline 让 GCC 看不到 malloc/free，否则内联后的 free 会被
+// -Wmismatched-new-delete 当成与 new 不配对
+static std::atomic<size_t> g_allocations{0};
+
+__attribute__((noinline)) void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+__attribute__((noinline)) void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+  std::free(p);
+}
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+__attribute__((noinline)) void operator delete[](void* p,
+                                                  std::size_t) noexcept {
+  std::free(p);
+}
+
+using namespace koroutine;
+
+namespace {
+
+Task<size_t> count_resume_allocations(
+    std::shared_ptr<AbstractScheduler> scheduler, int warmup, int hops) {
+  for (int i = 0; i < warmup; ++i) co_await scheduler->dispatch_to();
+  size_t before = g_allocations.load();
+  for (int i = 0; i < hops; ++i) co_await scheduler->dispatch_to();
+  co_return g_allocations.load() - before;
+}
+
+size_t resume_allocations(std::shared_ptr<AbstractExecutor> executor) {
+  auto scheduler = std::make_shared<SimpleScheduler>(std::move(executor));
+  auto task = count_resume_allocations(scheduler, 100, 1000);
+  task.handle_.promise().set_scheduler(scheduler.get());
+  return Runtime::block_on(std::move(task));
+}
+
+}  // namespace
+
+TEST(ZeroAllocResumeTest, ThreadPoolExecutor) {
+  EXPECT_EQ(resume_allocations(std::make_shared<ThreadPoolExecutor>(2)), 0u);
+}
+
+TEST(ZeroAllocResumeTest, LooperExecutor) {
+  EXPECT_EQ(resume_allocations(std::make_shared<LooperExecutor>()), 0u);
+}
+
+TEST(ZeroAllocResumeTest, WorkStealingExecutor) {
+  EXPECT_EQ(resume_allocations(std::make_shared<WorkStealingExecutor>(2)), 0u);
+}
+
+TEST(RunnableTest, SmallCallablesStayInline) {
+  int calls = 0;
+  std::function<void()> func = [&calls] { ++calls; };
+
+  size_t before = g_allocations.load();
+  Runnable from_lambda([&calls] { ++calls; });
+  Runnable from_function(std::move(func));
+  Runnable moved(std::move(from_lambda));
+  moved();
+  from_function();
+  EXPECT_EQ(g_allocations.load() - before, 0u);
+  EXPECT_EQ(calls, 2);
+  EXPECT_FALSE(from_lambda);
+}
+
+TEST(RunnableTest, LargeCallablesFallBackToHeap) {
+  std::array<char, Runnable::kInlineSize * 2> payload{};
+  payload[0] = 7;
+  int seen = 0;
+
+  size_t before = g_allocations.load();
+  Runnable large([payload, &seen] { seen = payload[0]; });
+  EXPECT_EQ(g_allocations.load() - before, 1u);
+
+  Runnable moved(std::move(large));
+  moved();
+  EXPECT_EQ(seen, 7);
+}